@@ -33,7 +33,11 @@ static sprite_t *arrow_sprites[4];
 
 track myTrack;
 
-int currentTargetArrow;
+// Monotonic cursors into myTrack.arrows, so each pass only touches
+// arrows around the current song time instead of the whole chart.
+int hitCursor[MAXPLAYERS];
+int aiCursor;
+int drawCursor;
 
 
 /*********************************
@@ -93,7 +97,7 @@ void minigame_init()
     arrow_sprites[3] = arrow_right_sprite;
     ui.scale_factor_x = UI_SCALE;
     ui.scale_factor_y = UI_SCALE;
-    loadSong();
+    loadSong("rom:/64beats/defloration.chart");
 
     xm64player_open(&music, myTrack.songPath);
     xm64player_set_loop(&music, false);
@@ -255,17 +259,17 @@ void checkInputs()
                 continue;
             }
             bool directionsPressed[4] = {btn.c_left, btn.c_up, btn.c_down, btn.c_right};
-            if (currentTargetArrow > myTrack.arrowNum) {
-                continue;
-            }
-            for (int currentArrow = currentTargetArrow; currentArrow < currentTargetArrow + 16; currentArrow++)
+
+            // skip arrows that already left the hit window, then only look at the ones inside it
+            advanceCursor(&hitCursor[i], songTime - ACCURACY);
+            for (int currentArrow = hitCursor[i]; currentArrow < myTrack.arrowNum; currentArrow++)
             {
-                if (!directionsPressed[myTrack.arrows[currentArrow].direction])
-                {
-                    continue;
-                }
                 int deltaTime = calculateDeltaTime(currentArrow);
-                if (deltaTime > ACCURACY || deltaTime < 0-ACCURACY ) {
+                if (deltaTime < 0-ACCURACY) {
+                    break;
+                }
+                if (myTrack.arrows[currentArrow].hit[i] || !directionsPressed[myTrack.arrows[currentArrow].direction])
+                {
                     continue;
                 }
                 const int addScore = ACCURACY - abs(deltaTime);
@@ -321,68 +325,54 @@ void AIButtons(int songTime, float deltatime) {
     }
 
 }
-int findNextTimestamp(int songTime) {
-	int32_t nextTime = INT32_MAX;
-
-	for (int i = 0; i < myTrack.arrowNum; i++) {
-		int arrowTime = myTrack.arrows[i].time;
-		if (arrowTime > songTime && arrowTime < nextTime) {
-			nextTime = arrowTime;
-		}
-	}
-
-	return (nextTime == INT32_MAX) ? -1 : nextTime; // return -1 if no valid time is found
-}
-int countValidEntries()
+void advanceCursor(int *cursor, int time)
 {
-    int count = 0;
-    for (int i = 0; i < MAX_ARROWS; i++)
-    {
-        if (myTrack.arrows[i].time != -1)
-        {
-            count++;
-        }
+    while (*cursor < myTrack.arrowNum && myTrack.arrows[*cursor].time < time) {
+        (*cursor)++;
     }
-    return count;
+}
+int findNextTimestamp(int songTime) {
+    advanceCursor(&aiCursor, songTime + 1);
+    return (aiCursor < myTrack.arrowNum) ? myTrack.arrows[aiCursor].time : -1; // return -1 if no valid time is found
 }
 
-track defloration() {
-    track thisTrack;
-    int arrowCounter = 0;
-    thisTrack.bpm = 125;
-    thisTrack.introLength = 4929;
-    thisTrack.songPath = "rom:/64beats/defloration.xm64";
-    // yes, i lied. it's 68 beats.
-    for (int i = 0; i < 68; i++)
+void loadSong(const char *chartPath)
+{
+    int size;
+    chartFile *chart = asset_load(chartPath, &size);
+    assertf(memcmp(chart->magic, CHART_MAGIC, 4) == 0 && chart->version == CHART_VERSION,
+        "Invalid chart file: %s", chartPath);
+
+    myTrack.bpm = chart->bpm;
+    myTrack.introLength = chart->introLength;
+    myTrack.arrowNum = chart->noteCount;
+    memcpy(myTrack.songPath, chart->songPath, CHART_SONG_PATH_LEN);
+    myTrack.songPath[CHART_SONG_PATH_LEN - 1] = '\0';
+
+    myTrack.arrows = malloc(myTrack.arrowNum * sizeof(arrowOnTrack));
+    for (int i = 0; i < myTrack.arrowNum; i++)
     {
-        float random = (float)rand() / (RAND_MAX / 4.0);
-        thisTrack.arrows[arrowCounter].time         = i * 60000/thisTrack.bpm;
-        thisTrack.arrows[arrowCounter].direction    = random;
-        thisTrack.arrows[arrowCounter++].difficulty = 1;
-    }
-    // fill up the rest of the array.
-    thisTrack.trackLength = thisTrack.arrows[arrowCounter-1].time;
-    thisTrack.arrowNum = arrowCounter;
-    for (int i = arrowCounter; i<MAX_ARROWS;i++) {
-        thisTrack.arrows[arrowCounter].time         = 9000000;
-        thisTrack.arrows[arrowCounter].direction    = 1;
-        thisTrack.arrows[arrowCounter++].difficulty = 1;
+        chartNote *note = &chart->notes[i];
+        myTrack.arrows[i] = (arrowOnTrack){
+            .time = note->time,
+            .direction = note->direction == CHART_DIR_RANDOM ? rand() % 4 : note->direction,
+            .difficulty = note->difficulty,
+        };
     }
+    myTrack.trackLength = myTrack.arrows[myTrack.arrowNum-1].time;
+    free(chart);
 
-    return thisTrack;
+    for (int i = 0; i < MAXPLAYERS; i++) {
+        hitCursor[i] = 0;
+    }
+    aiCursor = 0;
+    drawCursor = 0;
 }
-void loadSong()
+void freeSong()
 {
-    // Fill the array with data
-/*
-    for (int i = 0; i < MAX_ARROWS; i++)
-    {
-        float random = (float)rand() / (RAND_MAX / 4.0);
-        myTrack.arrows[i].time = i * (60000 / songBPM);
-        myTrack.arrows[i].direction = (uint8_t)random;
-        myTrack.arrows[i].difficulty = 1;
-    }*/
-    myTrack = defloration();
+    free(myTrack.arrows);
+    myTrack.arrows = NULL;
+    myTrack.arrowNum = 0;
 }
 int calculateXForArrow(uint8_t playerNum, uint8_t dir)
 {
@@ -412,7 +402,7 @@ void drawArrowForPlayer(uint8_t playerNum, int yPos, uint8_t dir)
                          .scale_x = ui.scale_factor_x,
                          .scale_y = ui.scale_factor_y,
                      });
-    // rdpq_text_printf(NULL, FONT_BUILTIN_DEBUG_MONO, (int32_t)(calculateXForArrow(playerNum, dir)), (int32_t)(yPos), "TIME: %d", currentTargetArrow);
+    // rdpq_text_printf(NULL, FONT_BUILTIN_DEBUG_MONO, (int32_t)(calculateXForArrow(playerNum, dir)), (int32_t)(yPos), "TIME: %d", drawCursor);
 }
 int calculateDeltaTime(int arrowIndex)
 {
@@ -420,14 +410,10 @@ int calculateDeltaTime(int arrowIndex)
 }
 void drawArrows()
 {
-    static int arrowsStart = 0;
-
     joypad_inputs_t joypad = joypad_get_inputs(0);
     float xModifier = (joypad.stick_x / 90.0 + 2) / 2;
 
-    int arrowsEnd = (arrowsStart + 50 > MAX_ARROWS) ? MAX_ARROWS : arrowsStart + 50;
-    currentTargetArrow = arrowsStart;
-    for (int i = arrowsStart; i < arrowsEnd; i++)
+    for (int i = drawCursor; i < myTrack.arrowNum; i++)
     {
         int timeDelta = calculateDeltaTime(i);
 
@@ -436,11 +422,11 @@ void drawArrows()
         yPos += SCREEN_MARGIN_TOP;
         if (yPos > 240 + arrow_sprite->height)
         {
-            continue;
+            break; // arrows are sorted by time, all following ones are further down
         }
         if (yPos < 0 - arrow_sprite->height)
         {
-            arrowsStart = i;
+            drawCursor = i;
             continue;
         }
         for (uint8_t thisPlayer = 0; thisPlayer < 4; thisPlayer++)
@@ -505,6 +491,7 @@ void minigame_cleanup()
     wav64_close(&sfx_winner);
     xm64player_stop(&music);
     xm64player_close(&music);
+    freeSong();
 
     sprite_free(arrow_up_sprite);
     sprite_free(arrow_down_sprite);
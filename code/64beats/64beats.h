@@ -1,9 +1,7 @@
-
-
+#include "chart.h"
 
 #define UI_SCALE 1.0
 #define SCREEN_MARGIN_TOP 24
-#define MAX_ARROWS 125 * 4 / 2
 #define SPEED_MULTI 1.0
 #define ACCURACY 200
 int32_t songTime = -10000;
@@ -44,12 +42,12 @@ typedef struct {
 } arrowOnTrack;
 
 typedef struct {
-    arrowOnTrack arrows[MAX_ARROWS];
+    arrowOnTrack *arrows; // sorted by time
     int trackLength;
     int arrowNum;
     int bpm;
     int introLength;
-    char *songPath;
+    char songPath[CHART_SONG_PATH_LEN];
     
 } track;
 
@@ -72,11 +70,12 @@ void updateArrows();
 void checkInputs();
 void drawUI();
 void drawUIForPlayer(uint8_t playerNum, uint8_t dir);
-int countValidEntries();
 void updateArrowList();
-void loadSong();
+void loadSong(const char *chartPath);
+void freeSong();
 void AIButtons(int songTime, float deltatime);
 int findNextTimestamp(int songTime);
+void advanceCursor(int *cursor, int time);
 
 void renderOutro();
 void drawArrows();
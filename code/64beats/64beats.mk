@@ -6,3 +6,13 @@ ASSETS_LIST += \
 	filesystem/64beats/down.rgba32.sprite \
 	filesystem/64beats/right.rgba32.sprite \
 	filesystem/64beats/defloration.xm64 \
+	filesystem/64beats/defloration.chart
+
+#assets/64beats/%.chart: assets/64beats/%.txt
+#	@echo "    [CHART] $@"
+#	code/64beats/tools/chart_compiler "$<" $@
+
+filesystem/64beats/%.chart: assets/64beats/%.chart
+	@mkdir -p $(dir $@)
+	@echo "    [CHART] $@"
+	$(ASSET_CACHE) $(N64_BINDIR)/mkasset -c 2 -o filesystem/64beats "$<"
@@ -0,0 +1,36 @@
+#ifndef BEATS_CHART_H
+#define BEATS_CHART_H
+
+// Binary chart layout, written big-endian by tools/chart_compiler
+// so it can be used in place after asset_load().
+
+#include <stdint.h>
+
+#define CHART_MAGIC "CHRT"
+#define CHART_VERSION 1
+#define CHART_SONG_PATH_LEN 48
+
+#define CHART_DIR_LEFT 0
+#define CHART_DIR_UP 1
+#define CHART_DIR_DOWN 2
+#define CHART_DIR_RIGHT 3
+#define CHART_DIR_RANDOM 0xFF
+
+typedef struct {
+    int32_t time; // ms relative to the end of the intro
+    uint8_t direction;
+    uint8_t difficulty;
+    uint16_t padding;
+} chartNote;
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t bpm;
+    int32_t introLength;
+    uint32_t noteCount;
+    char songPath[CHART_SONG_PATH_LEN];
+    chartNote notes[]; // sorted by time
+} chartFile;
+
+#endif
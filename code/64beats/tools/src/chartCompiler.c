@@ -0,0 +1,172 @@
+/***************************************************************
+                         chartCompiler.c
+
+Host tool that turns a text chart into the binary chart format
+loaded by 64beats at runtime (see chart.h).
+
+Usage: chart_compiler <input.txt> <output.chart>
+
+Text format, one command per line, '#' starts a comment:
+    bpm <beats per minute>
+    intro <intro length in ms>
+    song <rom path of the xm64 module>
+    note <beat> <L|U|D|R|?> [difficulty]
+
+Beats may be fractional, '?' picks a random direction at load
+time. Notes are sorted by time in the output.
+***************************************************************/
+#ifndef N64
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "chart.h"
+
+typedef struct {
+    int32_t time;
+    uint8_t direction;
+    uint8_t difficulty;
+    int line;
+} noteEntry;
+
+static int compareNotes(const void *a, const void *b)
+{
+    const noteEntry *na = a;
+    const noteEntry *nb = b;
+    if (na->time != nb->time) {
+        return na->time < nb->time ? -1 : 1;
+    }
+    return na->line - nb->line; // keep source order for chords
+}
+
+static void writeU16(FILE *f, uint16_t v)
+{
+    fputc(v >> 8, f);
+    fputc(v & 0xFF, f);
+}
+
+static void writeU32(FILE *f, uint32_t v)
+{
+    writeU16(f, v >> 16);
+    writeU16(f, v & 0xFFFF);
+}
+
+static int parseDirection(char c)
+{
+    switch (c) {
+        case 'L': case 'l': return CHART_DIR_LEFT;
+        case 'U': case 'u': return CHART_DIR_UP;
+        case 'D': case 'd': return CHART_DIR_DOWN;
+        case 'R': case 'r': return CHART_DIR_RIGHT;
+        case '?': return CHART_DIR_RANDOM;
+        default: return -1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <input.txt> <output.chart>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "r");
+    if (!in) {
+        fprintf(stderr, "Could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    int bpm = 0;
+    int intro = 0;
+    char songPath[CHART_SONG_PATH_LEN] = {0};
+
+    int noteCount = 0;
+    int noteCapacity = 256;
+    noteEntry *notes = malloc(noteCapacity * sizeof(noteEntry));
+
+    char line[256];
+    int lineNum = 0;
+    while (fgets(line, sizeof(line), in)) {
+        lineNum++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char cmd[16];
+        if (sscanf(line, "%15s", cmd) != 1) continue;
+
+        if (strcmp(cmd, "bpm") == 0) {
+            sscanf(line, "%*s %d", &bpm);
+        } else if (strcmp(cmd, "intro") == 0) {
+            sscanf(line, "%*s %d", &intro);
+        } else if (strcmp(cmd, "song") == 0) {
+            char path[256];
+            if (sscanf(line, "%*s %255s", path) != 1 || strlen(path) >= CHART_SONG_PATH_LEN) {
+                fprintf(stderr, "%s:%d: invalid song path\n", argv[1], lineNum);
+                return 1;
+            }
+            strcpy(songPath, path);
+        } else if (strcmp(cmd, "note") == 0) {
+            double beat;
+            char dir;
+            int difficulty = 1;
+            if (sscanf(line, "%*s %lf %c %d", &beat, &dir, &difficulty) < 2 || parseDirection(dir) < 0) {
+                fprintf(stderr, "%s:%d: invalid note\n", argv[1], lineNum);
+                return 1;
+            }
+            if (bpm <= 0) {
+                fprintf(stderr, "%s:%d: 'bpm' must come before the first note\n", argv[1], lineNum);
+                return 1;
+            }
+            if (noteCount == noteCapacity) {
+                noteCapacity *= 2;
+                notes = realloc(notes, noteCapacity * sizeof(noteEntry));
+            }
+            notes[noteCount++] = (noteEntry){
+                .time = (int32_t)(beat * 60000.0 / bpm + 0.5),
+                .direction = parseDirection(dir),
+                .difficulty = difficulty,
+                .line = lineNum,
+            };
+        } else {
+            fprintf(stderr, "%s:%d: unknown command '%s'\n", argv[1], lineNum, cmd);
+            return 1;
+        }
+    }
+    fclose(in);
+
+    if (bpm <= 0 || songPath[0] == '\0' || noteCount == 0) {
+        fprintf(stderr, "%s: chart needs a bpm, a song and at least one note\n", argv[1]);
+        return 1;
+    }
+
+    qsort(notes, noteCount, sizeof(noteEntry), compareNotes);
+
+    FILE *out = fopen(argv[2], "wb");
+    if (!out) {
+        fprintf(stderr, "Could not write %s\n", argv[2]);
+        return 1;
+    }
+
+    // Header, big-endian to match the N64.
+    fwrite(CHART_MAGIC, 1, 4, out);
+    writeU16(out, CHART_VERSION);
+    writeU16(out, bpm);
+    writeU32(out, intro);
+    writeU32(out, noteCount);
+    fwrite(songPath, 1, CHART_SONG_PATH_LEN, out);
+
+    for (int i = 0; i < noteCount; i++) {
+        writeU32(out, notes[i].time);
+        fputc(notes[i].direction, out);
+        fputc(notes[i].difficulty, out);
+        writeU16(out, 0);
+    }
+    fclose(out);
+
+    printf("%s: %d notes, %d ms\n", argv[2], noteCount, notes[noteCount - 1].time);
+    free(notes);
+    return 0;
+}
+
+#endif
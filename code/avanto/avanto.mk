@@ -35,22 +35,20 @@ AVANTO_AUDIOCONV_FLAGS += --wav-mono --wav-resample 22050 --wav-compress 3
 $(FILESYSTEM_DIR)/avanto/%.wav64: $(ASSETS_DIR)/avanto/%.mp3
 	@mkdir -p $(dir $@)
 	@echo "    [AVANTO MP3 SFX] $@"
-	$(N64_AUDIOCONV) $(AVANTO_AUDIOCONV_FLAGS) -o $(dir $@) "$<"
+	$(ASSET_CACHE) $(N64_AUDIOCONV) $(AVANTO_AUDIOCONV_FLAGS) -o $(dir $@) "$<"
 
 AVANTO_MKSPRITE_FLAGS=-c 3
 $(FILESYSTEM_DIR)/avanto/%.sprite: $(ASSETS_DIR)/avanto/%.png
 	@mkdir -p $(dir $@)
 	@echo "    [AVANTO SPRITE] $@"
-	$(N64_MKSPRITE) $(AVANTO MKSPRITE_FLAGS) -o $(dir $@) "$<"
+	$(ASSET_CACHE) $(N64_MKSPRITE) $(AVANTO MKSPRITE_FLAGS) -o $(dir $@) "$<"
 
 $(FILESYSTEM_DIR)/avanto/banner.font64: $(ASSETS_DIR)/squarewave.ttf
 	@mkdir -p $(dir $@)
 	@echo "    [AVANTO FONT] $@"
-	$(N64_MKFONT) --outline 2 --range 20-5A -s 100 -o $(dir $@) "$<"
-	mv "$(dir $@)/squarewave.font64" "$@"
+	$(ASSET_CACHE) sh -c 'mkdir -p $@.d && $(N64_MKFONT) --outline 2 --range 20-5A -s 100 -o $@.d "$<" && mv "$@.d/squarewave.font64" "$@" && rmdir $@.d'
 
 $(FILESYSTEM_DIR)/avanto/timer.font64: $(ASSETS_DIR)/squarewave.ttf
 	@mkdir -p $(dir $@)
 	@echo "    [AVANTO FONT] $@"
-	$(N64_MKFONT) --outline 1 --range 30-39 -s 48 --ellipsis 30,3 -o $(dir $@) "$<"
-	mv "$(dir $@)/squarewave.font64" "$@"
+	$(ASSET_CACHE) sh -c 'mkdir -p $@.d && $(N64_MKFONT) --outline 1 --range 30-39 -s 48 --ellipsis 30,3 -o $@.d "$<" && mv "$@.d/squarewave.font64" "$@" && rmdir $@.d'
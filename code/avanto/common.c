@@ -371,17 +371,6 @@ static void particle_source_init_steam(struct particle_source *source) {
   source->max_particles = source->_num_allocated_particles;
 }
 
-static void particle_source_spawn_snow(struct particle_source *source,
-    int8_t *pos) {
-  int8_t cx = (rand() % (source->x_range*2+1)) - source->x_range;
-  int8_t cz = (rand() % (source->z_range*2+1)) - source->z_range;
-  int8_t cy = rand() & 0xff;
-
-  pos[0] = cx;
-  pos[1] = cy;
-  pos[2] = cz;
-}
-
 static void particle_source_init_snow(struct particle_source *source) {
   source->_y_move_error = 0.f;
   for (size_t i = 0; i < source->_num_allocated_particles/2; i++) {
@@ -390,15 +379,18 @@ static void particle_source_init_snow(struct particle_source *source) {
       source->_particles[i].colorA[2] = 0xff;
       source->_particles[i].colorA[3] = 0xff;
       source->_particles[i].sizeA = 1;
-      particle_source_spawn_snow(source, source->_particles[i].posA);
 
       source->_particles[i].colorB[0] = 0xff;
       source->_particles[i].colorB[1] = 0xff;
       source->_particles[i].colorB[2] = 0xff;
       source->_particles[i].colorB[3] = 0xff;
       source->_particles[i].sizeB = 1;
-      particle_source_spawn_snow(source, source->_particles[i].posB);
   }
+  particles_snow_spawn(source->_particles,
+      source->_num_allocated_particles,
+      source->x_range,
+      source->z_range,
+      &source->_rng);
 }
 
 static void particle_source_init_splash(struct particle_source *source) {
@@ -426,14 +418,15 @@ void particle_source_init(struct particle_source *source,
 
   source->_num_allocated_particles = num_particles & 1?
     num_particles + 1 : num_particles;
-  source->_meta = NULL;
+  source->_lanes = (struct particle_lanes) {0};
+  source->_rng = particles_seed();
   source->_particles = malloc_uncached(
       sizeof(TPXParticle) * (source->_num_allocated_particles/2));
   source->_transform = malloc_uncached(sizeof(T3DMat4FP));
 
+  particles_init_tables();
   if (type != SNOW) {
-    source->_meta = malloc(
-        sizeof(struct particle_meta) * source->_num_allocated_particles);
+    particle_lanes_alloc(&source->_lanes, source->_num_allocated_particles);
   }
 
   source->_type = type;
@@ -463,42 +456,15 @@ void particle_source_reset_steam(struct particle_source *source) {
 
 void particle_source_reset_splash(struct particle_source *source,
     size_t num_particles) {
-  size_t in_use = 0;
-  for (size_t i = 0; i < source->_num_allocated_particles/2; i++) {
-    if (in_use < num_particles) {
-      source->_particles[i].sizeA = source->particle_size;
-      source->_particles[i].posA[0] = 0;
-      source->_particles[i].posA[1] = 0;
-      source->_particles[i].posA[2] = 0;
-      in_use++;
-    }
-    else {
-      source->_particles[i].sizeA = 0;
-    }
-
-    if (in_use < num_particles) {
-      source->_particles[i].sizeB = source->particle_size;
-      source->_particles[i].posB[0] = 0;
-      source->_particles[i].posB[1] = 0;
-      source->_particles[i].posB[2] = 0;
-      in_use++;
-    }
-    else {
-      source->_particles[i].sizeB = 0;
-    }
-  }
-
-  struct particle_meta *m = source->_meta;
-  for (size_t i = 0; i < num_particles; i++, m++) {
-    m->h = rand() % (source->max_height-source->min_height)
-      + source->min_height;
-    m->d = rand() % (source->max_dist-source->min_dist)
-      + source->min_dist;
-
-    float angle = rand_float(0.f, T3D_PI*2.f);
-    m->dir[0] = cosf(angle);
-    m->dir[1] = sinf(angle);
-  }
+  particles_splash_spawn(&source->_lanes,
+      source->_particles,
+      num_particles,
+      source->particle_size,
+      source->min_dist,
+      source->max_dist,
+      source->min_height,
+      source->max_height,
+      &source->_rng);
 
   source->_time = 0.f;
   source->paused = false;
@@ -516,26 +482,11 @@ void particle_source_free(struct particle_source *source) {
     free_uncached(source->_transform);
     source->_transform = NULL;
   }
-  if (source->_meta) {
-    free(source->_meta);
-    source->_meta = NULL;
+  if (source->_lanes.count) {
+    particle_lanes_free(&source->_lanes);
   }
 }
 
-static void particle_source_spawn_steam(struct particle_source *source,
-    int8_t *pos, int8_t *size, struct particle_meta *meta) {
-  int8_t cx = (rand() % (source->x_range*2+1)) - source->x_range;
-  int8_t cz = (rand() % (source->z_range*2+1)) - source->z_range;
-  meta->cx = cx;
-  meta->cz = cz;
-
-  float v = -128.f / T3D_PI;
-  *size = source->particle_size;
-  pos[0] = cx+sinf(v);
-  pos[1] = -128;
-  pos[2] = cz+cosf(v);
-}
-
 static void particle_source_iterate_steam(struct particle_source *source,
     float delta_time) {
   source->_y_move_error += ((float) source->height / source->time_to_rise)
@@ -545,57 +496,17 @@ static void particle_source_iterate_steam(struct particle_source *source,
 
   source->_to_spawn += ((float) source->max_particles / source->time_to_rise)
     * delta_time;
-  int actual_to_spawn = (int) source->_to_spawn;
-  int spawned = 0;
-
-  TPXParticle *p = source->_particles;
-  struct particle_meta *m = source->_meta;
-  for (int i = 0; i < source->_num_allocated_particles/2; i++, p++, m++) {
-    if (p->sizeA) {
-      p->posA[1] += y_move;
-      if ((int) p->posA[1] >= source->height - 128) {
-        p->sizeA = 0;
-      }
-      else {
-        p->posA[0] = m->cx
-          + sinf((float) p->posA[1] / T3D_PI)
-          * source->movement_amplitude;
-        p->posA[2] = m->cz
-          + cosf((float) p->posA[1] / T3D_PI)
-          * source->movement_amplitude;
-        float progress = (float) (p->posA[1] + 128) / (float) source->height;
-        p->colorA[3] = roundf((1.f - progress) * 255.f);
-      }
-    }
-    if (!p->sizeA && actual_to_spawn) {
-      actual_to_spawn--;
-      spawned++;
-      particle_source_spawn_steam(source, p->posA, &p->sizeA, m);
-    }
 
-    m++;
-    if (p->sizeB) {
-      p->posB[1] += y_move;
-      if ((int) p->posB[1] >= source->height - 128) {
-        p->sizeB = 0;
-      }
-      else {
-        p->posB[0] = (float) m->cx
-          + sinf((float) p->posB[1] / T3D_PI)
-          * (float) source->movement_amplitude;
-        p->posB[2] = (float) m->cz
-          + cosf((float) p->posB[1] / T3D_PI)
-          * (float) source->movement_amplitude;
-        float progress = (float) (p->posB[1] + 128) / (float) source->height;
-        p->colorB[3] = roundf((1.f - progress) * 255.f);
-      }
-    }
-    if (!p->sizeB && actual_to_spawn) {
-      actual_to_spawn--;
-      spawned++;
-      particle_source_spawn_steam(source, p->posB, &p->sizeB, m);
-    }
-  }
+  int spawned = particles_steam_step(&source->_lanes,
+      source->_particles,
+      y_move,
+      source->height,
+      source->movement_amplitude,
+      (int) source->_to_spawn,
+      source->particle_size,
+      source->x_range,
+      source->z_range,
+      &source->_rng);
   source->_to_spawn -= (float) spawned;
 }
 
@@ -605,11 +516,9 @@ static void particle_source_iterate_snow(struct particle_source *source,
   int y_move = (int) source->_y_move_error;
   source->_y_move_error -= (float) y_move;
 
-  TPXParticle *p = source->_particles;
-  for (int i = 0; i < source->_num_allocated_particles/2; i++, p++) {
-    p->posA[1] -= y_move;
-    p->posB[1] -= y_move;
-  }
+  particles_snow_step(source->_particles,
+      source->_num_allocated_particles,
+      y_move);
 }
 
 static void particle_source_iterate_splash(struct particle_source *source,
@@ -617,39 +526,9 @@ static void particle_source_iterate_splash(struct particle_source *source,
   source->_time += delta_time;
   float move = source->_time * source->speed;
 
-  TPXParticle *p = source->_particles;
-  struct particle_meta *m = source->_meta;
-  size_t num_active = 0;
-  for (int i = 0; i < source->_num_allocated_particles/2; i++, p++, m++) {
-    if (p->sizeA) {
-      if ((int8_t) move > m->d) {
-        p->sizeA = 0;
-      }
-      else {
-        p->posA[0] = roundf(move*m->dir[0]);
-        p->posA[1] = roundf((float) m->h * sinf(move/(float) m->d * T3D_PI));
-        p->posA[2] = roundf(move*m->dir[1]);
-      }
-    }
-    if (p->sizeA) {
-      num_active++;
-    }
-
-    m++;
-    if (p->sizeB) {
-      if ((int8_t) move > m->d) {
-        p->sizeB = 0;
-      }
-      else {
-        p->posB[0] = roundf(move*m->dir[0]);
-        p->posB[1] = roundf((float) m->h * sinf(move/(float) m->d * T3D_PI));
-        p->posB[2] = roundf(move*m->dir[1]);
-      }
-    }
-    if (p->sizeB) {
-      num_active++;
-    }
-  }
+  size_t num_active = particles_splash_step(&source->_lanes,
+      source->_particles,
+      move);
 
   if (!num_active) {
     source->paused = true;
@@ -1,3 +1,5 @@
+#include "particles.h"
+
 #define MAX_GROUND_CHANGES 6
 #define EPS 1e-6
 #define TIMER_Y 220
@@ -179,20 +181,6 @@ enum particle_type {
   SPLASH,
 };
 
-struct particle_meta {
-  union {
-    struct {
-      int8_t cx;
-      int8_t cz;
-    };
-    struct {
-      float dir[2];
-      int8_t h;
-      int8_t d;
-    };
-  };
-};
-
 struct particle_source {
   T3DVec3 pos;
   T3DVec3 rot;
@@ -225,7 +213,8 @@ struct particle_source {
     };
   };
 
-  struct particle_meta *_meta;
+  struct particle_lanes _lanes;
+  uint32_t _rng;
   T3DMat4FP *_transform;
   TPXParticle *_particles;
   size_t _num_allocated_particles;
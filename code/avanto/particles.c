@@ -0,0 +1,233 @@
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/tpx.h>
+
+#include "particles.h"
+
+// One full turn is PARTICLE_LUT_SIZE steps
+static int16_t sin_q15[PARTICLE_LUT_SIZE];
+// sin(y/pi) and cos(y/pi) for every int8 height, used for the steam wobble
+static int16_t steam_wobble_sin_q8[PARTICLE_LUT_SIZE];
+static int16_t steam_wobble_cos_q8[PARTICLE_LUT_SIZE];
+// 65536/d for every splash distance
+static uint32_t inv_dist_q16[128];
+static bool tables_ready = false;
+static uint32_t seed_state = 0x2545f491;
+
+void particles_init_tables() {
+  if (tables_ready) {
+    return;
+  }
+  for (int i = 0; i < PARTICLE_LUT_SIZE; i++) {
+    sin_q15[i] = roundf(sinf(i * (T3D_PI*2.f / PARTICLE_LUT_SIZE)) * 32767.f);
+    float v = (float) (int8_t) i / T3D_PI;
+    steam_wobble_sin_q8[i] = roundf(sinf(v) * 256.f);
+    steam_wobble_cos_q8[i] = roundf(cosf(v) * 256.f);
+  }
+  inv_dist_q16[0] = 65536;
+  for (int i = 1; i < 128; i++) {
+    inv_dist_q16[i] = 65536 / i;
+  }
+  tables_ready = true;
+}
+
+uint32_t particles_seed() {
+  return particles_rand(&seed_state);
+}
+
+uint32_t particles_rand(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+int particles_rand_range(uint32_t *state, int min, int max) {
+  if (max <= min) {
+    return min;
+  }
+  return (int) (particles_rand(state) % (uint32_t) (max - min)) + min;
+}
+
+void particle_lanes_alloc(struct particle_lanes *lanes, size_t count) {
+  // all lanes share one block, int16 lane first to keep it aligned
+  uint8_t *data = malloc(count * (sizeof(int16_t) + sizeof(int8_t)*4));
+  lanes->count = count;
+  lanes->y = (int16_t *) data;
+  lanes->cx = (int8_t *) (data + count*sizeof(int16_t));
+  lanes->cz = lanes->cx + count;
+  lanes->h = lanes->cz + count;
+  lanes->d = lanes->h + count;
+}
+
+void particle_lanes_free(struct particle_lanes *lanes) {
+  free(lanes->y);
+  lanes->y = NULL;
+  lanes->cx = lanes->cz = lanes->h = lanes->d = NULL;
+  lanes->count = 0;
+}
+
+struct steam_params {
+  int y_move;
+  int y_end;
+  int amplitude_q8;
+  int alpha_step_q16;
+  int to_spawn;
+  int8_t size;
+  int8_t x_range;
+  int8_t z_range;
+  uint32_t *rng;
+};
+
+static inline void steam_update(struct steam_params *sp,
+    int16_t *y, int8_t *cx, int8_t *cz,
+    int8_t *pos, int8_t *size, uint8_t *alpha) {
+  if (*size) {
+    *y += sp->y_move;
+    if (*y >= sp->y_end) {
+      *size = 0;
+    }
+    else {
+      uint8_t i = (uint8_t) *y;
+      int wobble_x = (steam_wobble_sin_q8[i] * sp->amplitude_q8) >> 16;
+      int wobble_z = (steam_wobble_cos_q8[i] * sp->amplitude_q8) >> 16;
+      int a = 255 - (((*y + 128) * sp->alpha_step_q16) >> 16);
+      pos[0] = *cx + wobble_x;
+      pos[1] = *y;
+      pos[2] = *cz + wobble_z;
+      *alpha = a < 0? 0 : a;
+    }
+  }
+  if (!*size && sp->to_spawn) {
+    sp->to_spawn--;
+    *cx = particles_rand_range(sp->rng, -sp->x_range, sp->x_range+1);
+    *cz = particles_rand_range(sp->rng, -sp->z_range, sp->z_range+1);
+    *y = -128;
+    *size = sp->size;
+    pos[0] = *cx + ((steam_wobble_sin_q8[0x80] * sp->amplitude_q8) >> 16);
+    pos[1] = -128;
+    pos[2] = *cz + ((steam_wobble_cos_q8[0x80] * sp->amplitude_q8) >> 16);
+    *alpha = 255;
+  }
+}
+
+int particles_steam_step(struct particle_lanes *lanes,
+    TPXParticle *tpx,
+    int y_move,
+    int height,
+    float amplitude,
+    int to_spawn,
+    int8_t size,
+    int8_t x_range,
+    int8_t z_range,
+    uint32_t *rng) {
+  struct steam_params sp = {
+    .y_move = y_move,
+    .y_end = height - 128,
+    .amplitude_q8 = (int) (amplitude * 256.f),
+    .alpha_step_q16 = height > 0? (255 << 16) / height : 0,
+    .to_spawn = to_spawn,
+    .size = size,
+    .x_range = x_range,
+    .z_range = z_range,
+    .rng = rng,
+  };
+
+  TPXParticle *p = tpx;
+  for (size_t i = 0; i < lanes->count; i += 2, p++) {
+    steam_update(&sp, &lanes->y[i], &lanes->cx[i], &lanes->cz[i],
+        p->posA, &p->sizeA, &p->colorA[3]);
+    steam_update(&sp, &lanes->y[i+1], &lanes->cx[i+1], &lanes->cz[i+1],
+        p->posB, &p->sizeB, &p->colorB[3]);
+  }
+  return to_spawn - sp.to_spawn;
+}
+
+void particles_snow_spawn(TPXParticle *tpx,
+    size_t count,
+    int8_t x_range,
+    int8_t z_range,
+    uint32_t *rng) {
+  TPXParticle *p = tpx;
+  for (size_t i = 0; i < count; i += 2, p++) {
+    p->posA[0] = particles_rand_range(rng, -x_range, x_range+1);
+    p->posA[1] = particles_rand(rng) & 0xff;
+    p->posA[2] = particles_rand_range(rng, -z_range, z_range+1);
+    p->posB[0] = particles_rand_range(rng, -x_range, x_range+1);
+    p->posB[1] = particles_rand(rng) & 0xff;
+    p->posB[2] = particles_rand_range(rng, -z_range, z_range+1);
+  }
+}
+
+void particles_snow_step(TPXParticle *tpx, size_t count, int y_move) {
+  // heights wrap around on purpose, flakes leaving the bottom come back at the top
+  uint8_t move = y_move;
+  TPXParticle *p = tpx;
+  for (size_t i = 0; i < count; i += 2, p++) {
+    p->posA[1] = (uint8_t) p->posA[1] - move;
+    p->posB[1] = (uint8_t) p->posB[1] - move;
+  }
+}
+
+void particles_splash_spawn(struct particle_lanes *lanes,
+    TPXParticle *tpx,
+    size_t num_particles,
+    int8_t size,
+    int8_t min_dist,
+    int8_t max_dist,
+    int8_t min_height,
+    int8_t max_height,
+    uint32_t *rng) {
+  TPXParticle *p = tpx;
+  for (size_t i = 0; i < lanes->count; i += 2, p++) {
+    p->sizeA = i < num_particles? size : 0;
+    p->sizeB = i+1 < num_particles? size : 0;
+    memset(p->posA, 0, sizeof(p->posA));
+    memset(p->posB, 0, sizeof(p->posB));
+  }
+
+  for (size_t i = 0; i < num_particles && i < lanes->count; i++) {
+    lanes->h[i] = particles_rand_range(rng, min_height, max_height);
+    lanes->d[i] = particles_rand_range(rng, min_dist, max_dist);
+
+    uint8_t angle = particles_rand(rng);
+    lanes->cx[i] = sin_q15[(uint8_t) (angle + PARTICLE_LUT_SIZE/4)] >> 8;
+    lanes->cz[i] = sin_q15[angle] >> 8;
+  }
+}
+
+static inline bool splash_update(int move_q8, int8_t dir_x, int8_t dir_z,
+    int8_t h, int8_t d, int8_t *pos, int8_t *size) {
+  if (!*size) {
+    return false;
+  }
+  if ((move_q8 >> 8) > d) {
+    *size = 0;
+    return false;
+  }
+  // half a turn over the travel distance, move/d is Q24 here
+  uint32_t i = ((uint32_t) move_q8 * inv_dist_q16[d & 0x7f]) >> (24 - (PARTICLE_LUT_BITS-1));
+  i = i > PARTICLE_LUT_SIZE/2? PARTICLE_LUT_SIZE/2 : i;
+  pos[0] = (move_q8 * dir_x + (1 << 14)) >> 15;
+  pos[1] = (h * sin_q15[i] + (1 << 14)) >> 15;
+  pos[2] = (move_q8 * dir_z + (1 << 14)) >> 15;
+  return true;
+}
+
+size_t particles_splash_step(const struct particle_lanes *lanes,
+    TPXParticle *tpx,
+    float move) {
+  int move_q8 = (int) (move * 256.f);
+  size_t num_active = 0;
+
+  TPXParticle *p = tpx;
+  for (size_t i = 0; i < lanes->count; i += 2, p++) {
+    num_active += splash_update(move_q8, lanes->cx[i], lanes->cz[i],
+        lanes->h[i], lanes->d[i], p->posA, &p->sizeA);
+    num_active += splash_update(move_q8, lanes->cx[i+1], lanes->cz[i+1],
+        lanes->h[i+1], lanes->d[i+1], p->posB, &p->sizeB);
+  }
+  return num_active;
+}
@@ -0,0 +1,52 @@
+#define PARTICLE_LUT_BITS 8
+#define PARTICLE_LUT_SIZE (1 << PARTICLE_LUT_BITS)
+
+// Per-particle simulation state, one entry per particle (not per TPX pair).
+struct particle_lanes {
+  size_t count;
+  // Steam: height, kept in 16 bits so it can't wrap before the particle dies
+  int16_t *y;
+  // Steam: center of the wobble. Splash: direction as Q7 cos/sin
+  int8_t *cx;
+  int8_t *cz;
+  // Splash: peak height and travel distance
+  int8_t *h;
+  int8_t *d;
+};
+
+void particles_init_tables();
+uint32_t particles_seed();
+uint32_t particles_rand(uint32_t *state);
+int particles_rand_range(uint32_t *state, int min, int max);
+
+void particle_lanes_alloc(struct particle_lanes *lanes, size_t count);
+void particle_lanes_free(struct particle_lanes *lanes);
+
+int particles_steam_step(struct particle_lanes *lanes,
+    TPXParticle *tpx,
+    int y_move,
+    int height,
+    float amplitude,
+    int to_spawn,
+    int8_t size,
+    int8_t x_range,
+    int8_t z_range,
+    uint32_t *rng);
+void particles_snow_spawn(TPXParticle *tpx,
+    size_t count,
+    int8_t x_range,
+    int8_t z_range,
+    uint32_t *rng);
+void particles_snow_step(TPXParticle *tpx, size_t count, int y_move);
+void particles_splash_spawn(struct particle_lanes *lanes,
+    TPXParticle *tpx,
+    size_t num_particles,
+    int8_t size,
+    int8_t min_dist,
+    int8_t max_dist,
+    int8_t min_height,
+    int8_t max_height,
+    uint32_t *rng);
+size_t particles_splash_step(const struct particle_lanes *lanes,
+    TPXParticle *tpx,
+    float move);
@@ -17,6 +17,11 @@ namespace {
   constexpr int CHANNEL_SFX_COUNT = 8;
 
   constexpr float BGM_FADE_TIME = 2.0f;
+  constexpr float MIN_AUDIBLE_VOL = 0.02f; // below this, voices never get a channel
+
+  float getVoiceScore(float vol, uint8_t priority) {
+    return (float)priority * 2.0f + vol; // volume is always <= 1.0
+  }
   uint32_t lastIdx{};
 
   int findFreeChannel() {
@@ -68,6 +73,9 @@ AudioManager::AudioManager() {
 }
 
 AudioManager::~AudioManager() {
+  for(uint32_t i=0; i<voiceCount; ++i) {
+    if(voices[i].channel >= 0)voiceStop(voices[i]);
+  }
   for(auto &sfx : sfxMap) {
     free_uncached(sfx.second.sampleData);
     wav64_close(&sfx.second.source);
@@ -81,8 +89,56 @@ void AudioManager::update(const T3DVec3 &camPos, const T3DVec3 &camTarget, float
   currCamPos = camPos;
   listenerDir = camTarget - camPos;
   t3d_vec3_norm(listenerDir);
+  t3d_vec3_cross(listenerRight, listenerDir, {0.0f, 1.0f, 0.0f});
 
   ticks = get_ticks();
+
+  // advance playback of all voices, drop finished ones
+  for(int i=(int)voiceCount-1; i>=0; --i) {
+    auto &voice = voices[i];
+    voice.playPos += voice.freq * deltaTime;
+    bool finished = voice.channel >= 0
+      ? !mixer_ch_playing(voice.channel)
+      : voice.playPos >= (float)voice.sfx->source.wave.len;
+
+    if(finished)voiceRemove(i);
+  }
+
+  // batched attenuation, also done for virtual voices to know if they need a channel again
+  for(uint32_t i=0; i<voiceCount; ++i) {
+    updateVoiceMix(voices[i]);
+  }
+
+  // sort by importance, only the first 'CHANNEL_SFX_COUNT' audible ones get a channel
+  uint8_t order[VOICE_COUNT];
+  float score[VOICE_COUNT];
+  for(uint32_t i=0; i<voiceCount; ++i) {
+    score[i] = getVoiceScore(voices[i].vol, voices[i].priority);
+    uint32_t j = i;
+    for(; j>0 && score[order[j-1]] < score[i]; --j)order[j] = order[j-1];
+    order[j] = i;
+  }
+
+  uint32_t realCount = 0;
+  for(uint32_t i=0; i<voiceCount; ++i) {
+    auto &voice = voices[order[i]];
+    bool wantsChannel = realCount < CHANNEL_SFX_COUNT && voice.vol >= MIN_AUDIBLE_VOL;
+    if(wantsChannel)++realCount;
+    if(!wantsChannel && voice.channel >= 0)voiceStop(voice); // virtualize
+  }
+
+  voiceCountReal = 0;
+  for(uint32_t i=0; i<realCount; ++i) {
+    auto &voice = voices[order[i]];
+    if(voice.channel < 0) { // devirtualize
+      int ch = findFreeChannel();
+      if(ch < 0 || !voiceStart(voice, ch))continue;
+    } else {
+      mixer_ch_set_vol_pan(voice.channel, voice.vol, voice.pan);
+    }
+    ++voiceCountReal;
+  }
+
   bgmVolume.update(deltaTime);
   float fadeNorm = bgmVolume.value / BGM_FADE_TIME;
   fadeNorm *= volBGM;
@@ -121,24 +177,75 @@ void AudioManager::setBGMVolume(float vol) {
   bgmVolume.target = vol;
 }
 
-void AudioManager::setVolume3D(int channel, const T3DVec3 &soundPos, float baseVolume)
+void AudioManager::updateVoiceMix(Voice &voice)
 {
-  auto listenerToSfx = soundPos - currCamPos;
+  if(voice.is2D) {
+    voice.vol = voice.baseVol;
+    voice.pan = 0.5f;
+    return;
+  }
+
+  auto listenerToSfx = voice.pos - currCamPos;
   float dist = t3d_vec3_len(listenerToSfx);
   if(dist < 0.0001f)dist = 0.0001f;
-  float volume = (1.0f / dist) * baseVolume * 3.0f;
-  volume = fminf(volume, 1.0f);
+  float volume = (1.0f / dist) * voice.baseVol * 3.0f;
+  voice.vol = fminf(volume, 1.0f);
 
   listenerToSfx /= dist;
-  T3DVec3 cross;
-  t3d_vec3_cross(cross, listenerDir, {0.0f, 1.0f, 0.0f});
-  float pan = t3d_vec3_dot(listenerToSfx, cross);
-  pan = pan * 0.5f + 0.5f;
-  /*debugf("SFX-3D: %.2f %.2f %.2f -> %.2f %.2f %.2f: pan: %f, vol: %f\n",
-    soundPos.x, soundPos.y, soundPos.z,
-    currCamPos.x, currCamPos.y, currCamPos.z,
-    pan, volume);*/
-  mixer_ch_set_vol_pan(channel, volume, pan);
+  float pan = t3d_vec3_dot(listenerToSfx, listenerRight);
+  voice.pan = pan * 0.5f + 0.5f;
+}
+
+bool AudioManager::voiceStart(Voice &voice, int channel)
+{
+  for(auto &instance : voice.sfx->instances) {
+    if(instance.channel != 0)continue;
+
+    instance.channel = channel;
+    voice.inst = &instance;
+    voice.channel = channel;
+
+    mixer_ch_set_vol_pan(channel, voice.vol, voice.pan);
+    mixer_ch_play(channel, &instance.wave.wave);
+    mixer_ch_set_freq(channel, voice.freq);
+    if(voice.playPos > 0.0f) {
+      mixer_ch_set_pos(channel, voice.playPos);
+    }
+    return true;
+  }
+  //debugf("SFX: no free instance!\n");
+  return false;
+}
+
+void AudioManager::voiceStop(Voice &voice)
+{
+  mixer_ch_stop(voice.channel);
+  voice.inst->channel = 0;
+  voice.inst = nullptr;
+  voice.channel = -1;
+}
+
+void AudioManager::voiceRemove(uint32_t idx)
+{
+  auto &voice = voices[idx];
+  if(voice.inst)voice.inst->channel = 0;
+  voices[idx] = voices[--voiceCount];
+}
+
+int AudioManager::findLowestVoice(bool realOnly)
+{
+  int res = -1;
+  float resScore = 0.0f;
+  for(uint32_t i=0; i<voiceCount; ++i) {
+    auto &voice = voices[i];
+    if(realOnly && voice.channel < 0)continue;
+    float score = getVoiceScore(voice.vol, voice.priority);
+    if(res < 0 || score < resScore) {
+      res = (int)i;
+      resScore = score;
+    }
+  }
+  return res;
 }
 
 uint32_t AudioManager::playSFX(uint64_t name, const T3DVec3 &pos, SfxConf conf) {
@@ -168,32 +275,51 @@ uint32_t AudioManager::playSFX(uint64_t name, const T3DVec3 &pos, SfxConf conf)
     //data_cache_hit_writeback(it->second.sampleData, dataSize);
   }
 
-  // check if any channel is free
+  Voice newVoice{
+    .sfx = &it->second,
+    .pos = pos,
+    .baseVol = conf.volume * volSFX,
+    .freq = it->second.source.wave.frequency,
+    .priority = conf.priority,
+    .is2D = conf.is2D,
+  };
+  if(conf.variation) {
+    newVoice.freq -= (conf.variation / 255.0f) * Math::rand01() * 10000.0f;
+  }
+  updateVoiceMix(newVoice);
+  float newScore = getVoiceScore(newVoice.vol, newVoice.priority);
+
+  // all logical voices in use, replace the least important one
+  if(voiceCount == VOICE_COUNT) {
+    int idx = findLowestVoice(false);
+    auto &lowest = voices[idx];
+    if(getVoiceScore(lowest.vol, lowest.priority) >= newScore)return 0;
+    if(lowest.channel >= 0)voiceStop(lowest);
+    voiceRemove(idx);
+  }
+
+  auto &voice = voices[voiceCount++];
+  voice = newVoice;
+  if(voice.vol < MIN_AUDIBLE_VOL)return 0; // stays virtual until 'update' says otherwise
+
+  // check if any channel is free, otherwise steal one from a less important voice
   int ch = findFreeChannel();
   if(ch < 0) {
-    //debugf("SFX: no free channels!\n");
-    return 0;
-  }
-
-  // find free instance in SFX
-  for(auto & instance : it->second.instances) {
-    if(instance.channel == 0 || !mixer_ch_playing(instance.channel)) {
-      instance.channel = ch;
-      float vol = conf.volume * volSFX;
-      if(conf.is2D) {
-        mixer_ch_set_vol(ch, vol, vol);
-      } else {
-        setVolume3D(ch, pos, vol);
-      }
-      mixer_ch_play(ch, &instance.wave.wave);
-      if(conf.variation) {
-        float var = (conf.variation / 255.0f) * Math::rand01() * 10000.0f;
-        mixer_ch_set_freq(ch, instance.wave.wave.frequency - var);
-      }
-      return 0;
-    }
+    int idx = findLowestVoice(true);
+    if(idx < 0)return 0;
+    auto &lowest = voices[idx];
+    if(getVoiceScore(lowest.vol, lowest.priority) >= newScore)return 0;
+
+    // every instance of this sound may already be playing, only steal if the new voice can start
+    bool canStart = lowest.sfx == voice.sfx;
+    for(auto &instance : voice.sfx->instances)canStart |= instance.channel == 0;
+    if(!canStart)return 0;
+
+    ch = lowest.channel;
+    voiceStop(lowest);
   }
-  //debugf("SFX: no free instance!\n");
+
+  voiceStart(voice, ch);
   return 0;
 }
 
@@ -9,11 +9,20 @@
 #include <t3d/t3dmath.h>
 #include <unordered_map>
 
+// Voice priorities for SfxConf, when channels run out lower ones are virtualized first
+namespace SfxPrio {
+  constexpr uint8_t AMBIENT = 0; // frequent, quiet feedback (grass, small impacts)
+  constexpr uint8_t ACTION  = 1; // direct result of a player action
+  constexpr uint8_t EVENT   = 2; // boss, void and cutscene cues
+  constexpr uint8_t UI      = 3; // menus, should never be cut
+}
+
 struct SfxConf {
   float volume{1.0};
   uint8_t loop{0};
   uint8_t is2D{0};
   uint8_t variation{0};
+  uint8_t priority{0}; // higher values win over louder sounds when channels run out
 };
 
 class AudioManager {
@@ -32,7 +41,31 @@ class AudioManager {
       std::array<SFXInstance, 4> instances{};
     };
 
+    /**
+     * Logical sound, only backed by a mixer channel while it is one of the
+     * most important ones. Otherwise it is 'virtual' and only advances its
+     * playback position so it can resume in sync once it becomes audible again.
+     */
+    struct Voice {
+      SFX *sfx{};
+      SFXInstance *inst{}; // only set while the voice owns a channel
+      T3DVec3 pos{};
+      float baseVol{};
+      float vol{};
+      float pan{0.5f};
+      float freq{};
+      float playPos{}; // in samples
+      int8_t channel{-1};
+      uint8_t priority{};
+      uint8_t is2D{};
+    };
+
+    static constexpr uint32_t VOICE_COUNT = 32;
+
     std::unordered_map<uint64_t, SFX> sfxMap;
+    std::array<Voice, VOICE_COUNT> voices{};
+    uint32_t voiceCount{0};
+    uint32_t voiceCountReal{0};
     wav64_t bgm{};
     wav64_t infoSFXStart{};
     wav64_t infoSFXWin{};
@@ -43,7 +76,13 @@ class AudioManager {
     float volSFX{0.9f};
     Math::Timer bgmVolume{};
 
-    void setVolume3D(int channel, const T3DVec3 &soundPos, float baseVolume = 1.0f);
+    T3DVec3 listenerRight{1.0f, 0.0f, 0.0f};
+
+    void updateVoiceMix(Voice &voice);
+    bool voiceStart(Voice &voice, int channel);
+    void voiceStop(Voice &voice);
+    void voiceRemove(uint32_t idx);
+    int findLowestVoice(bool realOnly);
     static void waveformRead(void *ctx, samplebuffer_t *sbuf, int wpos, int wlen, bool seeking);
 
   public:
@@ -68,4 +107,6 @@ class AudioManager {
     void playInfoSFX(uint64_t name);
 
     uint32_t getActiveChannelMask();
+    uint32_t getVoiceCount() const { return voiceCount; }
+    uint32_t getRealVoiceCount() const { return voiceCountReal; }
 };
\ No newline at end of file
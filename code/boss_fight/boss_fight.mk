@@ -28,27 +28,31 @@ BOSS_FIGHT_assets_conv = $(patsubst assets/%,filesystem/%,$(BOSS_FIGHT_assets_co
 #	@echo "    [COLL] $@"
 #	code/boss_fight/tools/gltf_to_coll "$<" assets/boss_fight/map.coll
 
+# Both tools also take a manifest of "input.glb output" lines and convert them in parallel,
+# unchanged inputs are skipped (hashes are kept in '<manifest>.stamps'):
+#	code/boss_fight/tools/gltf_to_coll --batch assets/boss_fight/coll.manifest [-j threads] [--force]
+
 filesystem/boss_fight/%.coll: assets/boss_fight/%.coll
 	@mkdir -p $(dir $@)
 	@echo "    [COLL] $@"
-	$(N64_BINDIR)/mkasset -c 3 -w 256 -o filesystem/boss_fight "$<"
+	$(ASSET_CACHE) $(N64_BINDIR)/mkasset -c 3 -w 256 -o filesystem/boss_fight "$<"
 
 filesystem/boss_fight/%.scene: assets/boss_fight/%.scene
 	@mkdir -p $(dir $@)
 	@echo "    [SCENE] $@"
-	$(N64_BINDIR)/mkasset -c 2 -w 256 -o filesystem/boss_fight "$<"
+	$(ASSET_CACHE) $(N64_BINDIR)/mkasset -c 2 -w 256 -o filesystem/boss_fight "$<"
 
 BOSS_FIGHT_AUDIOCONV_FLAGS = --wav-resample 22050 --wav-mono
 
 filesystem/boss_fight/bgm/%.wav64: assets/boss_fight/bgm/%.mp3
 	@mkdir -p $(dir $@)
 	@echo "    [SFX] $@"
-	$(N64_AUDIOCONV) $(BOSS_FIGHT_AUDIOCONV_FLAGS) -o $(dir $@) "$<"
+	$(ASSET_CACHE) $(N64_AUDIOCONV) $(BOSS_FIGHT_AUDIOCONV_FLAGS) -o $(dir $@) "$<"
 
 filesystem/boss_fight/sfx/%.wav64: assets/boss_fight/sfx/%.wav
 	@mkdir -p $(dir $@)
 	@echo "    [SFX] $@"
-	$(N64_AUDIOCONV) $(BOSS_FIGHT_AUDIOCONV_FLAGS) --wav-compress 0 -o $(dir $@) "$<"
+	$(ASSET_CACHE) $(N64_AUDIOCONV) $(BOSS_FIGHT_AUDIOCONV_FLAGS) --wav-compress 0 -o $(dir $@) "$<"
 	# $(N64_BINDIR)/mkasset -c 3 -o $(dir $@) $@
 
 
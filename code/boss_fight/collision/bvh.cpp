@@ -24,10 +24,7 @@ namespace {
       return;
     }
 
-    int offsetEnd = offset + dataCount;
-    while(offset < offsetEnd && ctxRes->count < Coll::MAX_RESULT_COUNT) {
-      ctxRes->triIndex[ctxRes->count++] = ctxData[offset++];
-    }
+    ctxRes->triIndex.insert(ctxRes->triIndex.end(), &ctxData[offset], &ctxData[offset + dataCount]);
   }
 
   void queryNodeRaycastFloor(const Coll::BVHNode *node)
@@ -43,10 +40,7 @@ namespace {
       return;
     }
 
-    int offsetEnd = offset + dataCount;
-    while(offset < offsetEnd && ctxRes->count < Coll::MAX_RESULT_COUNT) {
-      ctxRes->triIndex[ctxRes->count++] = ctxData[offset++];
-    }
+    ctxRes->triIndex.insert(ctxRes->triIndex.end(), &ctxData[offset], &ctxData[offset + dataCount]);
   }
 }
 
@@ -8,13 +8,13 @@
 
 namespace Coll
 {
-  constexpr int MAX_RESULT_COUNT = 32;
-
+  // Triangle indices of a query, not capped so a large swept box can't lose triangles.
+  // Keep one around and reset() it, the storage grows to the largest query and is then reused.
   struct BVHResult {
-    int16_t triIndex[MAX_RESULT_COUNT]{};
-    int16_t count{};
+    std::vector<int16_t> triIndex{};
 
-    void reset() { count = 0; }
+    void reset() { triIndex.clear(); }
+    uint32_t count() const { return triIndex.size(); }
   };
 
   struct BVHNode {
@@ -179,6 +179,29 @@ Coll::CollInfo Coll::Mesh::vsSphere(const Coll::Sphere &sphere, const Coll::Tria
   return triVsSphere(sphere, triangle);
 }
 
+bool Coll::Mesh::sweepSphere(const Coll::Sphere &sphere, const T3DVec3 &move, const Coll::Triangle &face, float &toi) const
+{
+  // only care about movement into the front-face
+  float moveDot = t3d_vec3_dot(&move, &face.normal);
+  if(moveDot > -MIN_PENETRATION)return false;
+
+  float planeDist = pointPlaneDistance(sphere.center, *face.v[0], face.normal);
+  if(planeDist < sphere.radius)return false;
+
+  float t = (sphere.radius - planeDist) / moveDot;
+  if(t >= toi)return false;
+
+  // point on the sphere touching the plane at that time must be inside the triangle
+  T3DVec3 contactPoint = sphere.center + move * t - face.normal * sphere.radius;
+  auto baryPos = getTriBaryCoord(contactPoint, *face.v[0], *face.v[1], *face.v[2]);
+  const bool isInTri = (baryPos.v[0] >= 0.0f) && (baryPos.v[1] >= 0.0f)
+    && ((baryPos.v[0] + baryPos.v[1]) <= 1.0f);
+
+  if(!isInTri)return false;
+  toi = t;
+  return true;
+}
+
 Coll::CollInfo Coll::Mesh::vsFloorRay(const T3DVec3 &rayStart, const Coll::Triangle &face) const
 {
     const auto &vert0 = *face.v[0];
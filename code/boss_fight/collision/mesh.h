@@ -27,6 +27,13 @@ namespace Coll
     [[nodiscard]] Coll::CollInfo vsSphere(const Coll::Sphere &sphere, const Triangle& triangle) const;
     [[nodiscard]] Coll::CollInfo vsFloorRay(const T3DVec3 &pos, const Triangle& triangle) const;
 
+    /**
+     * Moves the sphere by 'move' and checks if it hits the face of the triangle.
+     * Only hits earlier than the current 'toi' (0-1) are reported, in which case 'toi' is updated.
+     * Edges and already touching triangles are left to 'vsSphere'.
+     */
+    bool sweepSphere(const Coll::Sphere &sphere, const T3DVec3 &move, const Triangle& triangle, float &toi) const;
+
     static Mesh* load(const std::string &path);
   };
 
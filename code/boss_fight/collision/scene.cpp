@@ -16,17 +16,151 @@ namespace {
   constexpr bool isFloor(const T3DVec3 &normal) {
     return normal.v[1] > FLOOR_ANGLE;
   }
+
+  constexpr int MAX_SLIDE_ITERATIONS = 3;
+  constexpr float SWEEP_TOI_SKIN = 0.001f;
+
+  struct SweepCandidate {
+    Coll::Triangle tri{};
+    const Coll::MeshInstance *inst{};
+  };
+
+  // both grow to the largest query seen and are then reused, nothing is dropped when a query gets large
+  std::vector<SweepCandidate> sweepCandidates{};
+  Coll::BVHResult bvhRes{};
+
+  // Which CollTypes can collide with each other (bitmask per type), pairs not in here are never checked
+  constexpr uint8_t typeBit(Coll::CollType type) {
+    return 1 << (uint8_t)type;
+  }
+
+  constexpr uint8_t ALL_TYPES = (1 << Coll::COLL_TYPE_COUNT) - 1;
+
+  // pairs are only looked up with typeA <= typeB, so a row only needs its own and the later types
+  constexpr uint8_t TYPE_TARGETS[Coll::COLL_TYPE_COUNT] = {
+    ALL_TYPES, // PLAYER
+    ALL_TYPES, // BOSS_HEAD
+    ALL_TYPES, // BOSS_BODY
+    ALL_TYPES, // SWORD
+    ALL_TYPES & ~typeBit(Coll::CollType::COIN), // COIN, plain coins don't push each other
+    ALL_TYPES, // COIN_MULTI
+    ALL_TYPES, // DESTRUCTABLE
+  };
+
+  Coll::AABB getSweptAABB(const T3DVec3 &start, const T3DVec3 &end, float radius) {
+    // BVH is stored in a 64x scaled integer space
+    constexpr float BVH_SCALE = 64.0f;
+    Coll::AABB res{};
+    for(int i=0; i<3; ++i) {
+      res.min.v[i] = (int16_t)((fminf(start.v[i], end.v[i]) - radius) * BVH_SCALE);
+      res.max.v[i] = (int16_t)((fmaxf(start.v[i], end.v[i]) + radius) * BVH_SCALE);
+    }
+    return res;
+  }
 }
 
-Coll::CollInfo Coll::Scene::vsSphere(Coll::Sphere &sphere, const T3DVec3 &velocity, float deltaTime) {
-  uint64_t ticksStart = get_ticks();
-  float len2 = t3d_vec3_len2(velocity);
+void Coll::Scene::meshRefitBounds(MeshEntry &entry) {
+  // root node of the BVH covers the whole mesh, stored in a 64x scaled integer space
+  const auto &aabb = entry.inst->mesh->bvh->nodes[0].aabb;
+  for(int i=0; i<3; ++i) {
+    entry.min.v[i] = (float)aabb.min.v[i] * (1.0f / 64.0f) + entry.inst->pos.v[i];
+    entry.max.v[i] = (float)aabb.max.v[i] * (1.0f / 64.0f) + entry.inst->pos.v[i];
+  }
+}
+
+void Coll::Scene::meshGridInsert(uint16_t idx) {
+  auto &entry = meshes[idx];
+  entry.cellMin[0] = getMeshCell(entry.min.v[0]);
+  entry.cellMin[1] = getMeshCell(entry.min.v[2]);
+  entry.cellMax[0] = getMeshCell(entry.max.v[0]);
+  entry.cellMax[1] = getMeshCell(entry.max.v[2]);
+  entry.large = (entry.cellMax[0] - entry.cellMin[0]) >= MESH_GRID_MAX_SPAN
+             || (entry.cellMax[1] - entry.cellMin[1]) >= MESH_GRID_MAX_SPAN;
+
+  if(entry.large) {
+    meshesLarge.push_back(idx);
+    return;
+  }
+
+  for(int z=entry.cellMin[1]; z<=entry.cellMax[1]; ++z) {
+    for(int x=entry.cellMin[0]; x<=entry.cellMax[0]; ++x) {
+      meshGrid[getMeshBucket(x, z)].push_back(idx);
+    }
+  }
+}
 
-  int steps = (int)(len2 * 0.8f);
-  if(steps <= 0)steps = 1;
-  if(steps > 10)steps = 10;
+void Coll::Scene::meshGridRemove(uint16_t idx) {
+  auto removeFrom = [idx](std::vector<uint16_t> &list) {
+    for(auto &i : list) {
+      if(i == idx) {
+        i = list.back();
+        list.pop_back();
+        return;
+      }
+    }
+  };
 
-  auto velocityStep = velocity * (deltaTime / steps);
+  auto &entry = meshes[idx];
+  if(entry.large)return removeFrom(meshesLarge);
+
+  for(int z=entry.cellMin[1]; z<=entry.cellMax[1]; ++z) {
+    for(int x=entry.cellMin[0]; x<=entry.cellMax[0]; ++x) {
+      removeFrom(meshGrid[getMeshBucket(x, z)]);
+    }
+  }
+}
+
+void Coll::Scene::registerMesh(MeshInstance *mesh) {
+  for(auto &entry : meshes) {
+    if(entry.inst == mesh)return;
+  }
+  auto idx = (uint16_t)meshes.size();
+  meshes.push_back({.inst = mesh});
+  meshRefitBounds(meshes[idx]);
+  meshGridInsert(idx);
+}
+
+void Coll::Scene::unregisterMesh(MeshInstance *mesh) {
+  for(uint32_t i=0; i<meshes.size(); ++i) {
+    if(meshes[i].inst != mesh)continue;
+
+    // swap-remove, the last entry changes its index so it has to re-enter the grid
+    auto last = (uint16_t)(meshes.size() - 1);
+    meshGridRemove(i);
+    if(i != last) {
+      meshGridRemove(last);
+      meshes[i] = meshes[last];
+      meshGridInsert(i);
+    }
+    meshes.pop_back();
+    return;
+  }
+}
+
+void Coll::Scene::updateMesh(MeshInstance *mesh) {
+  for(uint32_t i=0; i<meshes.size(); ++i) {
+    auto &entry = meshes[i];
+    if(entry.inst != mesh)continue;
+
+    // the grid still holds the old cells until 'meshGridInsert', so removing after the refit is fine
+    meshRefitBounds(entry);
+    bool sameCells = !entry.large
+      && entry.cellMin[0] == getMeshCell(entry.min.v[0])
+      && entry.cellMin[1] == getMeshCell(entry.min.v[2])
+      && entry.cellMax[0] == getMeshCell(entry.max.v[0])
+      && entry.cellMax[1] == getMeshCell(entry.max.v[2]);
+
+    if(!sameCells) {
+      meshGridRemove(i);
+      meshGridInsert(i);
+    }
+    return;
+  }
+}
+
+Coll::CollInfo Coll::Scene::vsSphere(Coll::Sphere &sphere, const T3DVec3 &velocity, float deltaTime) {
+  uint64_t ticksStart = get_ticks();
+  auto move = velocity * deltaTime;
 
   Coll::CollInfo res{
     .hitPos = T3DVec3{0.0f, 0.0f, 0.0f},
@@ -34,61 +168,101 @@ Coll::CollInfo Coll::Scene::vsSphere(Coll::Sphere &sphere, const T3DVec3 &veloci
     .normal = T3DVec3{0.0f, 0.0f, 0.0f},
     .collCount = 0,
   };
-  Coll::BVHResult bvhRes{};
 
-  for(int s=0; s<steps; ++s)
+  // Gather all triangles the sphere could touch during the whole move once...
+  // Sliding only ever shortens the remaining move, so the path stays within |move| of the start in any direction.
+  // Gathering that whole box means the slide iterations can't leave the area the candidates came from.
+  sweepCandidates.clear();
+  float reach = t3d_vec3_len(&move);
+  T3DVec3 reachVec{{reach, reach, reach}};
+  T3DVec3 sweepMin, sweepMax;
+  for(int i=0; i<3; ++i) {
+    sweepMin.v[i] = sphere.center.v[i] - reach - sphere.radius;
+    sweepMax.v[i] = sphere.center.v[i] + reach + sphere.radius;
+  }
+
+  forEachMesh(sweepMin, sweepMax, [&](MeshInstance *meshInst)
   {
-    sphere.center = sphere.center + velocityStep;
+    auto &mesh = *meshInst->mesh;
+    auto centerLocal = sphere.center - meshInst->pos;
 
-    for(auto meshInst : meshes)
-    {
-      auto &mesh = *meshInst->mesh;
+    auto ticksBvhStart = get_ticks();
+    bvhRes.reset();
+    mesh.bvh->vsAABB(getSweptAABB(centerLocal - reachVec, centerLocal + reachVec, sphere.radius), bvhRes);
+    ticksBVH += get_ticks() - ticksBvhStart;
 
-      auto sphereLocal = sphere;
-      sphereLocal.center = sphereLocal.center - meshInst->pos;
-
-      auto ticksBvhStart = get_ticks();
-      bvhRes.reset();
-      mesh.bvh->vsSphere(sphereLocal, bvhRes);
-      ticksBVH += get_ticks() - ticksBvhStart;
-      if(bvhRes.count >= Coll::MAX_RESULT_COUNT-1) {
-        //debugf("BVH count: %d\n", bvhRes.count);
-      }
-
-      for(int b=0; b<bvhRes.count; ++b) {
-        uint32_t t = bvhRes.triIndex[b];
+    for(uint32_t t : bvhRes.triIndex) {
 
-        int idxA = mesh.indices[t*3];
-        int idxB = mesh.indices[t*3+1];
-        int idxC = mesh.indices[t*3+2];
-        auto &norm = mesh.normals[t];
+      int idxA = mesh.indices[t*3];
+      int idxB = mesh.indices[t*3+1];
+      int idxC = mesh.indices[t*3+2];
+      auto &norm = mesh.normals[t];
 
-        Triangle tri{
+      sweepCandidates.push_back({
+        .tri = {
           .normal = {{
            (float)norm.v[0] * (1.0f / 32767.0f),
            (float)norm.v[1] * (1.0f / 32767.0f),
            (float)norm.v[2] * (1.0f / 32767.0f)
           }},
           .v = {&mesh.verts[idxA], &mesh.verts[idxB], &mesh.verts[idxC]}
-        };
+        },
+        .inst = meshInst
+      });
+    }
+  });
 
-        auto collInfo = mesh.vsSphere(sphereLocal, tri);
-        if(collInfo.collCount)
-        {
-          float penLen2 = t3d_vec3_len2(&collInfo.penetration);
-          if(penLen2 < MIN_PENETRATION)continue;
+  // ...then move to the earliest face hit and slide along it
+  for(int i=0; i<MAX_SLIDE_ITERATIONS; ++i)
+  {
+    float toi = 1.0f;
+    const SweepCandidate *hit = nullptr;
+
+    for(auto &cand : sweepCandidates) {
+      auto sphereLocal = sphere;
+      sphereLocal.center = sphereLocal.center - cand.inst->pos;
+      if(cand.inst->mesh->sweepSphere(sphereLocal, move, cand.tri, toi)) {
+        hit = &cand;
+      }
+    }
 
-          ++res.collCount;
-          res.penetration = res.penetration + collInfo.penetration;
-          res.hitPos = collInfo.hitPos + meshInst->pos;
-          res.normal = collInfo.normal;
+    if(!hit) {
+      sphere.center = sphere.center + move;
+      break;
+    }
 
-          //DebugDraw::drawPoint(collInfo.hitPos, RGBA32(0xFF, 0x00, 0x00, 0xFF));
-          sphere.center = sphere.center - collInfo.penetration;
-        }
-      } // BVH res
-    } // meshes
-  } // steps
+    toi = fmaxf(toi - SWEEP_TOI_SKIN, 0.0f);
+    sphere.center = sphere.center + move * toi;
+
+    ++res.collCount;
+    res.normal = hit->tri.normal;
+    res.hitPos = sphere.center - hit->tri.normal * sphere.radius;
+
+    move = move * (1.0f - toi);
+    move = move - hit->tri.normal * t3d_vec3_dot(move, hit->tri.normal);
+  }
+
+  // Resolve remaining penetrations (edges, resting contacts)
+  for(auto &cand : sweepCandidates)
+  {
+    auto sphereLocal = sphere;
+    sphereLocal.center = sphereLocal.center - cand.inst->pos;
+
+    auto collInfo = cand.inst->mesh->vsSphere(sphereLocal, cand.tri);
+    if(collInfo.collCount)
+    {
+      float penLen2 = t3d_vec3_len2(&collInfo.penetration);
+      if(penLen2 < MIN_PENETRATION)continue;
+
+      ++res.collCount;
+      res.penetration = res.penetration + collInfo.penetration;
+      res.hitPos = collInfo.hitPos + cand.inst->pos;
+      res.normal = collInfo.normal;
+
+      //DebugDraw::drawPoint(collInfo.hitPos, RGBA32(0xFF, 0x00, 0x00, 0xFF));
+      sphere.center = sphere.center - collInfo.penetration;
+    }
+  }
 
   ticks += get_ticks() - ticksStart;
   return res;
@@ -135,53 +309,124 @@ void Coll::Scene::update(float deltaTime)
         }
       }
     }
+  }
+
+  updateDynamic();
+}
+
+void Coll::Scene::updateDynamic()
+{
+  // Bin all active spheres into the hash, one entry per covered cell...
+  dynEntries.clear();
+  for(auto sphere : spheres) {
+    if(!sphere->mask)continue;
+
+    int minX = (int)floorf((sphere->center.v[0] - sphere->radius) * (1.0f / DYN_CELL_SIZE));
+    int minZ = (int)floorf((sphere->center.v[2] - sphere->radius) * (1.0f / DYN_CELL_SIZE));
+    int maxX = (int)floorf((sphere->center.v[0] + sphere->radius) * (1.0f / DYN_CELL_SIZE));
+    int maxZ = (int)floorf((sphere->center.v[2] + sphere->radius) * (1.0f / DYN_CELL_SIZE));
+
+    for(int z=minZ; z<=maxZ; ++z) {
+      for(int x=minX; x<=maxX; ++x) {
+        uint32_t hash = ((uint32_t)x * 73856093u) ^ ((uint32_t)z * 19349663u);
+        dynEntries.push_back({
+          .sphere = sphere,
+          .cell = {(int16_t)x, (int16_t)z},
+          .cellMin = {(int16_t)minX, (int16_t)minZ},
+          .bucket = (uint16_t)((hash % DYN_HASH_SIZE) * COLL_TYPE_COUNT + (uint32_t)sphere->type)
+        });
+      }
+    }
+  }
+
+  // ...and sort them by bucket + type so each pair of types in a cell is a pair of ranges
+  memset(dynBucketStart, 0, sizeof(dynBucketStart));
+  for(auto &e : dynEntries)++dynBucketStart[e.bucket+1];
+  for(uint32_t b=0; b<DYN_BUCKET_COUNT; ++b)dynBucketStart[b+1] += dynBucketStart[b];
+
+  dynSorted.resize(dynEntries.size());
+  {
+    uint16_t writePos[DYN_BUCKET_COUNT];
+    memcpy(writePos, dynBucketStart, sizeof(writePos));
+    for(auto &e : dynEntries)dynSorted[writePos[e.bucket]++] = e;
+  }
 
-    // Dynamic Colliders
-    for(uint32_t s2=s+1; s2<spheres.size(); ++s2)
+  for(uint32_t h=0; h<DYN_HASH_SIZE; ++h)
+  {
+    uint32_t base = h * COLL_TYPE_COUNT;
+    for(uint32_t typeA=0; typeA<COLL_TYPE_COUNT; ++typeA)
     {
-      if(!(sphere->mask & spheres[s2]->mask))continue;
-      // TODO: source & target mask instead of one mask
-      if(sphere->type == CollType::COIN && spheres[s2]->type == CollType::COIN)continue;
-
-      auto sphere2 = spheres[s2];
-      T3DVec3 dir = sphere->center - sphere2->center;
-      auto dist2 = t3d_vec3_len2(dir);
-      float radSum = sphere->radius + sphere2->radius;
-      radSum *= radSum;
-      if(dist2 < radSum)
+      uint32_t startA = dynBucketStart[base + typeA];
+      uint32_t endA = dynBucketStart[base + typeA + 1];
+      if(startA == endA)continue;
+
+      for(uint32_t typeB=typeA; typeB<COLL_TYPE_COUNT; ++typeB)
       {
-        bool solidA = sphere->interactType & InteractType::SPHERES;
-        bool solidB = sphere2->interactType & InteractType::SPHERES;
-        if(solidA && solidB)
+        if(!(TYPE_TARGETS[typeA] & (1 << typeB)))continue;
+        uint32_t endB = dynBucketStart[base + typeB + 1];
+
+        for(uint32_t a=startA; a<endA; ++a)
         {
-          if(dist2 > 0.0001f) {
-            dir /= sqrtf(dist2);
-          } else {
-            dir = T3DVec3{0.0f, 1.0f, 0.0f};
+          auto &entryA = dynSorted[a];
+          uint32_t startB = typeA == typeB ? (a+1) : dynBucketStart[base + typeB];
+          for(uint32_t b=startB; b<endB; ++b)
+          {
+            auto &entryB = dynSorted[b];
+            // different cells can share a bucket, and a pair sharing multiple cells
+            // is only handled in the first cell both of them cover
+            if(entryA.cell[0] != entryB.cell[0] || entryA.cell[1] != entryB.cell[1])continue;
+            if(entryA.cell[0] != std::max(entryA.cellMin[0], entryB.cellMin[0]))continue;
+            if(entryA.cell[1] != std::max(entryA.cellMin[1], entryB.cellMin[1]))continue;
+
+            resolveSpherePair(*entryA.sphere, *entryB.sphere);
           }
-          float pen = radSum - dist2;
+        }
+      }
+    }
+  }
+}
 
-          bool isFixedA = sphere->interactType & InteractType::FIXED_Y;
-          bool isFixedB = sphere2->interactType & InteractType::FIXED_Y;
+void Coll::Scene::resolveSpherePair(Sphere &sphere, Sphere &sphere2)
+{
+  // callbacks may have removed or disabled one of them earlier in this tick
+  if(sphere.sceneIdx < 0 || sphere2.sceneIdx < 0)return;
+  if(!(sphere.mask & sphere2.mask))return;
+
+  T3DVec3 dir = sphere.center - sphere2.center;
+  auto dist2 = t3d_vec3_len2(dir);
+  float radSum = sphere.radius + sphere2.radius;
+  radSum *= radSum;
+  if(dist2 >= radSum)return;
+
+  bool solidA = sphere.interactType & InteractType::SPHERES;
+  bool solidB = sphere2.interactType & InteractType::SPHERES;
+  if(solidA && solidB)
+  {
+    if(dist2 > 0.0001f) {
+      dir /= sqrtf(dist2);
+    } else {
+      dir = T3DVec3{0.0f, 1.0f, 0.0f};
+    }
+    float pen = radSum - dist2;
 
-          if(isFixedA || isFixedB) {
-            dir.v[1] = 0.0f;
-          }
+    bool isFixedA = sphere.interactType & InteractType::FIXED_Y;
+    bool isFixedB = sphere2.interactType & InteractType::FIXED_Y;
 
-          // get interp factor based on mass (in this case mass=radius)
-          float interp = sphere->radius / (sphere->radius + sphere2->radius);
-          sphere->center = sphere->center + dir * (pen * (1.0f - interp));
-          sphere2->center = sphere2->center - dir * (pen * interp);
+    if(isFixedA || isFixedB) {
+      dir.v[1] = 0.0f;
+    }
 
-          sphere->hitTriTypes |= TriType::SPHERE;
-          sphere2->hitTriTypes |= TriType::SPHERE;
-        }
+    // get interp factor based on mass (in this case mass=radius)
+    float interp = sphere.radius / (sphere.radius + sphere2.radius);
+    sphere.center = sphere.center + dir * (pen * (1.0f - interp));
+    sphere2.center = sphere2.center - dir * (pen * interp);
 
-        if(sphere->callback)sphere->callback(*sphere2);
-        if(sphere2->callback)sphere2->callback(*sphere);
-      }
-    }
+    sphere.hitTriTypes |= TriType::SPHERE;
+    sphere2.hitTriTypes |= TriType::SPHERE;
   }
+
+  if(sphere.callback)sphere.callback(sphere2);
+  if(sphere2.callback)sphere2.callback(sphere);
 }
 
 Coll::CollInfo Coll::Scene::raycastFloor(const T3DVec3 &pos) {
@@ -193,7 +438,11 @@ Coll::CollInfo Coll::Scene::raycastFloor(const T3DVec3 &pos) {
     .collCount = 0,
   };
 
-  for(auto meshInst : meshes)
+  // the floor ray is infinite along Y, only XZ restricts the instances
+  T3DVec3 rayMin{{pos.v[0], -INFINITY, pos.v[2]}};
+  T3DVec3 rayMax{{pos.v[0], INFINITY, pos.v[2]}};
+
+  forEachMesh(rayMin, rayMax, [&](MeshInstance *meshInst)
   {
     auto &mesh = *meshInst->mesh;
     auto posLocal = pos - meshInst->pos;
@@ -205,11 +454,11 @@ Coll::CollInfo Coll::Scene::raycastFloor(const T3DVec3 &pos) {
       }
     };
 
-    Coll::BVHResult bvhRes{};
+    bvhRes.reset();
     mesh.bvh->raycastFloor(posInt, bvhRes);
 
     float highestFloor = -99999.0f;
-    for(int b=0; b<bvhRes.count; ++b)
+    for(uint32_t b=0; b<bvhRes.count(); ++b)
     {
     //for(uint32_t b=0; b<mesh.triCount; ++b) {
       uint32_t t = bvhRes.triIndex[b];
@@ -239,7 +488,7 @@ Coll::CollInfo Coll::Scene::raycastFloor(const T3DVec3 &pos) {
         highestFloor = collInfo.hitPos.v[1];
       }
     }
-  }
+  });
 
   if (res.collCount) {
     for(uint32_t v=0; v<VOID_SPHERE_COUNT; ++v) {
@@ -259,15 +508,15 @@ Coll::CollInfo Coll::Scene::raycastFloor(const T3DVec3 &pos) {
 void Coll::Scene::debugDraw(bool showMesh, bool showSpheres)
 {
   if(showMesh) {
-    for(const auto &meshInst : meshes) {
-      auto &mesh = *meshInst->mesh;
+    for(const auto &entry : meshes) {
+      auto &mesh = *entry.inst->mesh;
       for(uint32_t t=0; t<mesh.triCount; ++t) {
         int idxA = mesh.indices[t*3];
         int idxB = mesh.indices[t*3+1];
         int idxC = mesh.indices[t*3+2];
-        auto v0 = (mesh.verts[idxA] + meshInst->pos) * 16.0f;
-        auto v1 = (mesh.verts[idxB] + meshInst->pos) * 16.0f;
-        auto v2 = (mesh.verts[idxC] + meshInst->pos) * 16.0f;
+        auto v0 = (mesh.verts[idxA] + entry.inst->pos) * 16.0f;
+        auto v1 = (mesh.verts[idxB] + entry.inst->pos) * 16.0f;
+        auto v2 = (mesh.verts[idxC] + entry.inst->pos) * 16.0f;
 
         if(mesh.normals[t].v[2] < 0)continue;
         auto color = isFloor(mesh.normals[t])
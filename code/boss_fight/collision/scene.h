@@ -6,8 +6,8 @@
 
 #include "mesh.h"
 #include "shapes.h"
-#include <set>
 #include <vector>
+#include <algorithm>
 
 namespace Coll
  {
@@ -15,31 +15,118 @@ namespace Coll
     private:
       constexpr static uint32_t VOID_SPHERE_COUNT = 2;
 
-      std::set<MeshInstance*> meshes{};
+      // Coarse XZ grid over mesh instances, wraps around so the world size doesn't matter
+      constexpr static int MESH_GRID_SIZE = 16;
+      constexpr static float MESH_CELL_SIZE = 16.0f;
+      // instances covering more cells than this (e.g. the map) are always tested by their bounds
+      constexpr static int MESH_GRID_MAX_SPAN = 4;
+
+      struct MeshEntry {
+        T3DVec3 min{};
+        T3DVec3 max{};
+        MeshInstance *inst{};
+        int16_t cellMin[2]{};
+        int16_t cellMax[2]{};
+        bool large{false};
+        uint32_t queryId{0};
+      };
+
+      std::vector<MeshEntry> meshes{};
+      std::vector<uint16_t> meshGrid[MESH_GRID_SIZE * MESH_GRID_SIZE]{};
+      std::vector<uint16_t> meshesLarge{};
+      uint32_t meshQueryId{0};
+
       std::vector<Sphere*> spheres{};
       Sphere voidSpheres[VOID_SPHERE_COUNT]{};
 
+      // Per-tick spatial hash for sphere-vs-sphere checks, buckets are further split by CollType
+      constexpr static int DYN_HASH_SIZE = 128;
+      constexpr static float DYN_CELL_SIZE = 2.0f;
+      constexpr static uint32_t DYN_BUCKET_COUNT = DYN_HASH_SIZE * COLL_TYPE_COUNT;
+
+      struct DynEntry {
+        Sphere *sphere{};
+        int16_t cell[2]{};
+        int16_t cellMin[2]{}; // first cell the sphere covers, used to only test a pair once
+        uint16_t bucket{};
+      };
+
+      std::vector<DynEntry> dynEntries{};
+      std::vector<DynEntry> dynSorted{};
+      uint16_t dynBucketStart[DYN_BUCKET_COUNT + 1]{};
+
+      void updateDynamic();
+      void resolveSpherePair(Sphere &sphere, Sphere &sphere2);
+
+      void meshGridInsert(uint16_t idx);
+      void meshGridRemove(uint16_t idx);
+      void meshRefitBounds(MeshEntry &entry);
+
+      /**
+       * Calls 'fn' for each mesh instance whose world bounds overlap min/max.
+       * Each instance is visited at most once, even if it covers multiple cells.
+       */
+      template<typename F>
+      void forEachMesh(const T3DVec3 &min, const T3DVec3 &max, F &&fn) {
+        ++meshQueryId;
+        auto visit = [&](uint16_t idx) {
+          auto &entry = meshes[idx];
+          if(entry.queryId == meshQueryId)return;
+          entry.queryId = meshQueryId;
+          if(entry.max.v[0] < min.v[0] || entry.min.v[0] > max.v[0])return;
+          if(entry.max.v[1] < min.v[1] || entry.min.v[1] > max.v[1])return;
+          if(entry.max.v[2] < min.v[2] || entry.min.v[2] > max.v[2])return;
+          fn(entry.inst);
+        };
+
+        for(auto idx : meshesLarge)visit(idx);
+
+        int cellMinX = getMeshCell(min.v[0]);
+        int cellMinZ = getMeshCell(min.v[2]);
+        int cellMaxX = std::min(getMeshCell(max.v[0]), cellMinX + MESH_GRID_SIZE - 1);
+        int cellMaxZ = std::min(getMeshCell(max.v[2]), cellMinZ + MESH_GRID_SIZE - 1);
+        for(int z=cellMinZ; z<=cellMaxZ; ++z) {
+          for(int x=cellMinX; x<=cellMaxX; ++x) {
+            for(auto idx : meshGrid[getMeshBucket(x, z)])visit(idx);
+          }
+        }
+      }
+
+      static int getMeshCell(float pos) {
+        return (int)floorf(pos * (1.0f / MESH_CELL_SIZE));
+      }
+
+      static int getMeshBucket(int x, int z) {
+        return (z & (MESH_GRID_SIZE-1)) * MESH_GRID_SIZE + (x & (MESH_GRID_SIZE-1));
+      }
+
     public:
       uint64_t ticks{0};
       uint64_t ticksBVH{0};
       uint64_t raycastCount{0};
 
-      void registerMesh(MeshInstance *mesh) {
-        meshes.insert(mesh);
-      }
+      void registerMesh(MeshInstance *mesh);
+      void unregisterMesh(MeshInstance *mesh);
 
-      void unregisterMesh(MeshInstance *mesh) {
-        meshes.erase(mesh);
-      }
+      /**
+       * Updates the world bounds of an already registered instance after it moved.
+       * Only touches the grid if the covered cells changed.
+       */
+      void updateMesh(MeshInstance *mesh);
 
       void registerSphere(Sphere *sphere) {
+        if(sphere->sceneIdx >= 0)return;
+        sphere->sceneIdx = (int16_t)spheres.size();
         spheres.push_back(sphere);
       }
 
       void unregisterSphere(Sphere *sphere) {
-        for(auto it = spheres.begin(); it != spheres.end(); ++it) {
-          if(*it == sphere)return (void)spheres.erase(it);
-        }
+        if(sphere->sceneIdx < 0)return;
+        auto last = spheres.back();
+        last->sceneIdx = sphere->sceneIdx;
+        spheres[sphere->sceneIdx] = last;
+        spheres.pop_back();
+        sphere->sceneIdx = -1;
       }
 
       void setVoidSphere(uint32_t idx, const T3DVec3 &pos, float radius) {
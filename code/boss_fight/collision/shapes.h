@@ -34,6 +34,7 @@ namespace Coll
     COIN_MULTI = 5,
     DESTRUCTABLE = 6,
   };
+  constexpr uint32_t COLL_TYPE_COUNT = 7;
 
   struct IVec3 {
     int16_t v[3]{};
@@ -59,6 +60,7 @@ namespace Coll
     uint8_t interactType{0};
     uint8_t hitTriTypes{0}; // mask of triangle types the sphere last collided with
     CollType type{};
+    int16_t sceneIdx{-1}; // index in the scene it is registered in, managed by the scene
 
     Sphere operator*(float scale) const {
       return {
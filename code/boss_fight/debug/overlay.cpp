@@ -84,8 +84,8 @@ void Debug::Overlay::draw(Scene &scene, int triCount, float deltaTime) {
   }*/
 
   if(actorDebug) {
-    for(const auto actor : scene.getActors()) {
-      actor->drawDebug();
+    for(auto pool : scene.getActorPools()) {
+      pool->drawDebug();
     }
   }
 
@@ -117,6 +117,17 @@ void Debug::Overlay::draw(Scene &scene, int triCount, float deltaTime) {
   posX = Debug::printf(posX, posY, "T:%d", triCount) + 8;
   Debug::printf(posX, posY, "H:%d", heap_stats.used / 1024);
 
+  // Actor update time per type
+  if(actorDebug) {
+    posX = SCREEN_WIDTH - 88;
+    posY = 38;
+    for(auto pool : scene.getActorPools()) {
+      if(pool->count() == 0)continue;
+      Debug::printf(posX, posY, "%s %3d %.2f", pool->name, pool->count(), (double)TICKS_TO_US(pool->ticksUpdate) / 1000.0);
+      posY += 8;
+    }
+  }
+
   posX = 24;
 
   // Player Pos / Velocity)
@@ -148,6 +159,7 @@ void Debug::Overlay::draw(Scene &scene, int triCount, float deltaTime) {
     bool isActive = audioMask & (1 << i);
     posX = Debug::printf(posX, posY, isActive ? "%d" : "-", i);
   }
+  Debug::printf(posX + 8, posY, "V:%lu/%lu", (unsigned long)scene.getAudio().getRealVoiceCount(), (unsigned long)scene.getAudio().getVoiceCount());
 
   posX = 24;
   posY = 16;
@@ -10,15 +10,16 @@ namespace
   constexpr float SCALE_Y = 4.0f;
   constexpr float OFFSET_Y = 15.0f;
   constexpr T3DVec3 MAT_SCALE{1.0f, 1.0f / SCALE_Y, 1.0f};
+
+  // world size of a cell, so that positions relative to its center fit into int8
+  constexpr float CELL_SIZE_XZ = 254.0f;
+  constexpr float CELL_SIZE_Y = CELL_SIZE_XZ / SCALE_Y;
+  constexpr float BOUNDS_PAD = 12.0f;
 }
 
 PTSprites::PTSprites(const char* spritePath, bool isRotating)
 {
   sprite = sprite_load(spritePath);
-  for(auto &s : systems) {
-    s.count = 0;
-    s.pos = {-999,0,0}; // forces matrix creation for 0,0,0
-  }
 
   rspq_block_begin();
   {
@@ -54,49 +55,90 @@ PTSprites::PTSprites(const char* spritePath, bool isRotating)
 }
 
 PTSprites::~PTSprites() {
+  rspq_wait();
+  for(auto chunk : chunks)delete chunk;
+  for(auto chunk : freeChunks)delete chunk;
   rspq_block_free(setupDPL);
   sprite_free(sprite);
 }
 
-PTSystem *PTSprites::getBySection(float sectionX) {
-  // find existing that is not full...
-  for(auto &s : systems) {
-    if(s.pos.x == sectionX && !s.isFull())return &s;
+PTSprites::Chunk *PTSprites::getByCell(int16_t cellX, int16_t cellY, int16_t cellZ) {
+  // consecutive adds (bursts) almost always land in the same cell...
+  if(lastChunk && !lastChunk->system.isFull()
+    && lastChunk->cell[0] == cellX && lastChunk->cell[1] == cellY && lastChunk->cell[2] == cellZ)
+  {
+    return lastChunk;
   }
-  // ...or allocate new one + matrix creation
-  for(auto &s : systems) {
-    if(s.count == 0) {
-      s.pos = {sectionX,OFFSET_Y,0};
-      t3d_mat4fp_from_srt_euler(s.mat, MAT_SCALE, {0,0,0}, s.pos);
-      return &s;
+
+  // ...otherwise find an existing one that is not full...
+  for(auto chunk : chunks) {
+    if(!chunk->system.isFull()
+      && chunk->cell[0] == cellX && chunk->cell[1] == cellY && chunk->cell[2] == cellZ)
+    {
+      return lastChunk = chunk;
     }
   }
-  return nullptr;
-}
 
-void PTSprites::add(const T3DVec3 &pos, uint32_t seed, color_t col, float scale)
-{
-  float sectionX = fm_floorf((pos.x + 127.0f) / 256.0f);
-  sectionX *= 256.0f;
+  // ...or recycle/allocate a new one + matrix creation
+  Chunk *chunk;
+  if(freeChunks.empty()) {
+    chunk = new Chunk();
+  } else {
+    chunk = freeChunks.back();
+    freeChunks.pop_back();
+  }
 
-  PTSystem *sys = getBySection(sectionX);
-  if(!sys) {
-    debugf("No space for coins! %.2f\n", sectionX);
-    return;
+  chunk->cell[0] = cellX;
+  chunk->cell[1] = cellY;
+  chunk->cell[2] = cellZ;
+  for(int i=0; i<3; ++i) {
+    chunk->boundsMin[i] = 127;
+    chunk->boundsMax[i] = -128;
   }
 
-  float posY = (pos.y - OFFSET_Y) * SCALE_Y;
-  if(posY < -127.0f || posY > 127.0f) {
-    return;
+  auto &sys = chunk->system;
+  sys.count = 0;
+  sys.pos = {cellX * CELL_SIZE_XZ, cellY * CELL_SIZE_Y + OFFSET_Y, cellZ * CELL_SIZE_XZ};
+  t3d_mat4fp_from_srt_euler(sys.mat, MAT_SCALE, {0,0,0}, sys.pos);
+
+  chunks.push_back(chunk);
+  return lastChunk = chunk;
+}
+
+void PTSprites::releaseEmpty() {
+  for(uint32_t i=0; i<chunks.size();) {
+    if(chunks[i]->system.count == 0) {
+      if(chunks[i] == lastChunk)lastChunk = nullptr;
+      freeChunks.push_back(chunks[i]);
+      chunks[i] = chunks.back();
+      chunks.pop_back();
+    } else {
+      ++i;
+    }
   }
+}
+
+void PTSprites::add(const T3DVec3 &pos, uint32_t seed, color_t col, float scale)
+{
+  auto cellX = (int16_t)fm_floorf(pos.x / CELL_SIZE_XZ + 0.5f);
+  auto cellY = (int16_t)fm_floorf((pos.y - OFFSET_Y) / CELL_SIZE_Y + 0.5f);
+  auto cellZ = (int16_t)fm_floorf(pos.z / CELL_SIZE_XZ + 0.5f);
+
+  Chunk *chunk = getByCell(cellX, cellY, cellZ);
+  PTSystem *sys = &chunk->system;
 
   seed = (seed * 23) >> 3;
   uint32_t offset = (seed * 23) % 7;
 
   auto p = tpx_buffer_get_pos(sys->particles, sys->count);
-  p[0] = (int8_t)(pos.x - sectionX);
-  p[1] = (int8_t)(posY);
-  p[2] = (int8_t)pos.z;
+  p[0] = (int8_t)(pos.x - sys->pos.x);
+  p[1] = (int8_t)((pos.y - sys->pos.y) * SCALE_Y);
+  p[2] = (int8_t)(pos.z - sys->pos.z);
+
+  for(int i=0; i<3; ++i) {
+    if(p[i] < chunk->boundsMin[i])chunk->boundsMin[i] = p[i];
+    if(p[i] > chunk->boundsMax[i])chunk->boundsMax[i] = p[i];
+  }
 
   *tpx_buffer_get_size(sys->particles, sys->count) = (int8_t)(scale * 120.0f);
 
@@ -117,7 +159,22 @@ void PTSprites::draw(float deltaTime) {
   rspq_block_run(setupDPL);
   tpx_state_set_tex_params(uvOffset * (1024/sprite->height), mirrorPt);
 
-  for(auto &system : systems) {
+  const auto &frustum = t3d_viewport_get()->viewFrustum;
+  for(auto chunk : chunks) {
+    auto &system = chunk->system;
+    if(system.count == 0)continue;
+
+    T3DVec3 aabbMin{
+      system.pos.x + chunk->boundsMin[0] - BOUNDS_PAD,
+      system.pos.y + chunk->boundsMin[1] / SCALE_Y - BOUNDS_PAD,
+      system.pos.z + chunk->boundsMin[2] - BOUNDS_PAD,
+    };
+    T3DVec3 aabbMax{
+      system.pos.x + chunk->boundsMax[0] + BOUNDS_PAD,
+      system.pos.y + chunk->boundsMax[1] / SCALE_Y + BOUNDS_PAD,
+      system.pos.z + chunk->boundsMax[2] + BOUNDS_PAD,
+    };
+    if(!t3d_frustum_vs_aabb(&frustum, &aabbMin, &aabbMax))continue;
 
     if(system.count % 2 != 0) {
       *tpx_buffer_get_size(system.particles, system.count) = 0;
@@ -128,9 +185,10 @@ void PTSprites::draw(float deltaTime) {
 }
 
 void PTSprites::clear() {
-  for(auto &system : systems) {
-    system.count = 0;
+  for(auto chunk : chunks) {
+    chunk->system.count = 0;
   }
+  releaseEmpty();
 }
 
 void PTSprites::simulateDust(float deltaTime)
@@ -139,8 +197,11 @@ void PTSprites::simulateDust(float deltaTime)
   bool isStep = simTimer > 0.75f;
   if(isStep)simTimer = 0;
 
-  for(auto &system : systems)
+  for(auto chunk : chunks)
   {
+    auto &system = chunk->system;
+    if(isStep && chunk->boundsMax[1] < 127)++chunk->boundsMax[1];
+
     for(uint32_t i=0; i<system.count; ++i) {
       auto pos = tpx_buffer_get_pos(system.particles, i);
       int8_t *size = tpx_buffer_get_size(system.particles, i);
@@ -161,4 +222,6 @@ void PTSprites::simulateDust(float deltaTime)
       }
     }
   }
+
+  releaseEmpty();
 }
\ No newline at end of file
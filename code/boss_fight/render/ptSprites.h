@@ -5,17 +5,30 @@
 #pragma once
 #include <t3d/t3d.h>
 #include <t3d/tpx.h>
+#include <vector>
 
 #include "ptSystem.h"
 
 class PTSprites
 {
   private:
-    PTSystem systems[4]{
-      PTSystem(128), PTSystem(128),
-      PTSystem(128), PTSystem(128),
+    static constexpr uint32_t CHUNK_SIZE = 128;
+
+    /**
+     * Fixed size particle buffer owning one 3D cell, a cell can have multiple chunks if it gets full.
+     * Bounds are kept in the local (int8) space of the chunk to cull it against the view frustum.
+     */
+    struct Chunk {
+      PTSystem system{CHUNK_SIZE};
+      int16_t cell[3]{};
+      int8_t boundsMin[3]{};
+      int8_t boundsMax[3]{};
     };
 
+    std::vector<Chunk*> chunks{};
+    std::vector<Chunk*> freeChunks{};
+    Chunk *lastChunk{};
+
     sprite_t *sprite{};
     rspq_block_t *setupDPL{};
     float animTimer = 0.0f;
@@ -23,7 +36,8 @@ class PTSprites
     uint16_t mirrorPt = 32;
     color_t color;
 
-    PTSystem* getBySection(float sectionX);
+    Chunk* getByCell(int16_t cellX, int16_t cellY, int16_t cellZ);
+    void releaseEmpty();
   public:
     explicit PTSprites(const char* spritePath, bool isRotating = false);
     ~PTSprites();
@@ -0,0 +1,177 @@
+/**
+* @copyright 2024 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <vector>
+#include <new>
+#include "base.h"
+
+namespace Actor
+{
+  /**
+   * Reference to an actor in one of the scene's pools.
+   * The generation is bumped whenever a slot is freed, so handles to
+   * deleted actors resolve to nullptr instead of a reused slot.
+   */
+  struct Handle {
+    uint16_t slot{0xFFFF};
+    uint8_t pool{0xFF};
+    uint8_t generation{0};
+
+    [[nodiscard]] bool isValid() const { return pool != 0xFF; }
+  };
+
+  /**
+   * Type-erased interface to a pool, called once per pool and frame,
+   * the actors themselves are only ever called through their concrete type.
+   */
+  class PoolBase
+  {
+    public:
+      const char* const name;
+      const uint32_t type;
+      uint8_t index{0xFF};
+      long ticksUpdate{0};
+
+      PoolBase(const char* name, uint32_t type) : name{name}, type{type} {}
+      virtual ~PoolBase() = default;
+
+      [[nodiscard]] virtual uint32_t count() const = 0;
+      [[nodiscard]] virtual Base* get(Handle handle) = 0;
+
+      virtual Handle spawn(Scene &scene, const T3DVec3 &pos, uint16_t param) = 0;
+      virtual uint32_t update(float deltaTime) = 0;
+      virtual void compact() = 0;
+      virtual void clear() = 0;
+
+      virtual void draw3D(float deltaTime) = 0;
+      virtual void drawPtx(float deltaTime) = 0;
+      virtual void draw2D(float deltaTime) = 0;
+      virtual void drawDebug() = 0;
+  };
+
+  /**
+   * Stores actors of one type in fixed chunks of CHUNK_SIZE slots.
+   * Actors never move once spawned (collision spheres and callbacks keep pointers into them),
+   * instead a dense list of live slots is compacted after each update.
+   */
+  template<typename T, uint32_t CHUNK_SIZE>
+  class Pool final : public PoolBase
+  {
+    private:
+      struct Chunk {
+        alignas(T) uint8_t data[sizeof(T) * CHUNK_SIZE];
+      };
+
+      std::vector<Chunk*> chunks{};
+      std::vector<uint8_t> generations{};
+      std::vector<uint16_t> freeSlots{};
+      std::vector<uint16_t> live{};
+
+      T* at(uint16_t slot) {
+        return reinterpret_cast<T*>(chunks[slot / CHUNK_SIZE]->data) + (slot % CHUNK_SIZE);
+      }
+
+      void addChunk() {
+        uint32_t firstSlot = chunks.size() * CHUNK_SIZE;
+        assertf(firstSlot + CHUNK_SIZE <= 0xFFFF, "Actor pool '%s' is full", name);
+
+        chunks.push_back(new Chunk);
+        generations.resize(firstSlot + CHUNK_SIZE, 0);
+        for(uint32_t i = CHUNK_SIZE; i > 0; --i) {
+          freeSlots.push_back(firstSlot + i - 1);
+        }
+      }
+
+    public:
+      Pool(const char* name, uint32_t type) : PoolBase(name, type) {}
+
+      ~Pool() final {
+        clear();
+        for(auto chunk : chunks)delete chunk;
+      }
+
+      [[nodiscard]] uint32_t count() const final { return live.size(); }
+
+      [[nodiscard]] Base* get(Handle handle) final {
+        if(handle.pool != index || handle.slot >= generations.size())return nullptr;
+        if(generations[handle.slot] != handle.generation)return nullptr;
+        T* actor = at(handle.slot);
+        return actor->deleteFlag ? nullptr : actor;
+      }
+
+      Handle spawn(Scene &scene, const T3DVec3 &pos, uint16_t param) final {
+        if(freeSlots.empty())addChunk();
+
+        uint16_t slot = freeSlots.back();
+        freeSlots.pop_back();
+
+        new(at(slot)) T(scene, pos, param);
+        live.push_back(slot);
+        return {slot, index, generations[slot]};
+      }
+
+      uint32_t update(float deltaTime) final {
+        uint32_t drawCount = 0;
+        // index based, 'live' may grow if an actor spawns something directly
+        for(uint32_t i = 0, n = live.size(); i < n; ++i) {
+          T* actor = at(live[i]);
+          actor->T::update(deltaTime);
+          if(actor->drawMask != 0)++drawCount;
+        }
+        return drawCount;
+      }
+
+      void compact() final {
+        uint32_t liveIdx = 0;
+        for(auto slot : live) {
+          T* actor = at(slot);
+          if(actor->deleteFlag) {
+            actor->~T();
+            ++generations[slot];
+            freeSlots.push_back(slot);
+          } else {
+            live[liveIdx++] = slot;
+          }
+        }
+        live.resize(liveIdx);
+      }
+
+      void clear() final {
+        for(auto slot : live) {
+          at(slot)->~T();
+          ++generations[slot];
+          freeSlots.push_back(slot);
+        }
+        live.clear();
+      }
+
+      void draw3D(float deltaTime) final {
+        for(auto slot : live) {
+          T* actor = at(slot);
+          if(actor->drawMask & DRAW_MASK_3D)actor->T::draw3D(deltaTime);
+        }
+      }
+
+      void drawPtx(float deltaTime) final {
+        for(auto slot : live) {
+          T* actor = at(slot);
+          if(actor->drawMask & DRAW_MASK_PTX)actor->T::drawPtx(deltaTime);
+        }
+      }
+
+      void draw2D(float deltaTime) final {
+        for(auto slot : live) {
+          T* actor = at(slot);
+          if(actor->drawMask & DRAW_MASK_2D)actor->T::draw2D(deltaTime);
+        }
+      }
+
+      void drawDebug() final {
+        for(auto slot : live) {
+          at(slot)->T::drawDebug();
+        }
+      }
+  };
+}
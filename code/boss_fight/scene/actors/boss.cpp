@@ -78,8 +78,8 @@ void Actor::Boss::onCollision(Coll::Sphere &sphere, int index) {
       auto midPoint = (cl.center + sphere.center) * 0.5f;
       scene.requestSpawnActor("Part"_u32, midPoint, 0);
 
-      scene.getAudio().playSFX("BoxHit"_u64, cl.center, {.volume = 0.8f, .variation = 64});
-      scene.getAudio().playSFX("SwordHit"_u64, cl.center, {.volume = 0.9f, .variation = 64});
+      scene.getAudio().playSFX("BoxHit"_u64, cl.center, {.volume = 0.8f, .variation = 64, .priority = SfxPrio::EVENT});
+      scene.getAudio().playSFX("SwordHit"_u64, cl.center, {.volume = 0.9f, .variation = 64, .priority = SfxPrio::EVENT});
 
       int coinCount = 2 + (rand() % 2);
       for(int i=0; i<coinCount; ++i) {
@@ -182,8 +182,8 @@ void Actor::Boss::update(float deltaTime) {
           scene.requestSpawnActor("Coin"_u32, collider[p].center, 1);
         }
 
-        scene.getAudio().playSFX("BoxHit"_u64, {.volume = 0.8f});
-        scene.getAudio().playSFX("PotBreak"_u64, {.volume = 0.8f});
+        scene.getAudio().playSFX("BoxHit"_u64, {.volume = 0.8f, .priority = SfxPrio::EVENT});
+        scene.getAudio().playSFX("PotBreak"_u64, {.volume = 0.8f, .priority = SfxPrio::EVENT});
       }
     }
 
@@ -81,7 +81,7 @@ void Actor::Box::onCollision(Coll::Sphere &sphere) {
       scene.getPTSwirl().add(midPoint + Math::randDir3D()*4.0f, 32, 0.7f);
     }
 
-    scene.getAudio().playSFX("BoxHit"_u64, coll.center, {.volume = 0.9f, .variation = 64});
+    scene.getAudio().playSFX("BoxHit"_u64, coll.center, {.volume = 0.9f, .variation = 64, .priority = SfxPrio::ACTION});
   }
 }
 
@@ -93,7 +93,7 @@ void Actor::Box::makeDynamic() {
 
 void Actor::Box::breakBox() {
   if(deleteFlag)return;
-  scene.getAudio().playSFX("BoxBreak"_u64, coll.center, {.volume = 0.8f});
+  scene.getAudio().playSFX("BoxBreak"_u64, coll.center, {.volume = 0.8f, .priority = SfxPrio::ACTION});
   scene.getCollScene().unregisterSphere(&coll);
 
   int coinAmount = 3 + (rand() % 3);
@@ -60,7 +60,7 @@ void Actor::Can::onCollision(Coll::Sphere &sphere)
 
   if(spinTimer > 0)return;
 
-  scene.getAudio().playSFX("SwordHit"_u64, {.volume = 0.8f});
+  scene.getAudio().playSFX("SwordHit"_u64, {.volume = 0.8f, .priority = SfxPrio::ACTION});
   int coinAmount = 5 + (rand() % 3);
   for(int i=0; i<coinAmount; ++i) {
     scene.requestSpawnActor("Coin"_u32, sphere.center, 1);
@@ -57,7 +57,7 @@ void Actor::Coin::onCollision(Coll::Sphere &sphere) {
 
   auto midPoint = (coll.center + sphere.center) * 0.5f;
   scene.requestSpawnActor("Part"_u32, midPoint, isSpecial() ? 1 : 0);
-  scene.getAudio().playSFX("CoinGet"_u64, {.volume = 0.4f, .variation = 32});
+  scene.getAudio().playSFX("CoinGet"_u64, {.volume = 0.4f, .variation = 32, .priority = SfxPrio::ACTION});
   //scene.getAudio().playSFX("CoinGet"_u64, coll.center, {.volume = 0.6f, .variation = 32});
 }
 
@@ -112,7 +112,7 @@ void Actor::Coin::update(float deltaTime)
     if(hitFxTimeout > 0)hitFxTimeout = 0;
     if(hitFxTimeout == 0 && coll.hitTriTypes & Coll::TriType::FLOOR && fabsf(coll.velocity.y) > 0.5f) {
       hitFxTimeout = 4;
-      scene.getAudio().playSFX("CoinHit"_u64, coll.center, {.volume = 0.1f, .variation = 64});
+      scene.getAudio().playSFX("CoinHit"_u64, coll.center, {.volume = 0.1f, .variation = 64, .priority = SfxPrio::AMBIENT});
     }
 
     if(timer > 0) {
@@ -9,6 +9,9 @@
 namespace
 {
   constexpr float GRASS_FX_TIME = 0.4f;
+  constexpr int CELL_SHIFT = 4; // 16 units in local (int8) space
+  constexpr int CUT_RADIUS_SQ = 56;
+  constexpr int CUT_RADIUS = 8; // ceil(sqrt(CUT_RADIUS_SQ))
   sprite_t *sprite = nullptr;
   uint32_t refCount = 0;
   uint8_t grassFxTCooldown = 0;
@@ -76,7 +79,9 @@ Actor::Grass::Grass(Scene &scene, const T3DVec3 &pos, uint16_t param)
 
   ptSystem.count = generateGrass(ptSystem.particles, ptSystem.countMax, rand(), param);
   //debugf("Generated %ld particles\n", ptSystem.count);
-  spawnThreshold = ptSystem.count - 100;
+  buildCells();
+  bladeCount = ptSystem.count;
+  spawnThreshold = bladeCount - 100;
 
   for(auto &fx : ptFX) {
     fx.timer = 0.0f;
@@ -109,6 +114,105 @@ Actor::Grass::~Grass()
   }
 }
 
+void Actor::Grass::buildCells()
+{
+  struct Blade {
+    int8_t pos[3];
+    int8_t size;
+    uint32_t color;
+    uint16_t cell;
+  };
+
+  uint32_t count = ptSystem.count;
+  std::vector<Blade> blades(count);
+
+  int minX = 127, maxX = -128;
+  int minZ = 127, maxZ = -128;
+  for(uint32_t i=0; i<count; ++i) {
+    auto &b = blades[i];
+    auto ptPos = tpx_buffer_get_pos(ptSystem.particles, i);
+    b.pos[0] = ptPos[0]; b.pos[1] = ptPos[1]; b.pos[2] = ptPos[2];
+    b.size = *tpx_buffer_get_size(ptSystem.particles, i);
+    b.color = *(uint32_t*)tpx_buffer_get_rgba(ptSystem.particles, i);
+
+    minX = std::min(minX, (int)b.pos[0]); maxX = std::max(maxX, (int)b.pos[0]);
+    minZ = std::min(minZ, (int)b.pos[2]); maxZ = std::max(maxZ, (int)b.pos[2]);
+  }
+  if(count == 0)minX = maxX = minZ = maxZ = 0;
+
+  cellMinX = minX;
+  cellMinZ = minZ;
+  cellCols = ((maxX - minX) >> CELL_SHIFT) + 1;
+  cellRows = ((maxZ - minZ) >> CELL_SHIFT) + 1;
+
+  uint32_t cellTotal = cellCols * cellRows;
+  cellStart.assign(cellTotal + 1, 0);
+  cellCount.assign(cellTotal, 0);
+
+  // counting sort by cell, blades keep their generation order inside a cell
+  for(auto &b : blades) {
+    b.cell = ((b.pos[2] - minZ) >> CELL_SHIFT) * cellCols + ((b.pos[0] - minX) >> CELL_SHIFT);
+    ++cellStart[b.cell + 1];
+  }
+  for(uint32_t c=0; c<cellTotal; ++c) {
+    cellCount[c] = cellStart[c + 1];
+    cellStart[c + 1] += cellStart[c];
+  }
+
+  std::vector<uint16_t> fill{cellStart.begin(), cellStart.end() - 1};
+  for(auto &b : blades) {
+    uint32_t idx = fill[b.cell]++;
+    auto ptPos = tpx_buffer_get_pos(ptSystem.particles, idx);
+    ptPos[0] = b.pos[0]; ptPos[1] = b.pos[1]; ptPos[2] = b.pos[2];
+    *tpx_buffer_get_size(ptSystem.particles, idx) = b.size;
+    *(uint32_t*)tpx_buffer_get_rgba(ptSystem.particles, idx) = b.color;
+  }
+}
+
+uint32_t Actor::Grass::cutCells(int localPosX, int localPosZ)
+{
+  int colMin = std::max((localPosX - CUT_RADIUS - cellMinX) >> CELL_SHIFT, 0);
+  int colMax = std::min((localPosX + CUT_RADIUS - cellMinX) >> CELL_SHIFT, cellCols - 1);
+  int rowMin = std::max((localPosZ - CUT_RADIUS - cellMinZ) >> CELL_SHIFT, 0);
+  int rowMax = std::min((localPosZ + CUT_RADIUS - cellMinZ) >> CELL_SHIFT, cellRows - 1);
+
+  uint32_t removed = 0;
+  for(int row=rowMin; row<=rowMax; ++row) {
+    for(int col=colMin; col<=colMax; ++col) {
+      uint32_t cell = row * cellCols + col;
+      uint32_t start = cellStart[cell];
+      uint32_t count = cellCount[cell];
+
+      // swap-remove inside the cell, only advance if the blade was kept
+      for(uint32_t i=0; i<count;) {
+        auto ptPos = tpx_buffer_get_pos(ptSystem.particles, start + i);
+        int diffX = ptPos[0] - localPosX;
+        int diffZ = ptPos[2] - localPosZ;
+        if((diffX*diffX + diffZ*diffZ) < CUT_RADIUS_SQ) {
+          --count;
+          tpx_buffer_copy(ptSystem.particles, start + i, start + count);
+          *tpx_buffer_get_size(ptSystem.particles, start + count) = 0;
+        } else {
+          ++i;
+        }
+      }
+
+      removed += cellCount[cell] - count;
+      cellCount[cell] = count;
+    }
+  }
+
+  if(removed) {
+    bladeCount -= removed;
+    // stop drawing empty cells at the end of the buffer
+    int lastCell = (int)cellCount.size() - 1;
+    while(lastCell >= 0 && cellCount[lastCell] == 0)--lastCell;
+    uint32_t end = lastCell < 0 ? 0 : (cellStart[lastCell] + cellCount[lastCell]);
+    ptSystem.count = (end + 1) & ~1;
+  }
+  return removed;
+}
+
 void Actor::Grass::updateFX(float deltaTime) {
   for(auto &fx : ptFX) {
     if(fx.timer > 0.0f) {
@@ -151,24 +255,15 @@ void Actor::Grass::update(float deltaTime)
       int localPosX = (playerPos.x - coll.center.x) * COLL_WORLD_SCALE;
       int localPosZ = (playerPos.z - coll.center.z) * COLL_WORLD_SCALE;
 
-      uint32_t oldCount = ptSystem.count;
-      for(uint32_t i=0; i<ptSystem.count; ++i)
-      {
-        auto ptPos = tpx_buffer_get_pos(ptSystem.particles, i);
-        int diffX = ptPos[0] - localPosX;
-        int diffZ = ptPos[2] - localPosZ;
-        if((diffX*diffX + diffZ*diffZ) < 56) {
-          ptSystem.removeParticle(i);
-        }
-      }
+      uint32_t removed = cutCells(localPosX, localPosZ);
 
       fxCooldown -= deltaTime;
       if(grassFxTCooldown > 0)--grassFxTCooldown;
 
-      if(oldCount != ptSystem.count && fxCooldown <= 0.0f) {
+      if(removed != 0 && fxCooldown <= 0.0f) {
         hadCut = true;
         if(grassFxTCooldown == 0) {
-          scene.getAudio().playSFX("GrassCut"_u64, playerPos, {.volume = 0.5f, .variation = 64});
+          scene.getAudio().playSFX("GrassCut"_u64, playerPos, {.volume = 0.5f, .variation = 64, .priority = SfxPrio::AMBIENT});
           grassFxTCooldown = 10;
         }
 
@@ -183,15 +278,15 @@ void Actor::Grass::update(float deltaTime)
       }
     }
 
-    if(hadCut && (int)ptSystem.count < spawnThreshold) {
+    if(hadCut && (int)bladeCount < spawnThreshold) {
       uint32_t randCount = 2 + (rand() % 2);
       for(uint32_t i=0; i<randCount; ++i) {
         scene.requestSpawnActor("Coin"_u32, playerPos, 1);
       }
-      spawnThreshold = (int32_t)ptSystem.count - 75;
+      spawnThreshold = (int32_t)bladeCount - 75;
     }
 
-    if(hadCut && ptSystem.count < 5) {
+    if(hadCut && bladeCount < 5) {
       for(uint32_t i=0; i<25; ++i) {
         scene.requestSpawnActor("Coin"_u32, playerPos, 1);
       }
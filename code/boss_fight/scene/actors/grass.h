@@ -3,6 +3,8 @@
 * @license MIT
 */
 #pragma once
+#include <vector>
+#include <algorithm>
 #include "base.h"
 #include "../../collision/shapes.h"
 #include "../../render/ptSystem.h"
@@ -17,6 +19,18 @@ namespace Actor
       float fxCooldown{0.0f};
       int32_t spawnThreshold{};
 
+      // blades are sorted into XZ cells, each cell owns the slots [cellStart, cellStart+cellCount)
+      // and keeps its live blades at the front, cut blades leave a zero-sized slot at the end
+      std::vector<uint16_t> cellStart{};
+      std::vector<uint16_t> cellCount{};
+      int8_t cellMinX{};
+      int8_t cellMinZ{};
+      uint8_t cellCols{};
+      uint8_t cellRows{};
+      uint32_t bladeCount{};
+
+      void buildCells();
+      uint32_t cutCells(int localPosX, int localPosZ);
       void updateFX(float deltaTime);
     public:
       Grass(Scene &scene, const T3DVec3 &pos, uint16_t param);
@@ -71,7 +71,7 @@ void Actor::Vase::onCollision(Coll::Sphere &sphere) {
     timer = 1.5f;
     scene.getCollScene().unregisterSphere(&coll);
 
-    scene.getAudio().playSFX("PotBreak"_u64, coll.center, {.volume = 0.9f, .variation = 32});
+    scene.getAudio().playSFX("PotBreak"_u64, coll.center, {.volume = 0.9f, .variation = 32, .priority = SfxPrio::ACTION});
 
     int coinAmount = 10 + (rand() % 15);
     for(int i=0; i<coinAmount; ++i) {
@@ -97,8 +97,8 @@ void Actor::Void::onCollision(Coll::Sphere &sphere) {
     isActive = true;
     growTimer = 0.0f;
 
-    scene.getAudio().playSFX("SwordHit"_u64, {.volume = 0.8f});
-    scene.getAudio().playSFX("VoidOn"_u64, {.volume = 1.0f, .variation = 64});
+    scene.getAudio().playSFX("SwordHit"_u64, {.volume = 0.8f, .priority = SfxPrio::EVENT});
+    scene.getAudio().playSFX("VoidOn"_u64, {.volume = 1.0f, .variation = 64, .priority = SfxPrio::EVENT});
   }
 }
 
@@ -141,7 +141,7 @@ void Actor::Void::update(float deltaTime)
           scene.requestSpawnActor("Coin"_u32, coll.center, 1);
         }
 
-        scene.getAudio().playSFX("VoidOff"_u64, {.volume = 1.0f, .variation = 32});
+        scene.getAudio().playSFX("VoidOff"_u64, {.volume = 1.0f, .variation = 32, .priority = SfxPrio::EVENT});
         coll.velocity = {};
         coll.center = basePos;
         scene.getCollScene().registerSphere(&coll);
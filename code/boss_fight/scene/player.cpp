@@ -159,7 +159,7 @@ void Player::respawn() {
   collider.center = scene.getClosesRespawn(basePos) + T3DVec3{{0, 0.025f, 0}};
   collider.velocity = {0,0,0};
   hurt();
-  scene.getAudio().playSFX("Notice"_u64, collider.center, {.volume = 0.6f, .variation = 64});
+  scene.getAudio().playSFX("Notice"_u64, collider.center, {.volume = 0.6f, .variation = 64, .priority = SfxPrio::EVENT});
   ticks = get_ticks() - ticks;
   ++respawnCounter;
 }
@@ -187,7 +187,7 @@ void Player::update(const InputState &input, float deltaTime)
   alertTimer.update(deltaTime);
 
   if(touchedFloor && timeInAir > 0.1f) {
-    scene.getAudio().playSFX("PlImpact"_u64, collider.center, {.volume = 0.1f, .variation = 100});
+    scene.getAudio().playSFX("PlImpact"_u64, collider.center, {.volume = 0.1f, .variation = 100, .priority = SfxPrio::AMBIENT});
 
   }
   timeInAir = touchedFloor ? 0.0f : timeInAir + deltaTime;
@@ -217,7 +217,7 @@ void Player::update(const InputState &input, float deltaTime)
       collider.velocity.y = 0.1f;
     }
 
-    scene.getAudio().playSFX("PlSpin"_u64, collider.center, {.volume = 0.65f});
+    scene.getAudio().playSFX("PlSpin"_u64, collider.center, {.volume = 0.65f, .priority = SfxPrio::ACTION});
   }
 
   float moveSpeed = isAttacking()
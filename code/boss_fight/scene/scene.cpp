@@ -67,6 +67,20 @@ Scene::Scene()
   needsDetach = false;
   followPlayer = false;
 
+  actorPools = {
+    new Actor::Pool<Actor::Coin, 32>{"Coin", "Coin"_u32},
+    new Actor::Pool<Actor::Grass, 8>{"Grss", "Grss"_u32},
+    new Actor::Pool<Actor::Boss, 1>{"Boss", "Boss"_u32},
+    new Actor::Pool<Actor::Particles, 16>{"Part", "Part"_u32},
+    new Actor::Pool<Actor::Vase, 8>{"Vase", "Vase"_u32},
+    new Actor::Pool<Actor::Box, 8>{"WBox", "WBox"_u32},
+    new Actor::Pool<Actor::Void, 4>{"Void", "Void"_u32},
+    new Actor::Pool<Actor::Can, 8>{"TCan", "TCan"_u32},
+  };
+  for(uint32_t i=0; i<actorPools.size(); ++i) {
+    actorPools[i]->index = i;
+  }
+
   Debug::init();
   Shadows::init();
 
@@ -90,9 +104,9 @@ Scene::Scene()
 }
 
 Scene::~Scene() {
-  for(auto actor : actors) {
-    delete actor;
-  }
+  // actors unregister from the collision scene, clear all pools before deleting any
+  for(auto pool : actorPools)pool->clear();
+  for(auto pool : actorPools)delete pool;
 
   free(collMesh);
   Shadows::destroy();
@@ -120,20 +134,12 @@ const T3DVec3& Scene::getClosesRespawn(const T3DVec3 &pos) const {
   return *closest;
 }
 
-void Scene::spawnActor(uint32_t type, const T3DVec3 &pos, uint16_t param) {
-  switch(type) {
-    case "Coin"_u32: actors.push_back(new Actor::Coin(*this, pos, param)); break;
-    case "Grss"_u32: actors.push_back(new Actor::Grass(*this, pos, param)); break;
-    case "Boss"_u32: actors.push_back(new Actor::Boss(*this, pos, param)); break;
-    case "Part"_u32: actors.push_back(new Actor::Particles(*this, pos, param)); break;
-    case "Vase"_u32: actors.push_back(new Actor::Vase(*this, pos, param)); break;
-    case "WBox"_u32: actors.push_back(new Actor::Box(*this, pos, param)); break;
-    case "Void"_u32: actors.push_back(new Actor::Void(*this, pos, param)); break;
-    case "TCan"_u32: actors.push_back(new Actor::Can(*this, pos, param)); break;
-    default:
-      debugf("Unknown actor %08lX pos=%f,%f,%f param=%d\n", type, pos.x, pos.y, pos.z, param);
-    break;
+Actor::Handle Scene::spawnActor(uint32_t type, const T3DVec3 &pos, uint16_t param) {
+  for(auto pool : actorPools) {
+    if(pool->type == type)return pool->spawn(*this, pos, param);
   }
+  debugf("Unknown actor %08lX pos=%f,%f,%f param=%d\n", type, pos.x, pos.y, pos.z, param);
+  return {};
 }
 
 void Scene::updateVisibility()
@@ -272,23 +278,20 @@ void Scene::updateGame(float deltaTime)
     actorSpawnReqs.clear();
   }
 
-  activeActorCount = actors.size();
+  activeActorCount = 0;
   drawActorCount = 0;
 
-  for(auto & actor : actors) {
-    actor->update(deltaTime);
-    if(actor->drawMask != 0)++drawActorCount;
+  for(auto pool : actorPools) {
+    pool->ticksUpdate = get_ticks();
+    activeActorCount += pool->count();
+    drawActorCount += pool->update(deltaTime);
+    pool->ticksUpdate = get_ticks() - pool->ticksUpdate;
   }
 
-  uint32_t actorIdx = 0;
-  for(auto & actor : actors) {
-    if(actor->deleteFlag) {
-      delete actor;
-    } else {
-      actors[actorIdx++] = actor;
-    }
+  // deletes requested during the update are applied in one pass before collision
+  for(auto pool : actorPools) {
+    pool->compact();
   }
-  actors.resize(actorIdx);
 
   ticksActorUpdate = get_ticks() - ticksActorUpdate;
   collScene.update(deltaTime);
@@ -346,10 +349,8 @@ void Scene::draw(float deltaTime)
   }
 
   t3dState = t3d_model_state_create();
-  for(auto actor : actors) {
-    if(actor->drawMask & Actor::DRAW_MASK_3D) {
-      actor->draw3D(deltaTime);
-    }
+  for(auto pool : actorPools) {
+    pool->draw3D(deltaTime);
   }
 
   t3d_state_set_vertex_fx(T3D_VERTEX_FX_NONE, 0, 0);
@@ -371,10 +372,8 @@ void Scene::draw(float deltaTime)
   tpx_state_from_t3d();
   tpx_state_set_scale(0.5f, 0.5f);
 
-  for(auto actor : actors) {
-    if(actor->drawMask & Actor::DRAW_MASK_PTX) {
-      actor->drawPtx(deltaTime);
-    }
+  for(auto pool : actorPools) {
+    pool->drawPtx(deltaTime);
   }
 
   rdpq_sync_load();
@@ -410,10 +409,8 @@ void Scene::draw(float deltaTime)
   rdpq_mode_filter(FILTER_POINT);
   rdpq_mode_zbuf(false, false);
 
-  for(auto actor : actors) {
-    if(actor->drawMask & Actor::DRAW_MASK_2D) {
-      actor->draw2D(deltaTime);
-    }
+  for(auto pool : actorPools) {
+    pool->draw2D(deltaTime);
   }
 
   for(auto & player : players) {
@@ -12,6 +12,7 @@
 #include "../collision/navPoints.h"
 #include "playerAI.h"
 #include "actors/base.h"
+#include "actors/actorPool.h"
 #include "../render/skybox.h"
 #include "../render/ptSystem.h"
 #include "../render/ptSprites.h"
@@ -84,7 +85,8 @@ class Scene
     };
     uint32_t currMostCoins{0};
 
-    std::vector<Actor::Base*> actors{};
+    // one pool per actor type, see 'Scene::Scene' for the list
+    std::vector<Actor::PoolBase*> actorPools{};
 
     std::vector<T3DVec3> respawnPoints{};
     std::vector<ActorSpawnReq> actorSpawnReqs{};
@@ -118,7 +120,7 @@ class Scene
       for(auto & i : input)i = inputState;
     }
 
-    void spawnActor(uint32_t type, const T3DVec3 &pos, uint16_t param);
+    Actor::Handle spawnActor(uint32_t type, const T3DVec3 &pos, uint16_t param);
   public:
     T3DModelState t3dState{};
     uint32_t frameIdx{0};
@@ -158,7 +160,10 @@ class Scene
     AudioManager& getAudio() { return audioManager; }
 
     const Player &getPlayer(int index) const { return players[index]; }
-    const std::vector<Actor::Base*>& getActors() const { return actors; }
+    const std::vector<Actor::PoolBase*>& getActorPools() const { return actorPools; }
+    Actor::Base* getActor(Actor::Handle handle) const {
+      return handle.isValid() ? actorPools[handle.pool]->get(handle) : nullptr;
+    }
     Camera& getCamera() { return cam; }
 
     const T3DVec3& getClosesRespawn(const T3DVec3 &pos) const;
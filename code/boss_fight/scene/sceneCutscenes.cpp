@@ -35,7 +35,7 @@ void Scene::initCutscenes()
     .event([this]{
       followPlayer = true;
       fadeTimer = {.value = FADE_TIME_MAX, .target = 0.0f};
-      getAudio().playSFX("FadeIn"_u64, {.volume = 0.8f});
+      getAudio().playSFX("FadeIn"_u64, {.volume = 0.8f, .priority = SfxPrio::EVENT});
     })
     .wait(0.9f)
     .event([this]{ uiBarTimer.target = 1.0f; })
@@ -64,7 +64,7 @@ void Scene::initCutscenes()
     })
     .wait(0.2f)
     .event([this]{
-      getAudio().playSFX("Notice"_u64, {.volume = 0.5f});
+      getAudio().playSFX("Notice"_u64, {.volume = 0.5f, .priority = SfxPrio::EVENT});
       for(auto &p : players)p.setAlertIcon(true);
     })
     .wait(0.5f).event([this]{ input[0].jump = true; })
@@ -124,7 +124,7 @@ void Scene::initCutscenes()
       .wait(3.5f)
       .event([this]{
         fadeTimer = {.value = 0.0f, .target = FADE_TIME_MAX};
-        getAudio().playSFX("FadeOut"_u64, {.volume = 0.8f});
+        getAudio().playSFX("FadeOut"_u64, {.volume = 0.8f, .priority = SfxPrio::EVENT});
       })
       .wait(2.3f)
       .event([this]{ wantsExit = true; });
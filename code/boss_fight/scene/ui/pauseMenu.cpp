@@ -136,7 +136,7 @@ void PauseMenu::update(Scene &scene, float deltaTime)
   if(pressed.start) {
     isPaused = !isPaused;
     if(isPaused) {
-      scene.getAudio().playSFX("MenuOpen"_u64);
+      scene.getAudio().playSFX("MenuOpen"_u64, {.priority = SfxPrio::UI});
       scene.getAudio().setBGMVolume(0.4f);
       rspq_wait();
       backupFramebuffer(lastFB);
@@ -151,14 +151,14 @@ void PauseMenu::update(Scene &scene, float deltaTime)
   if(pressed.a) {
     if(currOption == 0)needsClose = true;
     if(currOption == 1) {
-      scene.getAudio().playSFX("UiOk"_u64, {.volume = 0.6f});
+      scene.getAudio().playSFX("UiOk"_u64, {.volume = 0.6f, .priority = SfxPrio::UI});
       scene.requestExit();
     }
   }
 
   if(needsClose) {
     isPaused = false;
-    scene.getAudio().playSFX("UiOk"_u64, {.volume = 0.4f});
+    scene.getAudio().playSFX("UiOk"_u64, {.volume = 0.4f, .priority = SfxPrio::UI});
     scene.getAudio().setBGMVolume(1.0f);
   }
 
@@ -171,7 +171,7 @@ void PauseMenu::update(Scene &scene, float deltaTime)
     lastDir = dir;
 
     if(dir != joypad_8way_t::JOYPAD_8WAY_NONE) {
-      scene.getAudio().playSFX("UiSelect"_u64, {.volume = 0.4f});
+      scene.getAudio().playSFX("UiSelect"_u64, {.volume = 0.4f, .priority = SfxPrio::UI});
     }
   }
 }
@@ -0,0 +1,117 @@
+// Moves a registered mesh instance around the collision scene and checks that floor rays
+// find it at its new position and no longer at its old one.
+// Covers small moves inside a grid cell, moves across cells and moves that wrap around the grid.
+
+#include <cstdio>
+#include <vector>
+
+#include "../../../collision/scene.h"
+#include "../../../collision/bvh.h"
+
+// the collision code only draws debug shapes through these
+namespace Debug {
+    void drawLine(const T3DVec3 &a, const T3DVec3 &b, color_t color) {}
+    void drawSphere(const T3DVec3 &center, float radius, color_t color) {}
+}
+
+// half the size of the floor quad, smaller than a grid cell
+constexpr float FloorHalfSize = 2.0f;
+// the grid wraps every 16 cells of 16 units
+constexpr float GridWrap = 256.0f;
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (!condition) {
+        printf("  failed: %s\n", what);
+        failures++;
+    }
+}
+
+// Flat quad at y=0 made of two triangles, laid out like a loaded .coll file with a single BVH leaf
+struct FloorMesh {
+    T3DVec3 verts[4] {
+        {{-FloorHalfSize, 0, -FloorHalfSize}}, {{FloorHalfSize, 0, -FloorHalfSize}},
+        {{FloorHalfSize, 0, FloorHalfSize}}, {{-FloorHalfSize, 0, FloorHalfSize}},
+    };
+    Coll::IVec3 normals[2] {{{0, 0x7FFF, 0}}, {{0, 0x7FFF, 0}}};
+    std::vector<int16_t> meshData;
+    std::vector<int16_t> bvhData;
+    Coll::Mesh *mesh;
+
+    FloorMesh() {
+        const int16_t indices[6] {0, 1, 2, 0, 2, 3};
+        meshData.resize((sizeof(Coll::Mesh) + sizeof(indices)) / sizeof(int16_t) + 8);
+        mesh = new (meshData.data()) Coll::Mesh {};
+        for (int i = 0; i < 6; i++) mesh->indices[i] = indices[i];
+
+        // header, one leaf node holding both triangles, then the triangle indices
+        bvhData.resize(2 + sizeof(Coll::BVHNode) / sizeof(int16_t) + 2);
+        auto *bvh = reinterpret_cast<Coll::BVH *>(bvhData.data());
+        bvh->nodeCount = 1;
+        bvh->dataCount = 2;
+        int16_t extent = (int16_t)(FloorHalfSize * 64.0f);
+        bvh->nodes[0].aabb = {.min = {{(int16_t)-extent, -64, (int16_t)-extent}}, .max = {{extent, 64, extent}}};
+        bvh->nodes[0].value = 2; // offset 0, 2 triangles
+        int16_t *data = reinterpret_cast<int16_t *>(&bvh->nodes[1]);
+        data[0] = 0;
+        data[1] = 1;
+
+        mesh->triCount = 2;
+        mesh->vertCount = 4;
+        mesh->collScale = 1.0f;
+        mesh->verts = verts;
+        mesh->normals = normals;
+        mesh->bvh = bvh;
+    }
+};
+
+// probes a little off the given point, points on the diagonal between the two triangles count as outside
+static bool hasFloor(Coll::Scene &scene, float x, float z) {
+    return scene.raycastFloor(T3DVec3 {{x + 0.3f, 10.0f, z - 0.6f}}).collCount > 0;
+}
+
+static void moveTo(Coll::Scene &scene, Coll::MeshInstance &inst, float x, float z) {
+    inst.pos = T3DVec3 {{x, 0.0f, z}};
+    scene.updateMesh(&inst);
+}
+
+int main() {
+    FloorMesh floor;
+    Coll::Scene scene;
+    Coll::MeshInstance inst {.mesh = floor.mesh};
+    scene.registerMesh(&inst);
+
+    check(hasFloor(scene, 0, 0), "a registered instance is found at its position");
+    check(!hasFloor(scene, 40, 40), "nothing is found away from the instance");
+
+    // stays in the same cells, only the bounds change
+    moveTo(scene, inst, 1.5f, 1.0f);
+    check(hasFloor(scene, 3.0f, 2.5f), "a small move extends the floor");
+    check(!hasFloor(scene, -1.0f, -1.5f), "a small move uncovers the old floor");
+
+    // crosses into other cells
+    moveTo(scene, inst, 40, 40);
+    check(hasFloor(scene, 40, 40), "the floor is found in the cells it moved to");
+    check(!hasFloor(scene, 0, 0), "the floor is gone from the cells it left");
+
+    // the same grid buckets, but a whole wrap further away
+    moveTo(scene, inst, 40 + GridWrap, 40);
+    check(hasFloor(scene, 40 + GridWrap, 40), "the floor is found after wrapping around the grid");
+    check(!hasFloor(scene, 40, 40), "a wrapped move doesn't leave the old floor behind");
+
+    // a second instance shares the buckets, moving the first one must not touch it
+    Coll::MeshInstance other {.mesh = floor.mesh, .pos = {{-30, 0, 20}}};
+    scene.registerMesh(&other);
+    moveTo(scene, inst, -30, 22);
+    moveTo(scene, inst, 70, -10);
+    check(hasFloor(scene, -30, 20), "moving an instance away keeps its neighbour in the grid");
+    check(hasFloor(scene, 70, -10), "the moved instance is found next to its neighbour");
+
+    scene.unregisterMesh(&other);
+    check(!hasFloor(scene, -30, 20), "an unregistered instance is gone");
+    check(hasFloor(scene, 70, -10), "the remaining instance is still found");
+
+    printf("mesh_grid_test: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
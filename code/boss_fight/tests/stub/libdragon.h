@@ -0,0 +1,20 @@
+// Minimal host stand-in for the libdragon API used by the tested sources
+#ifndef __TEST_STUB_LIBDRAGON_H__
+#define __TEST_STUB_LIBDRAGON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t r, g, b, a;
+} color_t;
+
+inline uint64_t get_ticks() { return 0; }
+
+#define assertf(expr, ...) do { if (!(expr)) { fprintf(stderr, __VA_ARGS__); abort(); } } while (0)
+#define debugf(...) fprintf(stderr, __VA_ARGS__)
+
+#endif
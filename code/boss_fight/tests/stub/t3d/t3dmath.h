@@ -0,0 +1,51 @@
+// Host stand-in for the tiny3d vector math used by the collision code
+#ifndef __TEST_STUB_T3DMATH_H__
+#define __TEST_STUB_T3DMATH_H__
+
+#include <math.h>
+#include "../libdragon.h"
+
+#define T3D_PI 3.1415926535897932384626433832795f
+
+typedef union {
+    struct { float x, y, z; };
+    float v[3];
+} T3DVec3;
+
+typedef union {
+    struct { float x, y, z, w; };
+    float v[4];
+} T3DQuat;
+
+inline float fm_sinf(float x) { return sinf(x); }
+
+inline T3DVec3 operator+(const T3DVec3 &a, const T3DVec3 &b) { return {{a.x + b.x, a.y + b.y, a.z + b.z}}; }
+inline T3DVec3 operator-(const T3DVec3 &a, const T3DVec3 &b) { return {{a.x - b.x, a.y - b.y, a.z - b.z}}; }
+inline T3DVec3 operator-(const T3DVec3 &a) { return {{-a.x, -a.y, -a.z}}; }
+inline T3DVec3 operator*(const T3DVec3 &a, float s) { return {{a.x * s, a.y * s, a.z * s}}; }
+inline T3DVec3 operator/(const T3DVec3 &a, float s) { return {{a.x / s, a.y / s, a.z / s}}; }
+inline T3DVec3 &operator+=(T3DVec3 &a, const T3DVec3 &b) { return a = a + b; }
+inline T3DVec3 &operator-=(T3DVec3 &a, const T3DVec3 &b) { return a = a - b; }
+inline T3DVec3 &operator*=(T3DVec3 &a, float s) { return a = a * s; }
+inline T3DVec3 &operator/=(T3DVec3 &a, float s) { return a = a / s; }
+
+inline float t3d_vec3_dot(const T3DVec3 *a, const T3DVec3 *b) { return a->x * b->x + a->y * b->y + a->z * b->z; }
+inline float t3d_vec3_dot(const T3DVec3 &a, const T3DVec3 &b) { return t3d_vec3_dot(&a, &b); }
+inline float t3d_vec3_len2(const T3DVec3 *a) { return t3d_vec3_dot(a, a); }
+inline float t3d_vec3_len2(const T3DVec3 &a) { return t3d_vec3_len2(&a); }
+inline float t3d_vec3_len(const T3DVec3 *a) { return sqrtf(t3d_vec3_len2(a)); }
+inline float t3d_vec3_len(const T3DVec3 &a) { return t3d_vec3_len(&a); }
+
+inline float t3d_vec3_distance2(const T3DVec3 *a, const T3DVec3 *b) {
+    T3DVec3 diff = *a - *b;
+    return t3d_vec3_len2(&diff);
+}
+inline float t3d_vec3_distance2(const T3DVec3 &a, const T3DVec3 &b) { return t3d_vec3_distance2(&a, &b); }
+
+inline void t3d_vec3_norm(T3DVec3 *a) {
+    float len = t3d_vec3_len(a);
+    if (len > 0.0f) *a = *a / len;
+}
+inline void t3d_vec3_norm(T3DVec3 &a) { t3d_vec3_norm(&a); }
+
+#endif
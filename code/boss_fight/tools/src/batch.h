@@ -0,0 +1,284 @@
+/**
+* @copyright 2024 - Max Bebök
+* @license MIT
+*/
+#pragma once
+
+#include "meshBVH.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Shared entry point for the gltf tools, either converts a single file:
+ *   tool <input.glb> <output>
+ * or every pair listed in a manifest (one "input output" per line, '#' starts a comment):
+ *   tool --batch <manifest> [-j threads] [--force]
+ *
+ * Batch mode converts files concurrently and skips outputs whose input, flags and tool didn't change,
+ * the hashes are kept in '<manifest>.stamps'.
+ */
+namespace Batch
+{
+  // bump this when the output format changes, so existing stamps no longer match
+  constexpr uint32_t FORMAT_VERSION = 1;
+
+  struct Stats {
+    double timeParse{};
+    double timeBuild{};
+    double timeBVH{};
+    double timeWrite{};
+    uint32_t vertCount{};
+    uint32_t indexCount{};
+    bool hasBVH{false};
+    BVHStats bvh{};
+  };
+
+  // Converts a single file, errors are thrown as exceptions
+  using ConvertFunc = void(*)(const char* inPath, const char* outPath, uint32_t bvhThreads, Stats &stats);
+
+  class Timer {
+    private:
+      std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    public:
+      double lap() {
+        auto now = std::chrono::steady_clock::now();
+        double res = std::chrono::duration<double, std::milli>(now - start).count();
+        start = now;
+        return res;
+      }
+  };
+
+  namespace Detail
+  {
+    struct Job {
+      std::string input{};
+      std::string output{};
+      std::string stamp{};
+      Stats stats{};
+      double timeTotal{};
+      bool skipped{false};
+      std::string error{};
+    };
+
+    // FNV-1a, only used to detect changes
+    inline uint64_t hashData(const char* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+    {
+      for(size_t i=0; i<size; ++i) {
+        hash ^= (uint8_t)data[i];
+        hash *= 0x100000001b3ull;
+      }
+      return hash;
+    }
+
+    /**
+     * Identifies the tool build, so rebuilding the tool invalidates every stamp.
+     * Uses size and modification time of the running executable instead of hashing it.
+     */
+    inline std::string toolStamp(const char* argv0, const char* toolName, const char* flags)
+    {
+      std::error_code err{};
+      std::filesystem::path exePath = std::filesystem::read_symlink("/proc/self/exe", err);
+      if(err)exePath = std::filesystem::absolute(argv0, err);
+
+      uint64_t exeSize = std::filesystem::file_size(exePath, err);
+      if(err)exeSize = 0;
+      auto exeTime = std::filesystem::last_write_time(exePath, err);
+      int64_t exeTicks = err ? 0 : (int64_t)exeTime.time_since_epoch().count();
+
+      std::ostringstream res{};
+      res << toolName << " " << flags << " v" << FORMAT_VERSION << " " << exeSize << " " << exeTicks;
+      return res.str();
+    }
+
+    inline std::string hashFile(const std::string &path, const std::string &tool)
+    {
+      uint64_t hash = hashData(tool.c_str(), tool.size() + 1);
+
+      std::ifstream file{path, std::ios::binary};
+      if(!file)throw std::runtime_error("File not found: " + path);
+      char buff[1 << 16];
+      while(file.read(buff, sizeof(buff)) || file.gcount() > 0) {
+        hash = hashData(buff, file.gcount(), hash);
+      }
+
+      char res[17];
+      snprintf(res, sizeof(res), "%016llx", (unsigned long long)hash);
+      return res;
+    }
+
+    inline std::vector<Job> readManifest(const std::string &path)
+    {
+      std::ifstream file{path};
+      if(!file)throw std::runtime_error("Manifest not found: " + path);
+
+      std::vector<Job> jobs{};
+      std::string line;
+      while(std::getline(file, line)) {
+        auto comment = line.find('#');
+        if(comment != std::string::npos)line.resize(comment);
+
+        std::istringstream ss{line};
+        Job job{};
+        if(!(ss >> job.input))continue;
+        if(!(ss >> job.output))throw std::runtime_error("Manifest line without output: " + line);
+        jobs.push_back(job);
+      }
+      return jobs;
+    }
+
+    inline std::map<std::string, std::string> readStamps(const std::string &path)
+    {
+      std::map<std::string, std::string> res{};
+      std::ifstream file{path};
+      std::string output, hash;
+      while(file >> hash >> output)res[output] = hash;
+      return res;
+    }
+
+    inline void printReport(const std::vector<Job> &jobs, double timeWall)
+    {
+      printf("%-6s %8s %8s %8s %8s %8s %6s %6s %6s %5s %4s  %s\n",
+        "", "total", "parse", "build", "bvh", "write", "tris", "nodes", "leaves", "depth", "leaf", "file"
+      );
+
+      double timeSum = 0;
+      uint32_t converted = 0, skipped = 0, failed = 0;
+      for(auto &job : jobs) {
+        const char* status = job.skipped ? "skip" : (job.error.empty() ? "ok" : "FAIL");
+        auto &s = job.stats;
+        timeSum += job.timeTotal;
+
+        if(job.skipped) {
+          ++skipped;
+          printf("%-6s %8s %8s %8s %8s %8s %6s %6s %6s %5s %4s  %s\n",
+            status, "-", "-", "-", "-", "-", "-", "-", "-", "-", "-", job.output.c_str());
+          continue;
+        }
+        if(!job.error.empty()) {
+          ++failed;
+          printf("%-6s %8.2f  %s: %s\n", status, job.timeTotal, job.output.c_str(), job.error.c_str());
+          continue;
+        }
+
+        ++converted;
+        printf("%-6s %8.2f %8.2f %8.2f %8.2f %8.2f %6u ",
+          status, job.timeTotal, s.timeParse, s.timeBuild, s.timeBVH, s.timeWrite, s.indexCount / 3);
+        if(s.hasBVH) {
+          printf("%6u %6u %5u %4u", s.bvh.nodeCount, s.bvh.leafCount, s.bvh.maxDepth, s.bvh.maxLeafPrims);
+        } else {
+          printf("%6s %6s %5s %4s", "-", "-", "-", "-");
+        }
+        printf("  %s\n", job.output.c_str());
+      }
+
+      printf("%u converted, %u unchanged, %u failed - %.2fms wall, %.2fms summed (times in ms)\n",
+        converted, skipped, failed, timeWall, timeSum);
+    }
+
+    inline int runBatch(int argc, char** argv, const char* toolName, const char* flags, ConvertFunc convert)
+    {
+      std::string manifestPath{};
+      uint32_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+      bool force = false;
+
+      for(int i=2; i<argc; ++i) {
+        if(strcmp(argv[i], "--force") == 0) {
+          force = true;
+        } else if(strcmp(argv[i], "-j") == 0 && i+1 < argc) {
+          threadCount = std::max(1, atoi(argv[++i]));
+        } else if(manifestPath.empty()) {
+          manifestPath = argv[i];
+        } else {
+          fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+          return 1;
+        }
+      }
+      if(manifestPath.empty()) {
+        fprintf(stderr, "Usage: %s --batch <manifest> [-j threads] [--force]\n", toolName);
+        return 1;
+      }
+
+      Timer timerWall{};
+      auto jobs = readManifest(manifestPath);
+      std::string stampPath = manifestPath + ".stamps";
+      auto stamps = readStamps(stampPath);
+      std::string tool = toolStamp(argv[0], toolName, flags);
+
+      // files are converted in parallel, the threads left over go to the BVH builds of each file
+      uint32_t fileThreads = std::min<uint32_t>(threadCount, std::max<size_t>(jobs.size(), 1));
+      uint32_t bvhThreads = std::max(1u, threadCount / fileThreads);
+
+      std::atomic<size_t> nextJob{0};
+      auto worker = [&]() {
+        for(size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+          auto &job = jobs[i];
+          Timer timer{};
+          try {
+            job.stamp = hashFile(job.input, tool);
+            auto oldStamp = stamps.find(job.output);
+            if(!force && oldStamp != stamps.end() && oldStamp->second == job.stamp
+              && std::filesystem::exists(job.output))
+            {
+              job.skipped = true;
+            } else {
+              convert(job.input.c_str(), job.output.c_str(), bvhThreads, job.stats);
+            }
+          } catch(const std::exception &e) {
+            job.error = e.what();
+          }
+          job.timeTotal = timer.lap();
+        }
+      };
+
+      std::vector<std::thread> threads{};
+      for(uint32_t t=1; t<fileThreads; ++t)threads.emplace_back(worker);
+      worker();
+      for(auto &t : threads)t.join();
+
+      // keep stamps of outputs not in this manifest, drop the ones that failed
+      for(auto &job : jobs) {
+        if(job.error.empty())stamps[job.output] = job.stamp;
+        else stamps.erase(job.output);
+      }
+      std::ofstream stampFile{stampPath};
+      for(auto &[output, hash] : stamps)stampFile << hash << " " << output << "\n";
+
+      printReport(jobs, timerWall.lap());
+
+      bool hasError = std::any_of(jobs.begin(), jobs.end(), [](const Job &job) { return !job.error.empty(); });
+      return hasError ? 1 : 0;
+    }
+  }
+
+  inline int run(int argc, char** argv, const char* toolName, const char* flags, ConvertFunc convert)
+  {
+    if(argc >= 2 && strcmp(argv[1], "--batch") == 0) {
+      return Detail::runBatch(argc, argv, toolName, flags, convert);
+    }
+
+    if(argc < 3) {
+      fprintf(stderr, "Usage: %s <input.glb> <output>\n", toolName);
+      fprintf(stderr, "       %s --batch <manifest> [-j threads] [--force]\n", toolName);
+      return 1;
+    }
+
+    Stats stats{};
+    convert(argv[1], argv[2], 0, stats);
+    if(stats.indexCount > 0) {
+      printf("Vert/Index count: %u %u\n", stats.vertCount, stats.indexCount);
+    }
+    return 0;
+  }
+}
@@ -15,16 +15,14 @@ namespace {
 #include "lib/cgltf.h"
 
 #include "binaryFile.h"
+#include "meshBVH.h"
+#include "batch.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <filesystem>
 
-std::vector<int16_t> createMeshBVH(
-  const std::vector<IVec3> &vertices,
-  const std::vector<uint16_t> &indices
-);
-
 namespace fs = std::filesystem;
 
 namespace {
@@ -61,12 +59,9 @@ namespace {
   }
 }
 
-int main(int argc, char** argv)
+static void convertColl(const char* gltfPath, const char* collPath, uint32_t bvhThreads, Batch::Stats &stats)
 {
-  const char* gltfPath = argv[1];
-  const char* collPath = argv[2];
-  fs::path gltfBasePath{argv[1]};
-  gltfBasePath = gltfBasePath.parent_path();
+  Batch::Timer timer{};
 
   cgltf_options options{};
   cgltf_data* data = nullptr;
@@ -75,11 +70,17 @@ int main(int argc, char** argv)
   if(result == cgltf_result_file_not_found) {
     throw std::runtime_error("File not found!");
   }
+  if(result != cgltf_result_success) {
+    throw std::runtime_error("Failed to parse glTF!");
+  }
+  std::unique_ptr<cgltf_data, decltype(&cgltf_free)> dataOwner{data, cgltf_free};
+
   if(cgltf_validate(data) != cgltf_result_success) {
     throw std::runtime_error("Invalid glTF data!");
   }
 
   cgltf_load_buffers(&options, data, gltfPath);
+  stats.timeParse = timer.lap();
 
   std::vector<Vec3> verticesFloat{};
   std::vector<IVec3> vertices{};
@@ -172,9 +173,13 @@ int main(int argc, char** argv)
 
   assert(indices.size() % 3 == 0);
 
-  printf("Vert/Index count: %d %d\n", vertices.size(), indices.size());
+  stats.vertCount = vertices.size();
+  stats.indexCount = indices.size();
+  stats.timeBuild = timer.lap();
 
-  auto bvh = createMeshBVH(vertices, indices);
+  auto bvh = createMeshBVH(vertices, indices, bvhThreads, &stats.bvh);
+  stats.hasBVH = true;
+  stats.timeBVH = timer.lap();
 
   BinaryFile file{};
   file.write<uint32_t>(indices.size() / 3);
@@ -201,6 +206,12 @@ int main(int argc, char** argv)
   file.align(4);
 
   file.writeToFile(collPath);
+  stats.timeWrite = timer.lap();
+}
+
+int main(int argc, char** argv)
+{
+  return Batch::run(argc, argv, "gltf_to_coll", "scale=64", convertColl);
 }
 
 #endif
\ No newline at end of file
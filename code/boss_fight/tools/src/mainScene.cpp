@@ -15,7 +15,9 @@ namespace {
 #include "lib/cgltf.h"
 
 #include "binaryFile.h"
+#include "batch.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -72,12 +74,9 @@ namespace {
   }
 }
 
-int main(int argc, char** argv)
+static void convertScene(const char* gltfPath, const char* scenePath, uint32_t bvhThreads, Batch::Stats &stats)
 {
-  const char* gltfPath = argv[1];
-  const char* scenePath = argv[2];
-  fs::path gltfBasePath{argv[1]};
-  gltfBasePath = gltfBasePath.parent_path();
+  Batch::Timer timer{};
 
   cgltf_options options{};
   cgltf_data* data = nullptr;
@@ -86,13 +85,20 @@ int main(int argc, char** argv)
   if(result == cgltf_result_file_not_found) {
     throw std::runtime_error("File not found!");
   }
+  if(result != cgltf_result_success) {
+    throw std::runtime_error("Failed to parse glTF!");
+  }
+  std::unique_ptr<cgltf_data, decltype(&cgltf_free)> dataOwner{data, cgltf_free};
+
   if(cgltf_validate(data) != cgltf_result_success) {
     throw std::runtime_error("Invalid glTF data!");
   }
 
   cgltf_load_buffers(&options, data, gltfPath);
+  stats.timeParse = timer.lap();
 
   auto actors = parseActors(data);
+  stats.timeBuild = timer.lap();
   BinaryFile sceneFile{};
   sceneFile.write<uint32_t>(actors.size());
 
@@ -103,6 +109,12 @@ int main(int argc, char** argv)
   }
 
   sceneFile.writeToFile(scenePath);
+  stats.timeWrite = timer.lap();
+}
+
+int main(int argc, char** argv)
+{
+  return Batch::run(argc, argv, "gltf_to_scene", "scale=64", convertScene);
 }
 
 #endif
\ No newline at end of file
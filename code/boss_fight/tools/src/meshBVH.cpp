@@ -4,7 +4,7 @@
 */
 #ifndef N64
 
-#include "vec.h"
+#include "meshBVH.h"
 #include "bvh/v2/bvh.h"
 #include "bvh/v2/vec.h"
 #include "bvh/v2/ray.h"
@@ -12,6 +12,7 @@
 #include "bvh/v2/default_builder.h"
 
 #include <vector>
+#include <stdexcept>
 
 using Scalar  = double;
 using BVec3   = bvh::v2::Vec<Scalar, 3>;
@@ -57,7 +58,7 @@ namespace
       int16_t packedVal = (int16_t)(indexDiff << 4);
       if((packedVal >> 4) != indexDiff) {
         printf("Error: indexDiff %d (%d - %d) does not fit in 12 bits\n", indexDiff, dataOffset, nodeIndex);
-        throw;
+        throw std::runtime_error("BVH node offset out of range!");
       }
       //assert((packedVal >> 4) == indexDiff);
       out.push_back(packedVal);
@@ -77,16 +78,25 @@ namespace
       out.push_back(prim_id);
     }
   }
+
+  void collectStats(const Bvh &bvh, size_t nodeIndex, uint32_t depth, BVHStats &stats) {
+    auto &node = bvh.nodes[nodeIndex];
+    stats.maxDepth = std::max(stats.maxDepth, depth);
+    if(node.is_leaf()) {
+      ++stats.leafCount;
+      stats.maxLeafPrims = std::max(stats.maxLeafPrims, (uint32_t)node.index.prim_count());
+      return;
+    }
+    collectStats(bvh, node.index.first_id(), depth + 1, stats);
+    collectStats(bvh, node.index.first_id() + 1, depth + 1, stats);
+  }
 }
 
-/**
- * Creates a BVH of all object AABBs
- * The result is a list of 16bit ints encoding both nodes, indices and AABB extends
- * @param modelChunks
- */
 std::vector<int16_t> createMeshBVH(
   const std::vector<IVec3> &vertices,
-  const std::vector<uint16_t> &indices
+  const std::vector<uint16_t> &indices,
+  uint32_t threadCount,
+  BVHStats *stats
 ) {
   std::vector<BBox> aabbs;
   std::vector<BVec3> centers;
@@ -104,11 +114,18 @@ std::vector<int16_t> createMeshBVH(
     centers.push_back(aabb.get_center());
   }
 
-  bvh::v2::ThreadPool thread_pool;
+  bvh::v2::ThreadPool thread_pool{threadCount};
   typename bvh::v2::DefaultBuilder<Node>::Config config;
   config.quality = bvh::v2::DefaultBuilder<Node>::Quality::High;
   auto bvh = bvh::v2::DefaultBuilder<Node>::build(thread_pool, aabbs, centers, config);
 
+  if(stats) {
+    *stats = {};
+    stats->nodeCount = bvh.nodes.size();
+    stats->primCount = bvh.prim_ids.size();
+    if(!bvh.nodes.empty())collectStats(bvh, 0, 1, *stats);
+  }
+
   std::vector<int16_t> treeData;
   writeBVH(treeData, bvh);
   return treeData;
@@ -0,0 +1,29 @@
+/**
+* @copyright 2024 - Max Bebök
+* @license MIT
+*/
+#pragma once
+
+#include "vec.h"
+#include <vector>
+
+struct BVHStats {
+  uint32_t nodeCount{};
+  uint32_t leafCount{};
+  uint32_t primCount{};
+  uint32_t maxDepth{};
+  uint32_t maxLeafPrims{};
+};
+
+/**
+ * Creates a BVH of all triangle AABBs
+ * The result is a list of 16bit ints encoding both nodes, indices and AABB extends
+ * @param threadCount threads used for the build, 0 uses all cores
+ * @param stats optional, filled with the shape of the tree
+ */
+std::vector<int16_t> createMeshBVH(
+  const std::vector<IVec3> &vertices,
+  const std::vector<uint16_t> &indices,
+  uint32_t threadCount = 0,
+  BVHStats *stats = nullptr
+);
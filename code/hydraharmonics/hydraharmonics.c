@@ -157,6 +157,12 @@ void minigame_loop(float deltatime)
 ==============================*/
 void minigame_cleanup()
 {
+	// Report how the note pool held up, to tune NOTES_POOL_SIZE
+	notes_pool_stats_t pool_stats = notes_get_pool_stats();
+	debugf("hydraharmonics: note pool %d/%d, high water %d, %d spawns dropped\n",
+		pool_stats.count, pool_stats.capacity, pool_stats.high_water, pool_stats.drops
+	);
+
 	// Free allocated memory
 	notes_clear();
 	hydra_clear();
@@ -16,6 +16,11 @@
 #define NOTE_SPARKLE_CHANCE 16
 #define NOTE_SPARKLE_MIN 8
 
+// Animations use 16-bit phases (0x10000 = one full turn) into a shared sine table
+#define NOTE_SINE_LUT_BITS 8
+#define NOTE_SINE_LUT_SIZE (1 << NOTE_SINE_LUT_BITS)
+#define NOTE_PHASE_TURN 65536.0f
+
 #define NOTE_PLAYER_MAX_RETRIES 4
 #define NOTE_CHANCE_DOUBLE 4
 #define NOTE_CHANCE_TRIPLE 2
@@ -25,6 +30,9 @@
 // Global vars
 static note_ll_t notes;
 static uint8_t sparkle_timer = 0;
+static uint32_t sparkle_seed = 1;
+static float note_sine_lut[NOTE_SINE_LUT_SIZE];
+static uint16_t note_phase_steps[NOTE_SPEED_COUNT][3];
 sprite_t* note_sprites[NOTES_TOTAL_COUNT];
 
 const float note_speeds[NOTE_SPEED_COUNT] = {
@@ -39,6 +47,24 @@ const float note_spawn[NOTE_SPEED_COUNT] = {
 	1.75,
 };
 
+static uint16_t note_phase_from_angle (float angle) {
+	float turns = angle / (2 * M_PI);
+	turns -= floorf(turns);
+	return (uint16_t)(turns * NOTE_PHASE_TURN);
+}
+
+static inline float note_sine (uint16_t phase) {
+	return note_sine_lut[phase >> (16 - NOTE_SINE_LUT_BITS)];
+}
+
+static inline uint32_t note_rand (void) {
+	// xorshift, the sparkles don't need anything better than this
+	sparkle_seed ^= sparkle_seed << 13;
+	sparkle_seed ^= sparkle_seed >> 17;
+	sparkle_seed ^= sparkle_seed << 5;
+	return sparkle_seed;
+}
+
 void notes_init(void) {
 	char temptext[64];
 	for (uint8_t i=0; i<NOTES_TOTAL_COUNT; i++) {
@@ -54,6 +80,25 @@ void notes_init(void) {
 	}
 	// Init notes
 	notes.start = notes.end = NULL;
+	notes.count = 0;
+	notes.high_water = 0;
+	notes.drops = 0;
+	notes.free = NULL;
+	for (int16_t i=NOTES_POOL_SIZE-1; i>=0; i--) {
+		notes.pool[i].next_free = notes.free;
+		notes.free = &notes.pool[i];
+	}
+
+	// Init the animation tables
+	for (uint16_t i=0; i<NOTE_SINE_LUT_SIZE; i++) {
+		note_sine_lut[i] = sinf(i * (2 * M_PI / NOTE_SINE_LUT_SIZE));
+	}
+	for (uint8_t i=0; i<NOTE_SPEED_COUNT; i++) {
+		note_phase_steps[i][0] = note_phase_from_angle(note_speeds[i] / NOTE_Y_OFFSET_PERIOD);
+		note_phase_steps[i][1] = note_phase_from_angle(note_speeds[i] / NOTE_THETA_PERIOD);
+		note_phase_steps[i][2] = note_phase_from_angle(note_speeds[i] / NOTE_SCALE_PERIOD);
+	}
+	sparkle_seed = rand() | 1;
 }
 
 notes_types_t note_get_random_type (PlyNum p) {
@@ -144,16 +189,28 @@ void notes_add_more (void) {
 }
 
 void notes_add (PlyNum player, notes_types_t type, hydraharmonics_state_t state) {
-	note_t* note = malloc(sizeof(note_t));
+	note_t* note = notes.free;
 	uint32_t random = rand();
-	if (note != NULL) {
-		// Rearrange the pointers
+	if (note == NULL) {
+		// The pool is full, the note stays in notes_left and gets picked again later
+		// Only the first drop is logged, the total is in the pool stats printed on cleanup
+		if (notes.drops++ == 0) {
+			debugf("hydraharmonics: note pool full (%d notes), dropping spawns\n", NOTES_POOL_SIZE);
+		}
+	} else {
+		// Take the note from the pool and rearrange the pointers
+		notes.free = note->next_free;
+		note->prev = notes.end;
 		if (notes.end == NULL) {
 			notes.start = note;
 		} else {
 			notes.end->next = note;
 		}
 		notes.end = note;
+		notes.count++;
+		if (notes.count > notes.high_water) {
+			notes.high_water = notes.count;
+		}
 
 		// Set the note's starting  values
 		note->player = player;
@@ -175,7 +232,12 @@ void notes_add (PlyNum player, notes_types_t type, hydraharmonics_state_t state)
 		};
 		note->scale = 0;
 		note->y_offset = 0;
+		note->phase_y_offset = note_phase_from_angle(note->x / NOTE_Y_OFFSET_PERIOD);
+		note->phase_theta = note_phase_from_angle((note->x - note->anim_offset) / NOTE_THETA_PERIOD);
+		note->phase_scale = note_phase_from_angle((note->x + note->anim_offset) / NOTE_SCALE_PERIOD);
+		note->active = true;
 		note->next = NULL;
+		note->next_free = NULL;
 
 		// Decrease the counters
 		if (type == NOTES_TYPE_STANDARD) {
@@ -236,27 +298,32 @@ note_t* notes_get_first(void) {
 
 void notes_move (void) {
 	note_t* current = notes.start;
+	const float speed = note_speeds[game_speed];
+	const uint16_t* steps = note_phase_steps[game_speed];
 	sparkle_timer++;
 	while (current != NULL) {
-		// Move and animate the note
-		current->x -= note_speeds[game_speed];
-		current->y_offset = sin(current->x / NOTE_Y_OFFSET_PERIOD) * NOTE_Y_OFFSET_AMPLITUDE;
-		current->blitparms.theta = sin((current->x - current->anim_offset) / NOTE_THETA_PERIOD) * NOTE_THETA_AMPLITUDE;
-		current->blitparms.scale_x = 1 + sin((current->x + current->anim_offset) / NOTE_SCALE_PERIOD) * NOTE_SCALE_AMPLITUDE;
-		current->blitparms.scale_y = 1 + sin((current->x + current->anim_offset) / NOTE_SCALE_PERIOD) * NOTE_SCALE_AMPLITUDE;
+		// Move and animate the note, the phases follow x so they step back by the same amount
+		current->x -= speed;
+		current->phase_y_offset -= steps[0];
+		current->phase_theta -= steps[1];
+		current->phase_scale -= steps[2];
+		current->y_offset = note_sine(current->phase_y_offset) * NOTE_Y_OFFSET_AMPLITUDE;
+		current->blitparms.theta = note_sine(current->phase_theta) * NOTE_THETA_AMPLITUDE;
+		current->blitparms.scale_x = 1 + note_sine(current->phase_scale) * NOTE_SCALE_AMPLITUDE;
+		current->blitparms.scale_y = current->blitparms.scale_x;
 		current->blitparms.s0 = (current->y_offset < -NOTE_ANIMATION_OFFSET_Y ? 2 : (current->y_offset > NOTE_ANIMATION_OFFSET_Y ? 0 : 1)) * NOTE_WIDTH;
 		// Randomly generate a sparkle
 		if (
 			(current->type == NOTES_TYPE_SWEET ||
 			sparkle_timer >= NOTE_SPARKLE_MIN )
 			&& current->type != NOTES_TYPE_SOUR
-			&& !(rand() % NOTE_SPARKLE_CHANCE)
+			&& !(note_rand() % NOTE_SPARKLE_CHANCE)
 		) {
 			effects_add(
 				current->player,
 				EFFECT_SPARKLE,
-				current->x - NOTE_WIDTH/4 + (rand()%NOTE_WIDTH/2),
-				current->y - NOTE_HEIGHT/4 + (rand()%NOTE_HEIGHT/2)
+				current->x - NOTE_WIDTH/4 + (note_rand()%NOTE_WIDTH/2),
+				current->y - NOTE_HEIGHT/4 + (note_rand()%NOTE_HEIGHT/2)
 			);
 			sparkle_timer = 0;
 		}
@@ -287,48 +354,51 @@ void notes_draw (void) {
 uint16_t notes_get_remaining (notes_remaining_t type) {
 	uint16_t remaining = 0;
 	uint8_t i;
-	note_t* current = notes.start;
 	// Get unspawned notes
 	for (i=0; i<NOTES_TOTAL_COUNT && (type & NOTES_GET_REMAINING_UNSPAWNED); i++) {
 		remaining += notes.notes_left[i].regular + notes.notes_left[i].special;
 	}
 	// Get spawned notes
-	while (current != NULL && (type & NOTES_GET_REMAINING_SPAWNED)) {
-		remaining++;
-		current = current->next;
+	if (type & NOTES_GET_REMAINING_SPAWNED) {
+		remaining += notes.count;
 	}
 	return remaining;
 }
 
 void notes_destroy (note_t* dead_note) {
-	note_t* current = notes.start;
-	note_t* prev = NULL;
-	while (current != NULL) {
-		if (current == dead_note) {
-			if (current == notes.start) {
-				notes.start = current->next;
-			}
-			if (current == notes.end) {
-				notes.end = prev;
-			}
-			if (prev) {
-				prev->next = current->next;
-			}
-			free(dead_note);
-			return;
-		}
-		prev = current;
-		current = current->next;
+	// Already back in the pool
+	if (!dead_note->active) {
+		return;
 	}
+	dead_note->active = false;
+	if (dead_note == notes.start) {
+		notes.start = dead_note->next;
+	} else {
+		dead_note->prev->next = dead_note->next;
+	}
+	if (dead_note == notes.end) {
+		notes.end = dead_note->prev;
+	} else {
+		dead_note->next->prev = dead_note->prev;
+	}
+	// Keep 'next' intact, the hit detection still steps over a note after destroying it
+	dead_note->next_free = notes.free;
+	notes.free = dead_note;
+	notes.count--;
+}
+
+notes_pool_stats_t notes_get_pool_stats (void) {
+	return (notes_pool_stats_t){
+		.count = notes.count,
+		.capacity = NOTES_POOL_SIZE,
+		.high_water = notes.high_water,
+		.drops = notes.drops,
+	};
 }
 
 void notes_destroy_all (void) {
-	note_t* current = notes.start;
-	note_t* next = NULL;
-	while (current != NULL) {
-		next = current->next;
-		notes_destroy(current);
-		current = next;
+	while (notes.start != NULL) {
+		notes_destroy(notes.start);
 	}
 }
 
@@ -11,6 +11,8 @@
 #define NOTE_WIDTH 32
 #define NOTE_HEIGHT 32
 
+#define NOTES_POOL_SIZE 64
+
 typedef enum {
 	NOTES_GET_REMAINING_UNSPAWNED = 1,
 	NOTES_GET_REMAINING_SPAWNED = 2,
@@ -22,12 +24,18 @@ typedef struct note_s {
 	int8_t anim_offset;
 	float scale;
 	float y_offset;
+	uint16_t phase_y_offset;
+	uint16_t phase_theta;
+	uint16_t phase_scale;
 	PlyNum player;
 	notes_types_t type;
 	sprite_t* sprite;
 	hydraharmonics_state_t state;
 	rdpq_blitparms_t blitparms;
+	bool active;
 	struct note_s* next;
+	struct note_s* prev;
+	struct note_s* next_free;
 } note_t;
 
 typedef struct notes_left_s {
@@ -35,9 +43,23 @@ typedef struct notes_left_s {
 	int8_t special;
 } notes_left_t;
 
+typedef struct notes_pool_stats_s {
+	uint16_t count;
+	uint16_t capacity;
+	// Most notes alive at once, to tune NOTES_POOL_SIZE
+	uint16_t high_water;
+	// Notes that couldn't spawn because the pool was full
+	uint16_t drops;
+} notes_pool_stats_t;
+
 typedef struct note_ll_s {
 	note_t* start;
 	note_t* end;
+	note_t* free;
+	uint16_t count;
+	uint16_t high_water;
+	uint16_t drops;
+	note_t pool[NOTES_POOL_SIZE];
 	notes_left_t notes_left[NOTES_TOTAL_COUNT];
 } note_ll_t;
 
@@ -51,6 +73,7 @@ note_t* notes_get_first(void);
 void notes_move (void);
 void notes_draw (void);
 uint16_t notes_get_remaining (notes_remaining_t type);
+notes_pool_stats_t notes_get_pool_stats (void);
 void notes_destroy (note_t* dead_note);
 void notes_destroy_all (void);
 void notes_clear (void);
@@ -9,6 +9,7 @@ RiPpEr253's entry into the N64Brew 2024 Gamejam
 #include "../../minigame.h"
 #include "larcenygame.h"
 #include "larcenygameAI.h"
+#include "larcenygameSensing.h"
 // TODO: debug stuff
 #include <inttypes.h>
 
@@ -627,6 +628,57 @@ void collision_check(collisionresult_data* returnStruct, T3DVec3* pos)
     return;
 }
 
+/*==============================
+    collision_cast_ray
+    finds every collision box crossed by a ray on the XZ plane,
+    spans are written in collision object order and the count is returned
+    @param  dir is expected to be unit length
+==============================*/
+
+int collision_cast_ray(collisionspan_data* spans, T3DVec3* origin, T3DVec3* dir, float maxDistance)
+{
+    int numberOfObjects = sizeof(collisionObjects) / sizeof(collisionObjects[0]);
+    int spanCount = 0;
+
+    for(int iDx = 0; iDx < numberOfObjects; iDx++)
+    {
+        // same integer half sizes as collision_check so both agree on the box edges
+        float tEnter = 0.0f;
+        float tExit = maxDistance;
+        bool isMissed = false;
+
+        for(int axis = 0; axis <= 2 && !isMissed; axis += 2)
+        {
+            int halfSize = (axis == 0 ? collisionObjects[iDx].sizeX : collisionObjects[iDx].sizeZ) / 2;
+            float minEdge = collisionObjects[iDx].collisionCentrePos.v[axis] - halfSize;
+            float maxEdge = collisionObjects[iDx].collisionCentrePos.v[axis] + halfSize;
+
+            if(dir->v[axis] == 0.0f)
+            {
+                if(!(origin->v[axis] > minEdge && origin->v[axis] < maxEdge)) isMissed = true;
+                continue;
+            }
+
+            float t0 = (minEdge - origin->v[axis]) / dir->v[axis];
+            float t1 = (maxEdge - origin->v[axis]) / dir->v[axis];
+            if(t0 > t1) { float tempT = t0; t0 = t1; t1 = tempT; }
+            if(t0 > tEnter) tEnter = t0;
+            if(t1 < tExit) tExit = t1;
+            if(tEnter >= tExit) isMissed = true;
+        }
+
+        if(isMissed) continue;
+
+        spans[spanCount].indexOfCollidedObject = iDx;
+        spans[spanCount].collisionType = collisionObjects[iDx].collisionType;
+        spans[spanCount].entryDistance = tEnter;
+        spans[spanCount].exitDistance = tExit;
+        spanCount++;
+    }
+
+    return spanCount;
+}
+
 // takes two lines, AB and CD are arrays of 2, with two points, using X and Z
 // returns true if there's an intersection, otherwise returns false
 bool lineLineIntersectTest(T3DVec3* AB, T3DVec3* CD, T3DVec3* XZ)
@@ -1021,52 +1073,48 @@ void player_fixedloop(float deltaTime, int playerNumber)
     if(players[playerNumber].animBlend > 1.0f)players[playerNumber].animBlend = 1.0f;
     if(players[playerNumber].animBlend < 0.01f) t3d_anim_set_time(&players[playerNumber].animWalk, 0.0f);
 
+    // patch the snapshot with our new position before any distance checks
+    sensing_refreshPlayer(playerNumber);
+
     // do objective touching check
     // only thieves can complete objectives
     if(players[playerNumber].playerTeam == teamThief)
     {
-        // for every objective, check if closer than 10 units
-        for(int iDx = 0; iDx < sizeof(objectives) / sizeof(objectives[0]); iDx++)
+        int count;
+        const sensingentry_data* nearest = sensing_nearestObjectives(playerNumber, &count);
+        // objectives are sorted nearest first, so stop at the first one out of reach
+        for(int iDx = 0; iDx < count && nearest[iDx].distanceSq < OBJECTIVE_TOUCH_DISTANCE * OBJECTIVE_TOUCH_DISTANCE; iDx++)
         {
             // skip if not active
-            if(objectives[iDx].isActive == false)
+            if(objectives[nearest[iDx].index].isActive == false)
             {
                 continue;
             }
-            // create a temporary vector
-            T3DVec3 tempVec = {0};
-            // get the vector offset between the player and the objective positions
-            t3d_vec3_diff(&tempVec, &players[playerNumber].playerPos, &objectives[iDx].objectivePos);
-            // if objective is closer than 10 units, then count as having been completed
-            if(t3d_vec3_len(&tempVec) < OBJECTIVE_TOUCH_DISTANCE)
-            {
-                objectives[iDx].isActive = false;
-                
-                wav64_play(&sfx_objectiveCompleted, 30);
-                mixer_ch_set_vol(30, 0.5f, 0.5f);
-            }
+            objectives[nearest[iDx].index].isActive = false;
+            sensing_invalidate();
+
+            wav64_play(&sfx_objectiveCompleted, 30);
+            mixer_ch_set_vol(30, 0.5f, 0.5f);
         }
     }
 
     // do thief catching check
     if(players[playerNumber].playerTeam == teamGuard)
     {
-        for(int iDx = 0; iDx < MAXPLAYERS; iDx++)
+        int count;
+        const sensingentry_data* nearest = sensing_nearestOfTeam(playerNumber, teamThief, &count);
+        for(int iDx = 0; iDx < count && nearest[iDx].distanceSq < 10 * 10; iDx++)
         {
-            if(players[iDx].isActive == false || players[iDx].playerTeam == teamGuard)
+            int thiefIndex = nearest[iDx].index;
+            if(players[thiefIndex].isActive == false || !(players[thiefIndex].stunTimer > 0.0f))
             {
                 continue;
             }
-            T3DVec3 tempVec = {0};
-            t3d_vec3_diff(&tempVec, &players[playerNumber].playerPos, &players[iDx].playerPos);
-            if(t3d_vec3_len(&tempVec) < 10 && players[iDx].stunTimer > 0.0f)
-            {
-                players[iDx].isActive = false;
+            players[thiefIndex].isActive = false;
+            sensing_invalidate();
 
-                
-                wav64_play(&sfx_thiefCaught, 27);
-                mixer_ch_set_vol(27, 0.5f, 0.5f);
-            }
+            wav64_play(&sfx_thiefCaught, 27);
+            mixer_ch_set_vol(27, 0.5f, 0.5f);
         }
     }
 }
@@ -1079,18 +1127,15 @@ void player_fixedloop(float deltaTime, int playerNumber)
 void player_guardAbility(float deltaTime, int playerNumber)
 {
     bool tempHasHitSomeone = false;
-    // stun in an AoE
-    for(int iDx = 0; iDx < MAXPLAYERS; iDx++)
+    // stun in an AoE, thieves come sorted nearest first so stop at the first one out of range
+    int count;
+    const sensingentry_data* nearest = sensing_nearestOfTeam(playerNumber, teamThief, &count);
+    for(int iDx = 0; iDx < count && nearest[iDx].distanceSq < GUARD_ABILITY_RANGE * GUARD_ABILITY_RANGE; iDx++)
     {
-        if(players[iDx].isActive == false || players[iDx].playerTeam == teamGuard)
-        {
-            continue;
-        }
-        T3DVec3 tempVec = {0};
-        t3d_vec3_diff(&tempVec, &players[playerNumber].playerPos, &players[iDx].playerPos);
-        if(t3d_vec3_len(&tempVec) < GUARD_ABILITY_RANGE && players[iDx].stunTimer == 0.0f) 
+        int thiefIndex = nearest[iDx].index;
+        if(players[thiefIndex].stunTimer == 0.0f) 
         {
-            players[iDx].stunTimer = 1.0f;
+            players[thiefIndex].stunTimer = 1.0f;
             tempHasHitSomeone = true;
         }
     }
@@ -1117,18 +1162,34 @@ void player_thiefAbility(float deltaTime, int playerNumber)
 {
     T3DVec3 tempUnitisedRotatedVector = {0};
     T3DVec3 tempvec = {0};
-    collisionresult_data tempResult;
     bool hasHitAWall = false;
     tempUnitisedRotatedVector = (T3DVec3){{0,0,1}};
     tempUnitisedRotatedVector.v[0] = -sinf(players[playerNumber].rotY);
     tempUnitisedRotatedVector.v[2] = cosf(players[playerNumber].rotY);
 
+    // find the boxes along the jump once, the steps below only look up which span they land in
+    collisionspan_data spans[sizeof(collisionObjects) / sizeof(collisionObjects[0])];
+    int spanCount = collision_cast_ray(spans, &players[playerNumber].playerPos, &tempUnitisedRotatedVector, THIEF_ABILITY_RANGE);
+    if(spanCount == 0) return;
+
     for(float fDx = 1.0f; fDx < THIEF_ABILITY_RANGE; fDx+= THIEF_ABILITY_STRIDE)
     {
         t3d_vec3_scale(&tempvec, &tempUnitisedRotatedVector, fDx);
         t3d_vec3_add(&tempvec, &tempvec, &players[playerNumber].playerPos);
 
-        collision_check(&tempResult, &tempvec);
+        // first box in collision object order wins, the same as collision_check
+        collisionresult_data tempResult = {0};
+        for(int sDx = 0; sDx < spanCount; sDx++)
+        {
+            if(fDx > spans[sDx].entryDistance && fDx < spans[sDx].exitDistance)
+            {
+                tempResult.didCollide = true;
+                tempResult.collisionType = spans[sDx].collisionType;
+                tempResult.indexOfCollidedObject = spans[sDx].indexOfCollidedObject;
+                break;
+            }
+        }
+
         if(tempResult.didCollide == true && tempResult.collisionType != collisionGuardOnly)
         {
             hasHitAWall = true;
@@ -1161,6 +1222,7 @@ void player_thiefAbility(float deltaTime, int playerNumber)
 
             // move the player
             players[playerNumber].playerPos = tempvec;
+            sensing_refreshPlayer(playerNumber);
 
             // play sound effect here
             wav64_play(&sfx_thiefJumpAbility, 26);
@@ -1630,6 +1692,7 @@ void minigame_init()
     // ensure AI init is done before player_init, otherwise no AI to be assigned to
     ai_init(players, MAXPLAYERS, objectives, sizeof(objectives)/sizeof(objectives[0]), 
             collisionObjects, sizeof(collisionObjects)/sizeof(collisionObjects[0]));
+    sensing_init(players, MAXPLAYERS, objectives, sizeof(objectives)/sizeof(objectives[0]));
 
     // load players
     for(int i = 0; i < MAXPLAYERS; i++)
@@ -1666,6 +1729,9 @@ void minigame_fixedloop(float deltaTime)
     //fixedUpdateTime = 0;
     //aiTime = 0;
     //uint64_t fixedUpdateStart = get_ticks();
+
+    // take the distance snapshot every AI state and gameplay check reads from this tick
+    sensing_update();
     
     // update the player entities
     for(int i = 0; i < MAXPLAYERS; i++)
@@ -1763,30 +1829,10 @@ void minigame_loop(float deltaTime)
     if(!gameStarting && !gameEnding && !gamePaused)
     {
         if(gameTimeRemaining < 0) end_game(teamGuard);
-        // start this bool as true and set it false as soon as you get a single active objective
-        bool tempGameEndFlag = true;
-        for(int iDx = 0; iDx < sizeof(objectives) / sizeof(objectives[0]); iDx++)
-        {
-            if(objectives[iDx].isActive == true)
-            {
-                tempGameEndFlag = false;
-                break;
-            }
-        }
-        // if bool isn't set to false, then all objectives collected, thieves win
-        if(tempGameEndFlag) end_game(teamThief);
-        // now check for if all thieves have been caught
-        tempGameEndFlag = true;
-        for(int iDx = 0; iDx < MAXPLAYERS; iDx++)
-        {
-            if(players[iDx].isActive == true && players[iDx].playerTeam == teamThief)
-            {
-                tempGameEndFlag = false;
-                break;
-            }
-        }
-        // if bool isn't set to false, then all thieves have been caught, guards win
-        if(tempGameEndFlag) end_game(teamGuard);
+        // if no objective is left, then all objectives collected, thieves win
+        if(sensing_activeObjectiveCount() == 0) end_game(teamThief);
+        // if no thief is left, then all thieves have been caught, guards win
+        if(sensing_activeTeamCount(teamThief) == 0) end_game(teamGuard);
     }
 
 
@@ -90,6 +90,15 @@
         T3DVec3 intersectionPoint;
     } collisionresult_data;
 
+    // the part of a ray that lies inside one collision box
+    typedef struct
+    {
+        int indexOfCollidedObject;
+        collision_type collisionType;
+        float entryDistance;
+        float exitDistance;
+    } collisionspan_data;
+
     typedef struct
     {
         T3DVec3 camStartPos;
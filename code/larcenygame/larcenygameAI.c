@@ -178,15 +178,17 @@ void ai_followingOtherPlayerState(int aiIndex, float deltaTime, T3DVec3* newDir,
     // get position of current entity and get the diff to position of target entity
     t3d_vec3_diff(&tempVec, &playersRef[aiData[aiIndex].targetIndex].playerPos, &playersRef[aiIndex].playerPos);
 
+    float distanceSq = sensing_playerDistanceSq(aiIndex, aiData[aiIndex].targetIndex);
+
     // if target has moved away far enough, exit the active chase state
-    if(t3d_vec3_len(&tempVec) > DEFAULT_DISTANCE_TO_CANCEL_CHASE)
+    if(distanceSq > DEFAULT_DISTANCE_TO_CANCEL_CHASE * DEFAULT_DISTANCE_TO_CANCEL_CHASE)
     {
         ai_waitingStateEnter(aiIndex);
         return;
     }
 
     // if close to other player, perform action (make this a function of difficulty?)
-    if(t3d_vec3_len(&tempVec) < stunAbilityUseDistance && playersRef[aiIndex].playerTeam == teamGuard && playersRef[aiIndex].abilityTimer <= 0.0f)
+    if(distanceSq < stunAbilityUseDistance * stunAbilityUseDistance && playersRef[aiIndex].playerTeam == teamGuard && playersRef[aiIndex].abilityTimer <= 0.0f)
     {
         player_guardAbility(deltaTime, aiIndex);
     }
@@ -253,7 +255,7 @@ void ai_moveToObjectiveState(int aiIndex, float deltaTime, T3DVec3* newDir, floa
     t3d_vec3_diff(&tempVec, &objectivesRef[aiData[aiIndex].targetIndex].objectivePos, &playersRef[aiIndex].playerPos);
 
     // if close to the objective, just sit stil near it
-    if(t3d_vec3_len(&tempVec) < 5)
+    if(sensing_objectiveDistanceSq(aiIndex, aiData[aiIndex].targetIndex) < 5 * 5)
     {
         *newDir = playersRef[aiIndex].playerPos;
         *speed = 0.0f;
@@ -342,7 +344,7 @@ void ai_runningFromGuardState(int aiIndex, float deltaTime, T3DVec3* newDir, flo
     t3d_vec3_diff(&tempVec, &playersRef[aiIndex].playerPos, &playersRef[aiData[aiIndex].targetIndex].playerPos);
 
     // if target has moved away far enough, exit the active running away state
-    if(t3d_vec3_len(&tempVec) > DEFAULT_DISTANCE_TO_CANCEL_ESCAPE)
+    if(sensing_playerDistanceSq(aiIndex, aiData[aiIndex].targetIndex) > DEFAULT_DISTANCE_TO_CANCEL_ESCAPE * DEFAULT_DISTANCE_TO_CANCEL_ESCAPE)
     {
         ai_waitingStateEnter(aiIndex);
         return;
@@ -373,9 +375,10 @@ void ai_findClosestEntityOfType(EntitySearchReturnData* returnStruct, int aiInde
     // first zero out the returnStruct
     returnStruct->isValidTarget = false; returnStruct->targetIndex = 99; returnStruct->targetType = targetTypeNone; returnStruct->distanceToTarget = 0.0f;
 
-    int tempIndex = 99; // store the current closest in a temp variable
-    float tempDistance = 99999.0f; // make distance to check
-    T3DVec3 tempVec = {0};
+    // the sensing snapshot already holds every candidate sorted by distance, so only the list heads are needed
+    const sensingentry_data* nearest = NULL;
+    const sensingentry_data* list;
+    int count;
 
     switch(desiredType)
     {
@@ -383,41 +386,36 @@ void ai_findClosestEntityOfType(EntitySearchReturnData* returnStruct, int aiInde
         default:
             break;
         case targetTypeObjective:
-            for(int iDx = 0; iDx < objectiveDataSize; iDx++)
-            {
-                if(!objectivesRef[iDx].isActive) continue;
-
-                t3d_vec3_diff(&tempVec, &playersRef[aiIndex].playerPos, &objectivesRef[iDx].objectivePos);
-                if(t3d_vec3_len(&tempVec) <= tempDistance)
-                {
-                    returnStruct->isValidTarget = true;
-                    tempIndex = iDx;
-                    tempDistance = t3d_vec3_len(&tempVec);
-                }
-            }
+            list = sensing_nearestObjectives(aiIndex, &count);
+            if(count > 0) nearest = &list[0];
             break;
         case targetTypePlayer:
         case targetTypeGuard:
         case targetTypeThief:
-            for(int iDx = 0; iDx < playerDataSize; iDx++)
+            if(desiredType != targetTypeThief)
             {
-                if(!playersRef[iDx].isActive) continue;
-                if(iDx == aiIndex) continue; // make sure we don't return ourselves
-                if(desiredType == targetTypeGuard && playersRef[iDx].playerTeam != teamGuard) continue;
-                if(desiredType == targetTypeThief && playersRef[iDx].playerTeam != teamThief) continue;
-
-                t3d_vec3_diff(&tempVec, &playersRef[aiIndex].playerPos, &playersRef[iDx].playerPos);
-                if(t3d_vec3_len(&tempVec) <= tempDistance)
-                {
-                    returnStruct->isValidTarget = true;
-                    tempIndex = iDx;
-                    tempDistance = t3d_vec3_len(&tempVec);
-                }
+                list = sensing_nearestOfTeam(aiIndex, teamGuard, &count);
+                if(count > 0) nearest = &list[0];
+            }
+            if(desiredType != targetTypeGuard)
+            {
+                list = sensing_nearestOfTeam(aiIndex, teamThief, &count);
+                if(count > 0 && (nearest == NULL || list[0].distanceSq <= nearest->distanceSq)) nearest = &list[0];
             }
             break;
     }
-    
-    returnStruct->targetIndex = tempIndex; returnStruct->distanceToTarget = tempDistance; returnStruct->targetType = desiredType;
+
+    if(nearest != NULL)
+    {
+        returnStruct->isValidTarget = true;
+        returnStruct->targetIndex = nearest->index;
+        returnStruct->distanceToTarget = sqrtf(nearest->distanceSq);
+    }
+    else
+    {
+        returnStruct->distanceToTarget = 99999.0f;
+    }
+    returnStruct->targetType = desiredType;
 
     return;
 }
@@ -431,15 +429,13 @@ void ai_findClosestEntityOfType(EntitySearchReturnData* returnStruct, int aiInde
 bool ai_checkForProximityBasedStateChanges(int aiIndex)
 {
     EntitySearchReturnData returnedStruct;
-    T3DVec3 tempVec = {0};
 
     if(playersRef[aiIndex].playerTeam == teamGuard)
     {
         // if there's a thief nearby, enter chasing state
         ai_findClosestEntityOfType(&returnedStruct, aiIndex, targetTypeThief);
         if(!returnedStruct.isValidTarget) return false;
-        t3d_vec3_diff(&tempVec, &playersRef[aiIndex].playerPos, &playersRef[returnedStruct.targetIndex].playerPos);
-        if(t3d_vec3_len(&tempVec) <= DEFAULT_DISTANCE_TO_SWITCH_CHASE_STATE)
+        if(sensing_playerDistanceSq(aiIndex, returnedStruct.targetIndex) <= DEFAULT_DISTANCE_TO_SWITCH_CHASE_STATE * DEFAULT_DISTANCE_TO_SWITCH_CHASE_STATE)
         {
             ai_followingOtherPlayerStateEnter(aiIndex);
             return true;
@@ -452,8 +448,7 @@ bool ai_checkForProximityBasedStateChanges(int aiIndex)
         // if there's a guard nearby, enter running state
         ai_findClosestEntityOfType(&returnedStruct, aiIndex, targetTypeGuard);
         if(!returnedStruct.isValidTarget) return false;
-        t3d_vec3_diff(&tempVec, &playersRef[aiIndex].playerPos, &playersRef[returnedStruct.targetIndex].playerPos);
-        if(t3d_vec3_len(&tempVec) <= DEFAULT_DISTANCE_TO_SWITCH_RUNNING_STATE)
+        if(sensing_playerDistanceSq(aiIndex, returnedStruct.targetIndex) <= DEFAULT_DISTANCE_TO_SWITCH_RUNNING_STATE * DEFAULT_DISTANCE_TO_SWITCH_RUNNING_STATE)
         {
             ai_runningFromGuardStateEnter(aiIndex);
             return true;
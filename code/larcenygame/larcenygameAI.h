@@ -5,6 +5,7 @@
 #include "../../core.h"
 #include "../../minigame.h"
 #include "./larcenygame.h"
+#include "./larcenygameSensing.h"
 
 /*********************************
     Structs exclusive to AI
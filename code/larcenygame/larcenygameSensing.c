@@ -0,0 +1,233 @@
+#include "./larcenygameSensing.h"
+
+
+/*********************************
+            Globals
+*********************************/
+
+sensingsnapshot_data sensingSnapshot;
+
+player_data* sensingPlayersRef;
+int sensingPlayerDataSize;
+objective_data* sensingObjectivesRef;
+int sensingObjectiveDataSize;
+
+
+/*********************************
+        Internal functions
+*********************************/
+
+/*==============================
+    sensing_distanceSq
+    Squared length between two positions,
+    nothing in the snapshot ever needs the square root
+==============================*/
+
+static float sensing_distanceSq(const T3DVec3* a, const T3DVec3* b)
+{
+    T3DVec3 tempVec = {0};
+    t3d_vec3_diff(&tempVec, a, b);
+    return t3d_vec3_len2(&tempVec);
+}
+
+/*==============================
+    sensing_insertSorted
+    Inserts an entry into a list kept sorted by distance
+==============================*/
+
+static void sensing_insertSorted(sensingentry_data* list, int* count, int index, float distanceSq)
+{
+    int iDx = *count;
+    while(iDx > 0 && list[iDx - 1].distanceSq > distanceSq)
+    {
+        list[iDx] = list[iDx - 1];
+        iDx--;
+    }
+    list[iDx].index = index;
+    list[iDx].distanceSq = distanceSq;
+    (*count)++;
+}
+
+/*==============================
+    sensing_rebuildLists
+    Rebuilds the sorted nearest lists and active counts
+    from the cached distances, only if something changed
+==============================*/
+
+static void sensing_rebuildLists()
+{
+    if(!sensingSnapshot.listsDirty) return;
+
+    sensingSnapshot.activeByTeam[teamThief] = 0;
+    sensingSnapshot.activeByTeam[teamGuard] = 0;
+    sensingSnapshot.activeObjectives = 0;
+
+    for(int iDx = 0; iDx < sensingPlayerDataSize; iDx++)
+    {
+        if(sensingPlayersRef[iDx].isActive) sensingSnapshot.activeByTeam[sensingPlayersRef[iDx].playerTeam]++;
+    }
+    for(int iDx = 0; iDx < sensingObjectiveDataSize; iDx++)
+    {
+        if(sensingObjectivesRef[iDx].isActive) sensingSnapshot.activeObjectives++;
+    }
+
+    for(int iDx = 0; iDx < sensingPlayerDataSize; iDx++)
+    {
+        sensingSnapshot.nearestByTeamCount[iDx][teamThief] = 0;
+        sensingSnapshot.nearestByTeamCount[iDx][teamGuard] = 0;
+        sensingSnapshot.nearestObjectiveCount[iDx] = 0;
+
+        for(int jDx = 0; jDx < sensingPlayerDataSize; jDx++)
+        {
+            if(jDx == iDx || !sensingPlayersRef[jDx].isActive) continue;
+
+            player_team team = sensingPlayersRef[jDx].playerTeam;
+            sensing_insertSorted(sensingSnapshot.nearestByTeam[iDx][team], &sensingSnapshot.nearestByTeamCount[iDx][team],
+                jDx, sensingSnapshot.playerDistanceSq[iDx][jDx]);
+        }
+
+        for(int jDx = 0; jDx < sensingObjectiveDataSize; jDx++)
+        {
+            if(!sensingObjectivesRef[jDx].isActive) continue;
+
+            sensing_insertSorted(sensingSnapshot.nearestObjectives[iDx], &sensingSnapshot.nearestObjectiveCount[iDx],
+                jDx, sensingSnapshot.objectiveDistanceSq[iDx][jDx]);
+        }
+    }
+
+    sensingSnapshot.listsDirty = false;
+}
+
+
+/*********************************
+        Public functions
+*********************************/
+
+/*==============================
+    sensing_init
+    Sets the local references to the player and objective arrays
+==============================*/
+
+void sensing_init(player_data* a_players, int a_playerDataSize, objective_data* a_objectives, int a_objectiveDataSize)
+{
+    assertf(a_playerDataSize <= MAXPLAYERS, "Too many players for the sensing snapshot");
+    assertf(a_objectiveDataSize <= SENSING_MAX_OBJECTIVES, "Too many objectives for the sensing snapshot");
+
+    sensingPlayersRef = a_players;
+    sensingPlayerDataSize = a_playerDataSize;
+    sensingObjectivesRef = a_objectives;
+    sensingObjectiveDataSize = a_objectiveDataSize;
+
+    memset(&sensingSnapshot, 0, sizeof(sensingSnapshot));
+    sensingSnapshot.listsDirty = true;
+}
+
+/*==============================
+    sensing_update
+    Computes every player/player and player/objective
+    distance once for this tick
+==============================*/
+
+void sensing_update()
+{
+    for(int iDx = 0; iDx < sensingPlayerDataSize; iDx++)
+    {
+        sensingSnapshot.playerDistanceSq[iDx][iDx] = 0.0f;
+        for(int jDx = iDx + 1; jDx < sensingPlayerDataSize; jDx++)
+        {
+            float distanceSq = sensing_distanceSq(&sensingPlayersRef[iDx].playerPos, &sensingPlayersRef[jDx].playerPos);
+            sensingSnapshot.playerDistanceSq[iDx][jDx] = distanceSq;
+            sensingSnapshot.playerDistanceSq[jDx][iDx] = distanceSq;
+        }
+
+        for(int jDx = 0; jDx < sensingObjectiveDataSize; jDx++)
+        {
+            sensingSnapshot.objectiveDistanceSq[iDx][jDx] = sensing_distanceSq(&sensingPlayersRef[iDx].playerPos, &sensingObjectivesRef[jDx].objectivePos);
+        }
+    }
+
+    sensingSnapshot.listsDirty = true;
+}
+
+/*==============================
+    sensing_refreshPlayer
+    Patches the row and column of a single player,
+    so checks later in the same tick see its new position
+==============================*/
+
+void sensing_refreshPlayer(int playerIndex)
+{
+    for(int jDx = 0; jDx < sensingPlayerDataSize; jDx++)
+    {
+        if(jDx == playerIndex) continue;
+
+        float distanceSq = sensing_distanceSq(&sensingPlayersRef[playerIndex].playerPos, &sensingPlayersRef[jDx].playerPos);
+        sensingSnapshot.playerDistanceSq[playerIndex][jDx] = distanceSq;
+        sensingSnapshot.playerDistanceSq[jDx][playerIndex] = distanceSq;
+    }
+
+    for(int jDx = 0; jDx < sensingObjectiveDataSize; jDx++)
+    {
+        sensingSnapshot.objectiveDistanceSq[playerIndex][jDx] = sensing_distanceSq(&sensingPlayersRef[playerIndex].playerPos, &sensingObjectivesRef[jDx].objectivePos);
+    }
+
+    sensingSnapshot.listsDirty = true;
+}
+
+/*==============================
+    sensing_invalidate
+    Forces the sorted lists to be rebuilt on the next read
+==============================*/
+
+void sensing_invalidate()
+{
+    sensingSnapshot.listsDirty = true;
+}
+
+float sensing_playerDistanceSq(int playerA, int playerB)
+{
+    return sensingSnapshot.playerDistanceSq[playerA][playerB];
+}
+
+float sensing_objectiveDistanceSq(int playerIndex, int objectiveIndex)
+{
+    return sensingSnapshot.objectiveDistanceSq[playerIndex][objectiveIndex];
+}
+
+/*==============================
+    sensing_nearestOfTeam
+    Returns the other active players of a team,
+    sorted nearest first, the count is written to count
+==============================*/
+
+const sensingentry_data* sensing_nearestOfTeam(int playerIndex, player_team team, int* count)
+{
+    sensing_rebuildLists();
+    *count = sensingSnapshot.nearestByTeamCount[playerIndex][team];
+    return sensingSnapshot.nearestByTeam[playerIndex][team];
+}
+
+/*==============================
+    sensing_nearestObjectives
+    Returns the active objectives,
+    sorted nearest first, the count is written to count
+==============================*/
+
+const sensingentry_data* sensing_nearestObjectives(int playerIndex, int* count)
+{
+    sensing_rebuildLists();
+    *count = sensingSnapshot.nearestObjectiveCount[playerIndex];
+    return sensingSnapshot.nearestObjectives[playerIndex];
+}
+
+int sensing_activeTeamCount(player_team team)
+{
+    sensing_rebuildLists();
+    return sensingSnapshot.activeByTeam[team];
+}
+
+int sensing_activeObjectiveCount()
+{
+    sensing_rebuildLists();
+    return sensingSnapshot.activeObjectives;
+}
@@ -0,0 +1,57 @@
+#ifndef GAMEJAM2024_LARCENYGAMESENSING_H
+#define GAMEJAM2024_LARCENYGAMESENSING_H
+
+#include <libdragon.h>
+#include "../../core.h"
+#include "../../minigame.h"
+#include "./larcenygame.h"
+
+/*********************************
+    Per-tick world snapshot shared by
+    the AI and the gameplay checks
+*********************************/
+
+#define SENSING_MAX_OBJECTIVES 8
+#define SENSING_TEAM_COUNT 2
+
+typedef struct
+{
+    int index;
+    float distanceSq;
+} sensingentry_data;
+
+typedef struct
+{
+    // squared distances, computed once per tick and patched when a single player moves
+    float playerDistanceSq[MAXPLAYERS][MAXPLAYERS];
+    float objectiveDistanceSq[MAXPLAYERS][SENSING_MAX_OBJECTIVES];
+
+    // per player, the other active players of each team and the active objectives, nearest first
+    sensingentry_data nearestByTeam[MAXPLAYERS][SENSING_TEAM_COUNT][MAXPLAYERS];
+    int nearestByTeamCount[MAXPLAYERS][SENSING_TEAM_COUNT];
+    sensingentry_data nearestObjectives[MAXPLAYERS][SENSING_MAX_OBJECTIVES];
+    int nearestObjectiveCount[MAXPLAYERS];
+
+    int activeByTeam[SENSING_TEAM_COUNT];
+    int activeObjectives;
+
+    bool listsDirty; // lists are rebuilt lazily on the next read
+} sensingsnapshot_data;
+
+/*********************************
+            Functions
+*********************************/
+
+void sensing_init(player_data* a_players, int a_playerDataSize, objective_data* a_objectives, int a_objectiveDataSize);
+void sensing_update(); // recompute the whole snapshot, call once at the start of a tick
+void sensing_refreshPlayer(int playerIndex); // call after a single player has moved
+void sensing_invalidate(); // call after a player or objective changes its isActive state
+
+float sensing_playerDistanceSq(int playerA, int playerB);
+float sensing_objectiveDistanceSq(int playerIndex, int objectiveIndex);
+const sensingentry_data* sensing_nearestOfTeam(int playerIndex, player_team team, int* count);
+const sensingentry_data* sensing_nearestObjectives(int playerIndex, int* count);
+int sensing_activeTeamCount(player_team team);
+int sensing_activeObjectiveCount();
+
+#endif
@@ -64,7 +64,8 @@ wav64_t sfx_stop;
 wav64_t sfx_winner;
 
 Duck *ducks;
-Snowman *snowmen;
+Snowman snowmen[MAX_SNOWMEN];
+int snowmen_count = 0;
 Controller *controllers;
 
 void sequence_game_init()
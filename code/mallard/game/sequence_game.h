@@ -65,6 +65,8 @@ typedef enum SnowmanActions
     SNOWMAN_DAMAGE = 2,
 } SnowmanActions;
 
+#define MAX_SNOWMEN 100
+
 typedef struct Snowman
 {
     int id;
@@ -86,7 +88,6 @@ typedef struct Snowman
     float hit_box_y1;
     float hit_box_x2;
     float hit_box_y2;
-    struct Snowman *next;
 } Snowman;
 
 typedef struct Controller
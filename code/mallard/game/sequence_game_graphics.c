@@ -266,11 +266,11 @@ void sequence_game_render_snowman(Snowman *currentSnowman)
 
 void sequence_game_render_snowmen_and_ducks()
 {
-    Snowman *currentSnowman = snowmen;
     Duck *currentDuck = ducks;
 
-    while (currentSnowman != NULL)
+    for (int i = 0; i < snowmen_count; i++)
     {
+        Snowman *currentSnowman = &snowmen[snowmen_order[i]];
         while (currentDuck != NULL && currentDuck->collision_box_y2 < currentSnowman->collision_box_y2)
         {
             sequence_game_render_duck(currentDuck);
@@ -278,7 +278,6 @@ void sequence_game_render_snowmen_and_ducks()
         }
 
         sequence_game_render_snowman(currentSnowman);
-        currentSnowman = currentSnowman->next;
     }
 
     while (currentDuck != NULL)
@@ -28,60 +28,6 @@ void duck_slap(Duck *duck)
     duck->frames = 0;
 }
 
-void snowmen_bubble_sort()
-{
-    bool swapped = true;
-
-    while (swapped)
-    {
-        Snowman **prev = &snowmen;
-        Snowman *curr;
-        Snowman *next;
-
-        swapped = false;
-        for (curr = snowmen; curr; prev = &curr->next, curr = curr->next)
-        {
-            next = curr->next;
-
-            if (next && curr->collision_box_y2 > next->collision_box_y2)
-            {
-                curr->next = next->next;
-                next->next = curr;
-                *prev = next;
-
-                swapped = true;
-            }
-        }
-    }
-}
-
-void remove_snowman(int id)
-{
-    // Remove snowman from the snowmen linked list
-    Snowman *currentSnowman = snowmen;
-    Snowman *previousSnowman = NULL;
-    while (currentSnowman != NULL)
-    {
-        if (currentSnowman->id == id)
-        {
-            if (previousSnowman == NULL)
-            {
-                snowmen = currentSnowman->next;
-            }
-            else
-            {
-                previousSnowman->next = currentSnowman->next;
-            }
-
-            free(currentSnowman);
-            break;
-        }
-
-        previousSnowman = currentSnowman;
-        currentSnowman = currentSnowman->next;
-    }
-}
-
 void update_snowmen(float deltatime)
 {
     if (time_elapsed >= GAME_FADE_IN_DURATION + 3 + GAME_DURATION)
@@ -102,9 +48,10 @@ void update_snowmen(float deltatime)
             SNOWMAN_SPAWN_FREQUENCY = 0.5f;
 
         // Update snowmen.
-        Snowman *currentSnowman = snowmen;
-        while (currentSnowman != NULL)
+        int i = 0;
+        while (i < snowmen_count)
         {
+            Snowman *currentSnowman = &snowmen[i];
             currentSnowman->frames++;
             currentSnowman->time_since_last_hit += deltatime;
 
@@ -129,14 +76,13 @@ void update_snowmen(float deltatime)
 
                 if (currentSnowman->health <= 0)
                 {
-                    Snowman *temporary = currentSnowman;
-                    currentSnowman = currentSnowman->next;
-                    remove_snowman(temporary->id);
+                    // The last snowman is moved into this slot, so don't advance.
+                    remove_snowman(i);
                     continue;
                 }
             }
 
-            currentSnowman = currentSnowman->next;
+            i++;
         }
 
         // Add snowman.
@@ -146,7 +92,8 @@ void update_snowmen(float deltatime)
             time_elapsed_since_last_snowman_spawn = 0.0f;
         }
 
-        snowmen_bubble_sort();
+        sort_snowmen();
+        build_snowmen_grid();
 
         if (time_elapsed > GAME_FADE_IN_DURATION + 3)
         {
@@ -190,9 +137,9 @@ ValidMovement validate_movement(Duck *duck, Vector2 movement)
     };
 
     // Check each snowman for collision.
-    Snowman *currentSnowman = snowmen;
-    while (currentSnowman != NULL)
+    for (int i = 0; i < snowmen_count; i++)
     {
+        Snowman *currentSnowman = &snowmen[i];
         Rect currentSnowmanCollisionBox = (Rect){.x1 = currentSnowman->collision_box_x1, .y1 = currentSnowman->collision_box_y1, .x2 = currentSnowman->collision_box_x2, .y2 = currentSnowman->collision_box_y2};
 
         if (detect_collision(duckPotentialCollisionBox, currentSnowmanCollisionBox))
@@ -213,8 +160,6 @@ ValidMovement validate_movement(Duck *duck, Vector2 movement)
         {
             return validMovement;
         }
-
-        currentSnowman = currentSnowman->next;
     }
 
     // Check each duck for collision.
@@ -678,28 +623,10 @@ void process_input(Duck *duck, Controller *controller, joypad_buttons_t pressed,
 
 Snowman *find_nearest_snowman(Duck *duck)
 {
-    Snowman *nearestSnowman = NULL;
-    float nearestDistance = 999999.0f;
-
     float duck_x = (duck->slap_box_x1 + duck->slap_box_x2) / 2;
     float duck_y = (duck->slap_box_y1 + duck->slap_box_y2) / 2;
 
-    Snowman *currentSnowman = snowmen;
-    while (currentSnowman != NULL)
-    {
-        float snowman_x = (currentSnowman->hit_box_x1 + currentSnowman->hit_box_x2) / 2;
-        float snowman_y = (currentSnowman->hit_box_y1 + currentSnowman->hit_box_y2) / 2;
-        float distance = fmax(abs(duck_x - snowman_x), abs(duck_y - snowman_y));
-        if (distance < nearestDistance)
-        {
-            nearestDistance = distance;
-            nearestSnowman = currentSnowman;
-        }
-
-        currentSnowman = currentSnowman->next;
-    }
-
-    return nearestSnowman;
+    return find_nearest_snowman_to(duck_x, duck_y);
 }
 
 void set_duck_direction(Duck *duck, Snowman *snowman)
@@ -911,9 +838,9 @@ void evaluate_attack()
             {
                 Rect currentDuckSlapBox = (Rect){.x1 = currentDuck->slap_box_x1, .y1 = currentDuck->slap_box_y1, .x2 = currentDuck->slap_box_x2, .y2 = currentDuck->slap_box_y2};
 
-                Snowman *currentSnowman = snowmen;
-                while (currentSnowman != NULL)
+                for (int i = 0; i < snowmen_count; i++)
                 {
+                    Snowman *currentSnowman = &snowmen[i];
                     Rect currentSnowmanHitBox = (Rect){.x1 = currentSnowman->hit_box_x1, .y1 = currentSnowman->hit_box_y1, .x2 = currentSnowman->hit_box_x2, .y2 = currentSnowman->hit_box_y2};
 
                     if (detect_collision(currentDuckSlapBox, currentSnowmanHitBox))
@@ -940,21 +867,8 @@ void evaluate_attack()
                                 currentDuck->score += 1;
                                 currentDuck->time_seeking_target = 0.0f;
                             }
-
-                            // Next Snowman.
-                            currentSnowman = currentSnowman->next;
-                        }
-                        else
-                        {
-                            // Next Snowman.
-                            currentSnowman = currentSnowman->next;
                         }
                     }
-                    else
-                    {
-                        // Next Snowman.
-                        currentSnowman = currentSnowman->next;
-                    }
                 }
 
                 Duck *temporaryDuck = ducks;
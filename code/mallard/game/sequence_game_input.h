@@ -2,7 +2,8 @@
 #define SEQUENCE_GAME_INPUT_H
 #include "../../../core.h"
 
-extern Snowman *snowmen;
+extern Snowman snowmen[MAX_SNOWMEN];
+extern int snowmen_count;
 extern Duck *ducks;
 
 extern bool sequence_game_should_cleanup;
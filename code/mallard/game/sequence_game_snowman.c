@@ -3,28 +3,31 @@
 #include "sequence_game_snowman.h"
 #include "sequence_game_input.h"
 
-#define MAX_SNOWMEN 100
 int snowman_uuid = 0;
 
-int count_snowmen()
+// Pool indices sorted by collision_box_y2, used as the render order.
+int snowmen_order[MAX_SNOWMEN];
+
+// Pool indices grouped by X bucket, bucket b spans [grid_start[b], grid_start[b + 1]).
+int snowmen_grid_start[SNOWMAN_GRID_BUCKETS + 1];
+int snowmen_grid_items[MAX_SNOWMEN];
+
+int get_snowman_bucket(float x)
 {
-    int count = 0;
-    Snowman *current = snowmen;
-    while (current != NULL)
-    {
-        count++;
-        current = current->next;
-    }
-    return count;
+    int bucket = (int)x / SNOWMAN_GRID_BUCKET_WIDTH;
+    if (bucket < 0)
+        return 0;
+    if (bucket >= SNOWMAN_GRID_BUCKETS)
+        return SNOWMAN_GRID_BUCKETS - 1;
+    return bucket;
 }
 
 void display_snowmen()
 {
-    Snowman *current = snowmen;
-    while (current != NULL)
+    for (int i = 0; i < snowmen_count; i++)
     {
+        Snowman *current = &snowmen[snowmen_order[i]];
         fprintf(stderr, "[Snowman #%i - %f], ", current->id, current->collision_box_y2);
-        current = current->next;
     }
     fprintf(stderr, "\n");
 }
@@ -66,9 +69,8 @@ Vector2 get_snowman_spawn()
     }
 }
 
-Snowman *create_snowman()
+void create_snowman(Snowman *snowman)
 {
-    Snowman *snowman = (Snowman *)malloc(sizeof(Snowman));
     Vector2 spawn = get_snowman_spawn();
     snowman->id = snowman_uuid;
     snowman->x = spawn.x;
@@ -90,46 +92,149 @@ Snowman *create_snowman()
     snowman->hit_box_x2 = spawn.x + SNOWMAN_HIT_BOX_X2_OFFSET;
     snowman->hit_box_y2 = spawn.y + SNOWMAN_HIT_BOX_Y2_OFFSET;
     snowman_uuid++;
-    return snowman;
 }
 
 void add_snowman()
 {
-    if (count_snowmen() >= MAX_SNOWMEN)
+    if (snowmen_count >= MAX_SNOWMEN)
     {
         return;
     }
 
-    Snowman *snowman = create_snowman();
+    int index = snowmen_count++;
+    create_snowman(&snowmen[index]);
 
-    // Insert at the head if the list is empty.
-    // Insert at the head if the new value is smaller.
-    if (snowmen == NULL || snowmen->y >= snowman->y)
+    // Insert into the render order at the correct position.
+    int i = index;
+    while (i > 0 && snowmen[snowmen_order[i - 1]].collision_box_y2 > snowmen[index].collision_box_y2)
     {
-        snowman->next = snowmen;
-        snowmen = snowman;
-        return;
+        snowmen_order[i] = snowmen_order[i - 1];
+        i--;
     }
+    snowmen_order[i] = index;
+}
 
-    // Otherwise, Traverse the snowmen to find the correct insertion point.
-    Snowman *current = snowmen;
-    while (current->next != NULL && current->next->y < snowman->y)
+void remove_snowman(int index)
+{
+    // Drop the snowman from the render order, keeping the rest sorted.
+    int last = snowmen_count - 1;
+    int j = 0;
+    for (int i = 0; i < snowmen_count; i++)
     {
-        current = current->next;
+        if (snowmen_order[i] == index)
+        {
+            continue;
+        }
+
+        // The last snowman in the pool is moved into the freed slot.
+        snowmen_order[j++] = snowmen_order[i] == last ? index : snowmen_order[i];
     }
 
-    // Insert the new snowman
-    snowman->next = current->next;
-    current->next = snowman;
+    snowmen[index] = snowmen[last];
+    snowmen_count--;
 }
 
-void free_snowmen()
+void sort_snowmen()
+{
+    // Snowmen barely change order between frames, so insertion sort is close to linear here.
+    for (int i = 1; i < snowmen_count; i++)
+    {
+        int index = snowmen_order[i];
+        float key = snowmen[index].collision_box_y2;
+        int j = i;
+        while (j > 0 && snowmen[snowmen_order[j - 1]].collision_box_y2 > key)
+        {
+            snowmen_order[j] = snowmen_order[j - 1];
+            j--;
+        }
+        snowmen_order[j] = index;
+    }
+}
+
+void build_snowmen_grid()
+{
+    int bucket_of[MAX_SNOWMEN];
+
+    for (int b = 0; b <= SNOWMAN_GRID_BUCKETS; b++)
+    {
+        snowmen_grid_start[b] = 0;
+    }
+
+    // Count per bucket, then turn the counts into start offsets.
+    for (int i = 0; i < snowmen_count; i++)
+    {
+        bucket_of[i] = get_snowman_bucket((snowmen[i].hit_box_x1 + snowmen[i].hit_box_x2) / 2);
+        snowmen_grid_start[bucket_of[i] + 1]++;
+    }
+
+    for (int b = 0; b < SNOWMAN_GRID_BUCKETS; b++)
+    {
+        snowmen_grid_start[b + 1] += snowmen_grid_start[b];
+    }
+
+    int fill[SNOWMAN_GRID_BUCKETS];
+    for (int b = 0; b < SNOWMAN_GRID_BUCKETS; b++)
+    {
+        fill[b] = snowmen_grid_start[b];
+    }
+
+    for (int i = 0; i < snowmen_count; i++)
+    {
+        snowmen_grid_items[fill[bucket_of[i]]++] = i;
+    }
+}
+
+Snowman *find_nearest_snowman_to(float x, float y)
 {
-    Snowman *temporary;
-    while (snowmen != NULL)
+    Snowman *nearestSnowman = NULL;
+    float nearestDistance = 999999.0f;
+
+    // Walk buckets outwards from the one containing x. The distance is at least |dx|,
+    // so once a whole ring of buckets is further away than the best match we can stop.
+    int center = get_snowman_bucket(x);
+    for (int ring = 0; ring < SNOWMAN_GRID_BUCKETS; ring++)
     {
-        temporary = snowmen;
-        snowmen = snowmen->next;
-        free(temporary);
+        int left = center - ring;
+        int right = center + ring;
+
+        if (ring > 0)
+        {
+            float leftEdge = (float)((left + 1) * SNOWMAN_GRID_BUCKET_WIDTH);
+            float rightEdge = (float)(right * SNOWMAN_GRID_BUCKET_WIDTH);
+            float ringDistance = fmin(left >= 0 ? x - leftEdge : 999999.0f, right < SNOWMAN_GRID_BUCKETS ? rightEdge - x : 999999.0f);
+            if (ringDistance >= nearestDistance || (left < 0 && right >= SNOWMAN_GRID_BUCKETS))
+            {
+                break;
+            }
+        }
+
+        for (int side = 0; side < (ring > 0 ? 2 : 1); side++)
+        {
+            int bucket = side == 0 ? left : right;
+            if (bucket < 0 || bucket >= SNOWMAN_GRID_BUCKETS)
+            {
+                continue;
+            }
+
+            for (int i = snowmen_grid_start[bucket]; i < snowmen_grid_start[bucket + 1]; i++)
+            {
+                Snowman *currentSnowman = &snowmen[snowmen_grid_items[i]];
+                float snowman_x = (currentSnowman->hit_box_x1 + currentSnowman->hit_box_x2) / 2;
+                float snowman_y = (currentSnowman->hit_box_y1 + currentSnowman->hit_box_y2) / 2;
+                float distance = fmax(abs(x - snowman_x), abs(y - snowman_y));
+                if (distance < nearestDistance)
+                {
+                    nearestDistance = distance;
+                    nearestSnowman = currentSnowman;
+                }
+            }
+        }
     }
+
+    return nearestSnowman;
+}
+
+void free_snowmen()
+{
+    snowmen_count = 0;
 }
\ No newline at end of file
@@ -16,14 +16,24 @@
 #define SNOWMAN_HIT_BOX_X2_OFFSET 10
 #define SNOWMAN_HIT_BOX_Y2_OFFSET 12
 
+// Snowmen are bucketed by hit box center along X for nearest queries.
+#define SNOWMAN_GRID_BUCKET_WIDTH 32
+#define SNOWMAN_GRID_BUCKETS (320 / SNOWMAN_GRID_BUCKET_WIDTH)
+
 extern sprite_t *sequence_game_snowman_idle_sprite;
 extern sprite_t *sequence_game_snowman_damage_sprite;
 extern sprite_t *sequence_game_snowman_jump_sprite;
 
-extern Snowman *snowmen;
+extern Snowman snowmen[MAX_SNOWMEN];
+extern int snowmen_count;
+extern int snowmen_order[MAX_SNOWMEN];
 extern Duck *ducks;
 
 void add_snowman();
+void remove_snowman(int index);
+void sort_snowmen();
+void build_snowmen_grid();
+Snowman *find_nearest_snowman_to(float x, float y);
 void free_snowmen();
 void display_snowmen();
 
@@ -37,9 +37,9 @@ ASSETS_LIST += \
 filesystem/mallard/HaloDekBig.font64: $(ASSETS_DIR)/mallard/HaloDekBig.ttf
 	@mkdir -p $(dir $@)
 	@echo "    [FONT] $@"
-	$(N64_MKFONT) $(MKFONT_FLAGS) --range 50-50 --range 41-41 --range 55-55 --range 53-53 --range 44-45 --range 2e-2e --size 60 --outline 1 -o $(dir $@) "$<"
+	$(ASSET_CACHE) $(N64_MKFONT) $(MKFONT_FLAGS) --range 50-50 --range 41-41 --range 55-55 --range 53-53 --range 44-45 --range 2e-2e --size 60 --outline 1 -o $(dir $@) "$<"
 
 filesystem/mallard/HaloDekMedium.font64: $(ASSETS_DIR)/mallard/HaloDekMedium.ttf
 	@mkdir -p $(dir $@)
 	@echo "    [FONT] $@"
-	$(N64_MKFONT) $(MKFONT_FLAGS) --range 30-39 --range 2e-2e --range 50-50 --range 20-20 --range 57-57 --range 49-49 --range 4E-4E --range 53-53 --range 44-44 --range 52-52 --range 41-41 --size 36 --outline 1 -o $(dir $@) "$<"
\ No newline at end of file
+	$(ASSET_CACHE) $(N64_MKFONT) $(MKFONT_FLAGS) --range 30-39 --range 2e-2e --range 50-50 --range 20-20 --range 57-57 --range 49-49 --range 4E-4E --range 53-53 --range 44-44 --range 52-52 --range 41-41 --size 36 --outline 1 -o $(dir $@) "$<"
\ No newline at end of file
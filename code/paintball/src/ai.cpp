@@ -4,7 +4,7 @@ AI::AI() : aiActionTimer(0) {
     difficulty = core_get_aidifficulty();
 }
 
-Direction AI::calculateFireDirection(Player& player, float deltaTime, std::vector<Player> &players, GameState &state) {
+Direction AI::calculateFireDirection(Player& player, int id, float deltaTime, std::vector<Player> &players, GameState &state, const ThreatModel &threats) {
     aiActionTimer += deltaTime;
 
     float actionRate = AIActionRateSecond;
@@ -30,90 +30,50 @@ Direction AI::calculateFireDirection(Player& player, float deltaTime, std::vecto
     }
     aiActionTimer = 0;
 
-    for (auto& other : players) {
-        if (&other == &player) {
-            continue;
-        }
+    if (player.temperature > tempControl) {
+        return Direction::NONE;
+    }
 
-        if (player.temperature > tempControl) {
-            continue;
-        }
+    float random = static_cast<float>(rand()) / RAND_MAX;
+    float missFactorSeconds = 0.f;
+    bool shouldMiss = false;
+    if (difficulty == AiDiff::DIFF_EASY) {
+        missFactorSeconds = random * 0.5f;
+        shouldMiss = random < 0.7f;
+    } else if (difficulty == AiDiff::DIFF_MEDIUM) {
+        missFactorSeconds = random * 0.25f;
+        shouldMiss = random < 0.45f;
+    }
+    float tolerance = PlayerRadius + missFactorSeconds * SpeedLimit;
 
-        // Already at full health
-        if (other.team == player.team && other.firstHit == player.team) {
+    Direction best = Direction::NONE;
+    float bestTime = 0.f;
+    for (int target = 0; target < (int)players.size(); target++) {
+        if (!threats.isTarget(id, target)) {
             continue;
         }
 
-        T3DVec3 diff = {0};
-        t3d_vec3_diff(diff, player.pos, other.pos);
-
-        float random = static_cast<float>(rand()) / RAND_MAX;
-        float missFactorSeconds = 0.f;
-        bool shouldMiss = false;
-        if (difficulty == AiDiff::DIFF_EASY) {
-            missFactorSeconds = random * 0.5f;
-            if (random < 0.7f && other.team != player.team) {
-                shouldMiss = true;
-            }
-        } else if (difficulty == AiDiff::DIFF_MEDIUM) {
-            missFactorSeconds = random * 0.25f;
-            if (random < 0.45f && other.team != player.team) {
-                shouldMiss = true;
-            }
-        }
-
-        if (other.velocity.v[0] != 0.f) {
-            float enemyXTime = (diff.v[0]/other.velocity.v[0]);
-            float bulletYTime = std::abs(diff.v[2] / BulletVelocity);
-
-            if (enemyXTime >= 0 && (enemyXTime - bulletYTime) < (PlayerRadius/BulletVelocity + missFactorSeconds)) {
-                if (diff.v[2] > 0) {
-                    if (shouldMiss) return Direction::DOWN;
-                    return Direction::UP;
-                } else {
-                    if (shouldMiss) return Direction::UP;
-                    return Direction::DOWN;
-                }
-            }
+        const FiringSolution &shot = threats.getFiringSolution(id, target);
+        if (shot.direction == Direction::NONE || shot.miss >= tolerance) {
+            continue;
         }
 
-        if (other.velocity.v[2] != 0.f) {
-            float enemyYTime = (diff.v[2]/other.velocity.v[2]);
-            float bulletXTime = std::abs(diff.v[0] / BulletVelocity);
-
-            if (enemyYTime >= 0 && (enemyYTime - bulletXTime) < (PlayerRadius/BulletVelocity + missFactorSeconds)) {
-                if (diff.v[0] > 0) {
-                    if (shouldMiss) return Direction::RIGHT;
-                    return Direction::LEFT;
-                } else {
-                    if (shouldMiss) return Direction::LEFT;
-                    return Direction::RIGHT;
-                }
-            }
+        Direction direction = shot.direction;
+        if (shouldMiss && players[target].team != player.team) {
+            direction = oppositeDirection(direction);
         }
 
-        if (std::abs(diff.v[0]) < (PlayerRadius + missFactorSeconds*SpeedLimit) && t3d_vec3_len(diff) < AIFarRange) {
-            if (diff.v[2] > 0) {
-                if (shouldMiss) return Direction::DOWN;
-                return Direction::UP;
-            } else {
-                if (shouldMiss) return Direction::UP;
-                return Direction::DOWN;
-            }
+        // Hard picks the shot that lands first, the others take the first one they see
+        if (difficulty != AiDiff::DIFF_HARD) {
+            return direction;
         }
-
-        if (std::abs(diff.v[2]) < (PlayerRadius + missFactorSeconds*SpeedLimit) && t3d_vec3_len(diff) < AIFarRange) {
-            if (diff.v[0] > 0) {
-                if (shouldMiss) return Direction::RIGHT;
-                return Direction::LEFT;
-            } else {
-                if (shouldMiss) return Direction::LEFT;
-                return Direction::RIGHT;
-            }
+        if (best == Direction::NONE || shot.time < bestTime) {
+            best = direction;
+            bestTime = shot.time;
         }
     }
 
-    return Direction::NONE;
+    return best;
 }
 
 void AI::tryChangeState(Player& player, AIState newState) {
@@ -136,7 +96,7 @@ void AI::tryChangeState(Player& player, AIState newState) {
     player.multiplier2 = 1.f + AIRandomRange * (static_cast<float>(rand()) / RAND_MAX);
 }
 
-void AI::calculateMovement(Player& player, float deltaTime, std::vector<Player> &players, GameState &state, T3DVec3 &inputDirection) {
+void AI::calculateMovement(Player& player, int id, float deltaTime, std::vector<Player> &players, GameState &state, const ThreatModel &threats, T3DVec3 &inputDirection) {
     float random = static_cast<float>(rand()) / RAND_MAX;
 
     // Defaults
@@ -205,39 +165,9 @@ void AI::calculateMovement(Player& player, float deltaTime, std::vector<Player>
     }
 
     // Bullet escape
-    for (auto bullet = player.incomingBullets.begin(); bullet != player.incomingBullets.end(); ++bullet) {
-        if (bullet->team == player.team) {
-            continue;
-        }
-
-        T3DVec3 diff = {0};
-        t3d_vec3_diff(diff, player.pos, bullet->pos);
-        diff.v[1] = 0.f;
-
-        T3DVec3 bulletVelocityDir = bullet->velocity;
-        bulletVelocityDir.v[1] = 0.f;
-        t3d_vec3_norm(bulletVelocityDir);
-
-        float diffProjLen = t3d_vec3_dot(bulletVelocityDir, diff);
-
-        T3DVec3 diffProj = {0};
-        t3d_vec3_scale(diffProj, bulletVelocityDir, diffProjLen);
-
-        T3DVec3 diffPerp = {0};
-        t3d_vec3_diff(diffPerp, diff, diffProj);
-        t3d_vec3_norm(diffPerp);
-        t3d_vec3_scale(diffPerp, diffPerp, escapeWeight);
-
-        if (t3d_vec3_len(diffPerp) == 0.f) [[unlikely]] {
-            // rotate clockwise
-            diffPerp.v[0] = -bulletVelocityDir.v[2];
-            diffPerp.v[2] = bulletVelocityDir.v[0];
-        } else {
-            // TODO: increase strength if close by
-            t3d_vec3_add(inputDirection, inputDirection, diffPerp);
-        }
-    }
-    player.incomingBullets.clear();
+    T3DVec3 escape = threats.getDodge(id);
+    t3d_vec3_scale(escape, escape, escapeWeight);
+    t3d_vec3_add(inputDirection, inputDirection, escape);
 
     // center attraction
     T3DVec3 diff = {0};
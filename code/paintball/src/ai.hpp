@@ -7,6 +7,7 @@
 #include "common.hpp"
 #include "player.hpp"
 #include "gamestate.hpp"
+#include "threat.hpp"
 
 constexpr float AITemperature = 0.06f;
 constexpr float AIUnstable = 0.02f;
@@ -21,8 +22,8 @@ class AI
         void tryChangeState(Player& player, AIState newState);
     public:
         AI();
-        Direction calculateFireDirection(Player&, float deltaTime, std::vector<Player> &players, GameState &state);
-        void calculateMovement(Player&, float deltaTime, std::vector<Player> &players, GameState &state, T3DVec3 &inputDirection);
+        Direction calculateFireDirection(Player&, int id, float deltaTime, std::vector<Player> &players, GameState &state, const ThreatModel &threats);
+        void calculateMovement(Player&, int id, float deltaTime, std::vector<Player> &players, GameState &state, const ThreatModel &threats, T3DVec3 &inputDirection);
 };
 
 #endif // __AI_H
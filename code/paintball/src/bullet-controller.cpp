@@ -1,4 +1,5 @@
 #include "bullet-controller.hpp"
+#include "threat.hpp"
 
 BulletController::BulletController(std::shared_ptr<MapRenderer> map, std::shared_ptr<UIRenderer> ui) :
     newBulletCount(0),
@@ -48,7 +49,8 @@ void BulletController::render(float deltaTime) {
 
     double interpolate = core_get_subtick();
 
-    for (auto bullet = bullets.begin(); bullet != bullets.end(); ++bullet) {
+    for (std::size_t b = 0; b < bullets.size(); b++) {
+        Bullet *bullet = &bullets[b];
         assertf(bullet->matFP.get(), "Bullet matrix is null");
         assertf(block.get(), "Bullet dl is null");
 
@@ -92,14 +94,17 @@ bool BulletController::simulatePhysics(float deltaTime, Bullet &bullet) {
 
 void BulletController::fixedUpdate(float deltaTime, std::vector<Player> &gameplayData) {
     assertf(map.get(), "Map renderer is null");
-    for (auto bullet = bullets.begin(); bullet != bullets.end(); ++bullet) {
+    for (std::size_t b = 0; b < bullets.size();) {
+        Bullet *bullet = &bullets[b];
         bool isDead = simulatePhysics(deltaTime, *bullet);
         if (isDead) {
             map->splash(bullet->pos.v[0], bullet->pos.v[2], bullet->team, atan2f(bullet->velocity.v[0], bullet->velocity.v[2]));
-            bullets.remove(bullet);
+            // The last bullet moves into this index, look at it again
+            bullets.removeAt(b);
             continue;
         }
 
+        bool hit = false;
         int i = 0;
         // TODO: if we could delegate this to player.cpp, b/c collider doesn't belong here
         for (auto& player : gameplayData)
@@ -115,28 +120,37 @@ void BulletController::fixedUpdate(float deltaTime, std::vector<Player> &gamepla
                 (player.pos.v[0] - bullet->pos.v[0]) * (player.pos.v[0] - bullet->pos.v[0]) +
                 (player.pos.v[2] - bullet->pos.v[2]) * (player.pos.v[2] - bullet->pos.v[2]);
 
-            if (dist2 < AIBulletDetectRange * AIBulletDetectRange) {
-                player.incomingBullets.add(*bullet);
-            }
-
             if (dist2 < PlayerRadius * PlayerRadius) {
                 player.acceptHit(*bullet);
 
                 ui->registerHit(HitMark {bullet->pos, bullet->owner});
                 map->splash(bullet->pos.v[0], bullet->pos.v[2], bullet->team, atan2f(bullet->velocity.v[0], bullet->velocity.v[2]));
                 wav64_play(sfxHit.get(), HitAudioChannel);
-                bullets.remove(bullet);
+                hit = true;
 
                 // No need to check other players, we don't have the bullet anymore
                 break;
             }
             i++;
         }
+
+        if (hit) {
+            bullets.removeAt(b);
+            continue;
+        }
+        b++;
+    }
+}
+
+void BulletController::gatherThreats(ThreatModel &threats) {
+    for (std::size_t b = 0; b < bullets.size(); b++) {
+        Bullet &bullet = bullets[b];
+        threats.addBullet(bullet.pos, bullet.velocity, bullet.owner, bullet.team);
     }
 }
 
 void BulletController::fireBullet(const T3DVec3 &pos, const T3DVec3 &velocity, PlyNum owner, PlyNum team) {
-    // TODO: this will prevent firing once every slot is occupied
+    // Shots fired while every slot is occupied are dropped, see getStats()
     bullets.add(Bullet {pos, velocity, owner, team});
     wav64_play(sfxFire.get(), FireAudioChannel);
 }
\ No newline at end of file
@@ -21,10 +21,9 @@
 #include "./map.hpp"
 #include "./ui.hpp"
 #include "./bullet.hpp"
+#include "./containers.hpp"
 
-constexpr float BulletHeight = 35.f;
-constexpr int BulletLimit = 100;
-constexpr float Gravity = -200;
+class ThreatModel;
 
 class BulletController
 {
@@ -33,7 +32,7 @@ class BulletController
         U::T3DModel model;
         U::RSPQBlock block;
 
-        List<Bullet, BulletLimit> bullets;
+        SlotMap<Bullet, BulletLimit> bullets;
 
         std::shared_ptr<MapRenderer> map;
         std::shared_ptr<UIRenderer> ui;
@@ -49,6 +48,8 @@ class BulletController
         void render(float deltaTime);
         void fixedUpdate(float deltaTime, std::vector<Player> &);
         void fireBullet(const T3DVec3 &pos, const T3DVec3 &velocity, PlyNum owner, PlyNum team);
+        void gatherThreats(ThreatModel &threats);
+        ContainerStats getStats() const { return bullets.stats(); }
 };
 
 #endif // __BULLET_CONTROLLER_H
\ No newline at end of file
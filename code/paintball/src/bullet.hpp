@@ -19,13 +19,11 @@
 #include "./constants.hpp"
 
 class BulletController;
-class AI;
 class Player;
 
 class Bullet
 {
     friend class ::BulletController;
-    friend class ::AI;
     friend class ::Player;
 
     public:
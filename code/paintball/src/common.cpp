@@ -2,4 +2,14 @@
 
 int randomRange(int min, int max){
    return min + rand() / (RAND_MAX / (max - min + 1) + 1);
-};
\ No newline at end of file
+};
+
+Direction oppositeDirection(Direction direction){
+   switch(direction){
+      case UP: return DOWN;
+      case DOWN: return UP;
+      case LEFT: return RIGHT;
+      case RIGHT: return LEFT;
+      default: return NONE;
+   }
+}
@@ -12,5 +12,6 @@ enum Direction {
 };
 
 int randomRange(int min, int max);
+Direction oppositeDirection(Direction direction);
 
 #endif // __COMMON_H
\ No newline at end of file
@@ -20,6 +20,9 @@ constexpr int RoundCount = 5;
 constexpr float SpeedLimit = 80.f;
 constexpr float PlayerRadius = 13;
 constexpr float BulletVelocity = 300;
+constexpr float BulletHeight = 35.f;
+constexpr int BulletLimit = 100;
+constexpr float Gravity = -200;
 
 constexpr float CooldownPerSecond = 1.f;
 constexpr float TempPerBullet = 0.35f;
@@ -28,7 +31,6 @@ constexpr float OverheatPenalty = 1.5f;
 // AI
 constexpr float AICloseRange = 100;
 constexpr float AIFarRange = 200;
-constexpr float AIBulletDetectRange = 100;
 constexpr float AIRandomRange = 0.5;
 
 // AUDIO
@@ -36,6 +38,10 @@ constexpr int FireAudioChannel = 10;
 constexpr int HitAudioChannel = 11;
 constexpr int GeneralPurposeAudioChannel = 12;
 
+// DEBUG
+// Shows fill, high-water mark and drops of the fixed containers
+constexpr bool DebugContainers = false;
+
 // CORE
 // Same range as analog input, max value that can be generated by the controller
 constexpr float ForceLimit = 60.f;
@@ -0,0 +1,197 @@
+#ifndef __CONTAINERS_H
+#define __CONTAINERS_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Fixed capacity containers, nothing here allocates after construction.
+ * Every container counts what it had to drop and the most entries it ever held,
+ * so the capacities can be tuned from ContainerStats instead of guessed.
+ */
+
+struct ContainerStats {
+    std::size_t count;
+    std::size_t capacity;
+    std::size_t highWater;
+    uint32_t drops;
+};
+
+class ContainerTelemetry {
+    protected:
+        std::size_t highWater = 0;
+        uint32_t drops = 0;
+
+        void track(std::size_t count) {
+            if (count > highWater) highWater = count;
+        }
+
+        ContainerStats makeStats(std::size_t count, std::size_t capacity) const {
+            return ContainerStats {count, capacity, highWater, drops};
+        }
+};
+
+// Unordered vector, removing swaps the last element in
+template<typename T, std::size_t S>
+class FixedVector : public ContainerTelemetry {
+    private:
+        std::array<T, S> items;
+        std::size_t count = 0;
+
+    public:
+        bool add(T &item) {
+            if (count >= S) {
+                drops++;
+                return false;
+            }
+            items[count++] = item;
+            track(count);
+            return true;
+        }
+
+        bool add(T &&item) {
+            return add(item);
+        }
+
+        // Swap-removes, the caller has to look at index again
+        void removeAt(std::size_t index) {
+            items[index] = items[--count];
+        }
+
+        void clear() { count = 0; }
+
+        std::size_t size() const { return count; }
+        T &operator[](std::size_t index) { return items[index]; }
+
+        T *begin() { return items.data(); }
+        T *end() { return items.data() + count; }
+
+        ContainerStats stats() const { return makeStats(count, S); }
+};
+
+// FIFO that evicts its oldest entry when full, for effects that fade out anyways
+template<typename T, std::size_t S>
+class RingBuffer : public ContainerTelemetry {
+    private:
+        std::array<T, S> items;
+        std::size_t head = 0;
+        std::size_t count = 0;
+
+    public:
+        void add(T &item) {
+            if (count >= S) {
+                drops++;
+                popFront();
+            }
+            items[(head + count++) % S] = item;
+            track(count);
+        }
+
+        void add(T &&item) {
+            add(item);
+        }
+
+        void popFront() {
+            head = (head + 1) % S;
+            count--;
+        }
+
+        void clear() {
+            head = 0;
+            count = 0;
+        }
+
+        std::size_t size() const { return count; }
+        // 0 is the oldest entry
+        T &operator[](std::size_t index) { return items[(head + index) % S]; }
+        T &front() { return items[head]; }
+
+        ContainerStats stats() const { return makeStats(count, S); }
+};
+
+/**
+ * Objects stay in their slot for their whole life (they may own per-slot resources),
+ * iteration goes through a dense list of live slots.
+ * Handles carry a generation, so a stale handle never resolves to a reused slot.
+ */
+template<typename T, std::size_t S>
+class SlotMap : public ContainerTelemetry {
+    static_assert(S < UINT16_MAX, "SlotMap indices are 16 bit");
+
+    public:
+        struct Handle {
+            uint16_t slot = UINT16_MAX;
+            uint16_t generation = 0;
+
+            bool isValid() const { return slot != UINT16_MAX; }
+        };
+
+    private:
+        std::array<T, S> slots;
+        // Bumped every time a slot is freed. It wraps after 65536 reuses of the same slot, so a handle
+        // kept that long would resolve again. Handles are only meant to be held for a few frames.
+        std::array<uint16_t, S> generations {};
+        // Live slots, followed by the free ones
+        std::array<uint16_t, S> dense;
+        // Position of each slot in dense
+        std::array<uint16_t, S> denseIndex;
+        std::size_t count = 0;
+
+    public:
+        SlotMap() {
+            for (std::size_t i = 0; i < S; i++) {
+                dense[i] = i;
+                denseIndex[i] = i;
+            }
+        }
+
+        Handle add(T &item) {
+            if (count >= S) {
+                drops++;
+                return Handle {};
+            }
+            uint16_t slot = dense[count++];
+            slots[slot] = item;
+            track(count);
+            return Handle {slot, generations[slot]};
+        }
+
+        Handle add(T &&item) {
+            return add(item);
+        }
+
+        T *get(Handle handle) {
+            if (!handle.isValid() || generations[handle.slot] != handle.generation) return nullptr;
+            if (denseIndex[handle.slot] >= count) return nullptr;
+            return &slots[handle.slot];
+        }
+
+        // Removes the index-th live object, the last live one takes its index
+        void removeAt(std::size_t index) {
+            uint16_t slot = dense[index];
+            uint16_t last = dense[--count];
+
+            dense[index] = last;
+            denseIndex[last] = index;
+            dense[count] = slot;
+            denseIndex[slot] = count;
+            generations[slot]++;
+        }
+
+        void remove(Handle handle) {
+            if (get(handle)) removeAt(denseIndex[handle.slot]);
+        }
+
+        void clear() {
+            for (std::size_t i = 0; i < count; i++) generations[dense[i]]++;
+            count = 0;
+        }
+
+        std::size_t size() const { return count; }
+        // index-th live object, in no particular order
+        T &operator[](std::size_t index) { return slots[dense[index]]; }
+
+        ContainerStats stats() const { return makeStats(count, S); }
+};
+
+#endif // __CONTAINERS_H
@@ -94,6 +94,13 @@ void Game::render(float deltaTime) {
     }
     uiRenderer->render(state, viewport, deltaTime);
 
+    if (DebugContainers) {
+        uiRenderer->renderContainerStats(0, "bullets", gameplayController.getBulletStats());
+        uiRenderer->renderContainerStats(1, "splashes", mapRenderer->getSplashStats());
+        uiRenderer->renderContainerStats(2, "steps", mapRenderer->getFootstepStats());
+        uiRenderer->renderContainerStats(3, "hits", uiRenderer->getHitStats());
+    }
+
     rdpq_detach_show();
 
     heap_stats_t heap_stats;
@@ -176,7 +176,7 @@ void GameplayController::render(float deltaTime, T3DViewport &viewport, GameStat
                 dir = RIGHT;
             }
         } else {
-            dir = ai.calculateFireDirection(player, deltaTime, playerData, state);
+            dir = ai.calculateFireDirection(player, id, deltaTime, playerData, state, threats);
         }
 
         if (state.state == STATE_GAME || state.state == STATE_LAST_ONE_STANDING) handleFire(player, id, dir);
@@ -205,6 +205,15 @@ void GameplayController::renderUI()
 
 void GameplayController::fixedUpdate(float deltaTime, GameState &state)
 {
+    // Project all players and bullets once, every AI reads from this
+    threats.clear();
+    for (auto& player : playerData)
+    {
+        threats.addPlayer(player.pos, player.velocity, player.team, player.firstHit);
+    }
+    bulletController.gatherThreats(threats);
+    threats.update();
+
     uint32_t id = 0;
     for (auto& player : playerData)
     {
@@ -214,7 +223,7 @@ void GameplayController::fixedUpdate(float deltaTime, GameState &state)
             direction.v[0] = (float)joypad.stick_x;
             direction.v[2] = -(float)joypad.stick_y;
         } else {
-            ai.calculateMovement(player, deltaTime, playerData, state, direction);
+            ai.calculateMovement(player, id, deltaTime, playerData, state, threats, direction);
         }
         simulatePhysics(player, id, deltaTime, direction);
         id++;
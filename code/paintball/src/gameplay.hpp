@@ -44,6 +44,7 @@ class GameplayController
         // Controllers
         std::shared_ptr<MapRenderer> map;
         AI ai;
+        ThreatModel threats;
 
         // Player calculations
         void simulatePhysics(
@@ -58,6 +59,7 @@ class GameplayController
         GameplayController(std::shared_ptr<MapRenderer> map, std::shared_ptr<UIRenderer> ui);
         void newRound();
         const std::vector<Player> &getPlayerData() const;
+        ContainerStats getBulletStats() const { return bulletController.getStats(); }
 
         void render(float deltaTime, T3DViewport &viewport, GameState &state);
         void renderUI();
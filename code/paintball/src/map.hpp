@@ -13,7 +13,7 @@
 
 #include "./constants.hpp"
 #include "./wrappers.hpp"
-#include "./list.hpp"
+#include "./containers.hpp"
 #include "./common.hpp"
 
 #include "../../../core.h"
@@ -47,8 +47,8 @@ class MapRenderer
 
         // Assume all players firing in all possible directions
         // in reality, they can pop in subticks but should be fine
-        List<Splash, PlayerCount * 4> newSplashes;
-        List<Splash, PlayerCount> newFootsteps;
+        FixedVector<Splash, PlayerCount * 4> newSplashes;
+        FixedVector<Splash, PlayerCount> newFootsteps;
 
         T3DVertPacked* vertices;
 
@@ -65,6 +65,9 @@ class MapRenderer
         void step(float x, float y, PlyNum team, float direction, bool firstStep);
         float getHalfSize();
         void setSize(float size);
+
+        ContainerStats getSplashStats() const { return newSplashes.stats(); }
+        ContainerStats getFootstepStats() const { return newFootsteps.stats(); }
 };
 
 #endif // __MAP_H
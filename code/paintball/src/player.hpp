@@ -17,7 +17,6 @@
 
 #include "wrappers.hpp"
 #include "constants.hpp"
-#include "list.hpp"
 #include "bullet.hpp"
 #include "map.hpp"
 
@@ -83,7 +82,6 @@ class Player
         bool firstStep;
 
         // AI
-        List<::Bullet, 4> incomingBullets;
         AIState aiState;
         float multiplier;
         float multiplier2;
@@ -0,0 +1,138 @@
+#include "threat.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+static_assert(ThreatBulletLimit >= BulletLimit, "Threat model can't hold every bullet");
+
+// A bullet fired now falls for this long before it hits the ground
+static const float BulletFlightTime = sqrtf(2.f * BulletHeight / -Gravity);
+
+ThreatModel::ThreatModel() {
+    clear();
+}
+
+void ThreatModel::clear() {
+    playerCount = 0;
+    bulletCount = 0;
+}
+
+void ThreatModel::addPlayer(const T3DVec3 &pos, const T3DVec3 &velocity, PlyNum team, PlyNum firstHit) {
+    assertf(playerCount < PlayerCount, "Too many players in threat model");
+    int i = playerCount++;
+    playerX[i] = pos.v[0];
+    playerZ[i] = pos.v[2];
+    playerVelX[i] = velocity.v[0];
+    playerVelZ[i] = velocity.v[2];
+    playerTeam[i] = team;
+    playerFirstHit[i] = firstHit;
+}
+
+void ThreatModel::addBullet(const T3DVec3 &pos, const T3DVec3 &velocity, PlyNum owner, PlyNum team) {
+    if (bulletCount >= ThreatBulletLimit) return;
+    int i = bulletCount++;
+    bulletX[i] = pos.v[0];
+    bulletZ[i] = pos.v[2];
+    bulletVelX[i] = velocity.v[0];
+    bulletVelZ[i] = velocity.v[2];
+    bulletOwner[i] = owner;
+    bulletTeam[i] = team;
+
+    // Solve pos.y + vy*t + g/2*t^2 = 0
+    float vy = velocity.v[1];
+    float disc = vy * vy - 2.f * Gravity * std::max(pos.v[1], 0.f);
+    bulletLifetime[i] = (vy + sqrtf(disc)) / -Gravity;
+}
+
+bool ThreatModel::isTarget(int shooter, int target) const {
+    if (shooter == target) return false;
+    // Already at full health
+    return !(playerTeam[target] == playerTeam[shooter] && playerFirstHit[target] == playerTeam[shooter]);
+}
+
+void ThreatModel::update() {
+    solveDodge();
+    solveAim();
+}
+
+void ThreatModel::solveDodge() {
+    for (int p = 0; p < playerCount; p++) {
+        float px = playerX[p];
+        float pz = playerZ[p];
+        float pvx = playerVelX[p];
+        float pvz = playerVelZ[p];
+        PlyNum team = playerTeam[p];
+
+        float dodgeX = 0.f;
+        float dodgeZ = 0.f;
+        for (int b = 0; b < bulletCount; b++) {
+            if (bulletTeam[b] == team || bulletOwner[b] == p) continue;
+
+            // Bullet motion relative to the player, both keep their current velocity
+            float dx = px - bulletX[b];
+            float dz = pz - bulletZ[b];
+            float wx = bulletVelX[b] - pvx;
+            float wz = bulletVelZ[b] - pvz;
+
+            float w2 = wx * wx + wz * wz;
+            if (w2 == 0.f) [[unlikely]] continue;
+
+            // Time of closest approach, clamped to what the bullet can still fly
+            float horizon = std::min(ThreatHorizon, bulletLifetime[b]);
+            float t = (dx * wx + dz * wz) / w2;
+            t = std::clamp(t, 0.f, horizon);
+
+            float cx = dx - wx * t;
+            float cz = dz - wz * t;
+            float c2 = cx * cx + cz * cz;
+            if (c2 >= ThreatDodgeRadius * ThreatDodgeRadius) continue;
+
+            float urgency = 1.f - t / ThreatHorizon;
+            if (c2 > 0.f) {
+                float scale = urgency / sqrtf(c2);
+                dodgeX += cx * scale;
+                dodgeZ += cz * scale;
+            } else {
+                // Dead center, step to the side of the bullet's path
+                float scale = urgency / sqrtf(w2);
+                dodgeX += -wz * scale;
+                dodgeZ += wx * scale;
+            }
+        }
+        dodge[p] = T3DVec3 {dodgeX, 0.f, dodgeZ};
+    }
+}
+
+void ThreatModel::solveAim() {
+    for (int s = 0; s < playerCount; s++) {
+        for (int t = 0; t < playerCount; t++) {
+            FiringSolution &best = aim[s][t];
+            best = FiringSolution {Direction::NONE, 0.f, 0.f};
+            if (s == t) continue;
+
+            float dx = playerX[t] - playerX[s];
+            float dz = playerZ[t] - playerZ[s];
+            float vx = playerVelX[t];
+            float vz = playerVelZ[t];
+
+            // Along an axis the bullet closes in at BulletVelocity minus the target's speed on it,
+            // the miss is where the target drifted to on the other axis by then
+            auto tryAxis = [&](Direction dir, float along, float alongVel, float across, float acrossVel, float sign) {
+                float closing = sign * BulletVelocity - alongVel;
+                if (closing == 0.f) return;
+                float time = along / closing;
+                if (time <= 0.f || time > BulletFlightTime) return;
+
+                float miss = std::abs(across + acrossVel * time);
+                if (best.direction == Direction::NONE || miss < best.miss) {
+                    best = FiringSolution {dir, time, miss};
+                }
+            };
+
+            tryAxis(Direction::UP, dz, vz, dx, vx, -1.f);
+            tryAxis(Direction::DOWN, dz, vz, dx, vx, 1.f);
+            tryAxis(Direction::LEFT, dx, vx, dz, vz, -1.f);
+            tryAxis(Direction::RIGHT, dx, vx, dz, vz, 1.f);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef __THREAT_H
+#define __THREAT_H
+
+#include <t3d/t3dmath.h>
+
+#include <array>
+
+#include "../../../core.h"
+#include "common.hpp"
+#include "constants.hpp"
+
+// Bullet slots tracked per tick, matches BulletController's list
+constexpr int ThreatBulletLimit = 100;
+// How far ahead bullets are projected for dodging
+constexpr float ThreatHorizon = 0.6f;
+// Bullets passing closer than this are worth dodging
+constexpr float ThreatDodgeRadius = PlayerRadius * 2.f;
+
+struct FiringSolution
+{
+    Direction direction;
+    // Seconds until the bullet reaches the target
+    float time;
+    // Distance the target will be off the bullet's path at that time
+    float miss;
+};
+
+/**
+ * Per tick view of all players and bullets shared by every AI.
+ * Everything is projected once in update(), the AIs only read the results.
+ */
+class ThreatModel
+{
+    private:
+        // Players
+        std::array<float, PlayerCount> playerX;
+        std::array<float, PlayerCount> playerZ;
+        std::array<float, PlayerCount> playerVelX;
+        std::array<float, PlayerCount> playerVelZ;
+        std::array<PlyNum, PlayerCount> playerTeam;
+        std::array<PlyNum, PlayerCount> playerFirstHit;
+        int playerCount;
+
+        // Bullets
+        std::array<float, ThreatBulletLimit> bulletX;
+        std::array<float, ThreatBulletLimit> bulletZ;
+        std::array<float, ThreatBulletLimit> bulletVelX;
+        std::array<float, ThreatBulletLimit> bulletVelZ;
+        // Seconds until the bullet hits the ground
+        std::array<float, ThreatBulletLimit> bulletLifetime;
+        std::array<PlyNum, ThreatBulletLimit> bulletTeam;
+        std::array<PlyNum, ThreatBulletLimit> bulletOwner;
+        int bulletCount;
+
+        // Results
+        std::array<T3DVec3, PlayerCount> dodge;
+        std::array<std::array<FiringSolution, PlayerCount>, PlayerCount> aim;
+
+        void solveDodge();
+        void solveAim();
+
+    public:
+        ThreatModel();
+
+        void clear();
+        void addPlayer(const T3DVec3 &pos, const T3DVec3 &velocity, PlyNum team, PlyNum firstHit);
+        void addBullet(const T3DVec3 &pos, const T3DVec3 &velocity, PlyNum owner, PlyNum team);
+        void update();
+
+        // Sum of the escape directions away from every bullet about to pass close by, weighted by urgency
+        const T3DVec3 &getDodge(int player) const { return dodge[player]; }
+        // Best way for shooter to hit target right now, direction is NONE if no shot can reach it
+        const FiringSolution &getFiringSolution(int shooter, int target) const { return aim[shooter][target]; }
+        // Whether shooting at target does anything, teammates at full health can't be hit
+        bool isTarget(int shooter, int target) const;
+};
+
+#endif // __THREAT_H
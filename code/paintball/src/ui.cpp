@@ -197,12 +197,13 @@ void UIRenderer::renderHitMarks(T3DViewport &viewport, float deltaTime) {
         PLAYERCOLOR_4,
     };
 
-    for (auto hit = hits.begin(); hit != hits.end(); ++hit) {
-        if (hit->lifetime <= 0.) {
-            hits.remove(hit);
-            continue;
-        }
+    // Every mark lives equally long, so expired ones are always the oldest
+    while (hits.size() > 0 && hits.front().lifetime <= 0.) {
+        hits.popFront();
+    }
 
+    for (std::size_t i = 0; i < hits.size(); i++) {
+        HitMark *hit = &hits[i];
         hit->lifetime -= deltaTime;
 
         T3DVec3 screenPos;
@@ -230,4 +231,10 @@ void UIRenderer::renderHitMarks(T3DViewport &viewport, float deltaTime) {
 
 void UIRenderer::registerHit(const HitMark &hit) {
     hits.add(HitMark {hit.pos, hit.team, 0.1f});
-}
\ No newline at end of file
+}
+
+void UIRenderer::renderContainerStats(int row, const char *name, const ContainerStats &stats) {
+    rdpq_textparms_t textparms = { .style_id = 4 };
+    rdpq_text_printf(&textparms, SmallFont, 16, 24 + row * 12, "%s %u/%u max %u drop %lu",
+        name, (unsigned)stats.count, (unsigned)stats.capacity, (unsigned)stats.highWater, (unsigned long)stats.drops);
+}
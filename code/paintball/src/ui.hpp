@@ -6,7 +6,7 @@
 #include "./wrappers.hpp"
 #include "./constants.hpp"
 #include "./gamestate.hpp"
-#include "./list.hpp"
+#include "./containers.hpp"
 
 #include "../../../minigame.h"
 
@@ -31,7 +31,7 @@ class UIRenderer
         U::Sprite splash1;
         U::Sprite splash2;
 
-        List<HitMark, PlayerCount * 4> hits;
+        RingBuffer<HitMark, PlayerCount * 4> hits;
 
         Wav64 sfxCountdown;
         int prevCountdown;
@@ -47,6 +47,8 @@ class UIRenderer
         void render(GameState &state, T3DViewport &viewport, float deltaTime);
 
         void registerHit(const HitMark &hit);
+        ContainerStats getHitStats() const { return hits.stats(); }
+        void renderContainerStats(int row, const char *name, const ContainerStats &stats);
 };
 
 #endif // __UI_HPP
\ No newline at end of file
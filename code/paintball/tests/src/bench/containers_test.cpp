@@ -0,0 +1,113 @@
+// Checks the ordering and bookkeeping of the fixed capacity containers.
+// Covers ring eviction order, swap removal, stale slot map handles and the drop and high water counters.
+
+#include <cstdio>
+
+#include "../../../src/containers.hpp"
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (!condition) {
+        printf("  failed: %s\n", what);
+        failures++;
+    }
+}
+
+static void checkFixedVector() {
+    FixedVector<int, 4> vector;
+    for (int i = 0; i < 4; i++) vector.add(i);
+    check(!vector.add(4), "a full vector rejects new items");
+    check(vector.size() == 4, "a rejected item isn't stored");
+
+    // [0 1 2 3] -> [0 3 2]
+    vector.removeAt(1);
+    check(vector.size() == 3, "removeAt shrinks the vector");
+    check(vector[0] == 0 && vector[1] == 3 && vector[2] == 2, "removeAt swaps the last item in");
+
+    // removing the last item doesn't move anything
+    vector.removeAt(2);
+    check(vector.size() == 2 && vector[0] == 0 && vector[1] == 3, "removing the last item keeps the others");
+
+    ContainerStats stats = vector.stats();
+    check(stats.count == 2 && stats.capacity == 4, "stats report count and capacity");
+    check(stats.highWater == 4, "the high water mark stays at the most items held");
+    check(stats.drops == 1, "every rejected item is counted as a drop");
+
+    vector.clear();
+    check(vector.size() == 0 && vector.begin() == vector.end(), "clear empties the vector");
+    check(vector.stats().highWater == 4 && vector.stats().drops == 1, "clear keeps the counters");
+}
+
+static void checkRingBuffer() {
+    RingBuffer<int, 3> ring;
+    ring.add(1);
+    ring.add(2);
+    check(ring.size() == 2 && ring.front() == 1, "front is the oldest entry");
+
+    ring.add(3);
+    ring.add(4);
+    ring.add(5);
+    check(ring.size() == 3, "a full ring keeps its capacity");
+    check(ring[0] == 3 && ring[1] == 4 && ring[2] == 5, "a full ring evicts its oldest entries first");
+    check(ring.stats().drops == 2, "every eviction is counted as a drop");
+    check(ring.stats().highWater == 3, "the high water mark stops at the capacity");
+
+    ring.popFront();
+    check(ring.size() == 2 && ring.front() == 4, "popFront removes the oldest entry");
+
+    // wraps around the end of the storage
+    ring.add(6);
+    ring.add(7);
+    check(ring[0] == 5 && ring[1] == 6 && ring[2] == 7, "order is kept across the end of the storage");
+
+    ring.clear();
+    ring.add(8);
+    check(ring.size() == 1 && ring.front() == 8, "a cleared ring starts over");
+}
+
+static void checkSlotMap() {
+    using Map = SlotMap<int, 4>;
+    Map map;
+    Map::Handle a = map.add(10);
+    Map::Handle b = map.add(20);
+    Map::Handle c = map.add(30);
+    check(map.get(b) && *map.get(b) == 20, "a handle resolves to its object");
+
+    map.remove(a);
+    check(map.get(a) == nullptr, "a removed handle doesn't resolve");
+    check(map.size() == 2 && map[0] == 30 && map[1] == 20, "the last live object takes the removed index");
+    check(map.get(c) && *map.get(c) == 30, "moving in the dense list keeps the handle valid");
+
+    // the freed slot is handed out again, the old handle still may not see it
+    Map::Handle d = map.add(40);
+    check(d.slot == a.slot, "a freed slot is reused");
+    check(map.get(a) == nullptr, "a stale handle doesn't resolve to the reused slot");
+    check(map.get(d) && *map.get(d) == 40, "the new handle resolves to the reused slot");
+
+    map.remove(a);
+    check(map.size() == 3 && map.get(d), "removing through a stale handle does nothing");
+
+    map.add(50);
+    check(!map.add(60).isValid(), "a full map returns an invalid handle");
+    check(map.get(Map::Handle {}) == nullptr, "an invalid handle doesn't resolve");
+
+    ContainerStats stats = map.stats();
+    check(stats.drops == 1 && stats.highWater == 4, "the map counts drops and its high water mark");
+
+    map.clear();
+    check(map.size() == 0, "clear empties the map");
+    check(!map.get(b) && !map.get(c) && !map.get(d), "clear invalidates every handle");
+
+    Map::Handle e = map.add(70);
+    check(map.get(e) && !map.get(b) && !map.get(c) && !map.get(d), "handles from before clear stay stale once slots are reused");
+}
+
+int main() {
+    checkFixedVector();
+    checkRingBuffer();
+    checkSlotMap();
+
+    printf("containers_test: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+// Times a full ThreatModel tick (clear, gather, update) with every bullet slot in use.
+// A few fixed scenes are checked first, so the timing is of a model that gives sane answers.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../../src/threat.hpp"
+
+constexpr int WarmupTicks = 1000;
+constexpr int BenchTicks = 100000;
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (!condition) {
+        printf("  failed: %s\n", what);
+        failures++;
+    }
+}
+
+static void addPlayers(ThreatModel &model) {
+    model.addPlayer(T3DVec3 {0, 0, 0}, T3DVec3 {0, 0, 0}, PLAYER_1, PLAYER_1);
+    model.addPlayer(T3DVec3 {0, 0, -100}, T3DVec3 {SpeedLimit, 0, 0}, PLAYER_2, PLAYER_2);
+    model.addPlayer(T3DVec3 {100, 0, 0}, T3DVec3 {0, 0, 0}, PLAYER_3, PLAYER_3);
+    model.addPlayer(T3DVec3 {0, 0, 100}, T3DVec3 {0, 0, 0}, PLAYER_4, PLAYER_4);
+}
+
+static void checkScenes() {
+    ThreatModel model;
+
+    // Bullet from the left passing just in front of player 1
+    addPlayers(model);
+    model.addBullet(T3DVec3 {-50, BulletHeight, 2}, T3DVec3 {BulletVelocity, 0, 0}, PLAYER_3, PLAYER_3);
+    model.update();
+    check(model.getDodge(0).v[2] < 0.f, "player 1 dodges away from a bullet passing in front");
+    check(model.getDodge(2).v[0] == 0.f && model.getDodge(2).v[2] == 0.f, "the owner doesn't dodge its own bullet");
+
+    // Player 3 stands still straight to the right of player 1
+    const FiringSolution &right = model.getFiringSolution(0, 2);
+    check(right.direction == Direction::RIGHT, "shoots right at a target standing to the right");
+    check(right.miss == 0.f, "a standing target is hit dead on");
+    check(std::abs(right.time - 100.f / BulletVelocity) < 0.001f, "time to impact is distance over bullet speed");
+
+    // Player 2 runs sideways, the shot has to pick the axis with the smallest drift
+    const FiringSolution &moving = model.getFiringSolution(0, 1);
+    check(moving.direction == Direction::UP, "shoots up at a target running across above");
+    check(moving.miss > 0.f, "a running target drifts off the shot's path");
+
+    // Teammates at full health aren't targets
+    model.clear();
+    model.addPlayer(T3DVec3 {0, 0, 0}, T3DVec3 {0, 0, 0}, PLAYER_1, PLAYER_1);
+    model.addPlayer(T3DVec3 {50, 0, 0}, T3DVec3 {0, 0, 0}, PLAYER_1, PLAYER_1);
+    model.update();
+    check(!model.isTarget(0, 1), "a teammate at full health is not a target");
+
+    // Bullets that hit the ground before passing by are ignored
+    model.clear();
+    addPlayers(model);
+    model.addBullet(T3DVec3 {-150, 1, 0}, T3DVec3 {BulletVelocity, 0, 0}, PLAYER_3, PLAYER_3);
+    model.update();
+    check(model.getDodge(0).v[0] == 0.f && model.getDodge(0).v[2] == 0.f, "a bullet about to land is not dodged");
+}
+
+// Same spread of bullets every tick, as gatherThreats fills the model from the bullet list
+static void fillTick(ThreatModel &model, int tick) {
+    model.clear();
+    addPlayers(model);
+    for (int i = 0; i < ThreatBulletLimit; i++) {
+        float offset = (float)((i * 37 + tick) % 200) - 100.f;
+        T3DVec3 pos {offset, BulletHeight, (float)(i % 20) * 10.f - 100.f};
+        T3DVec3 velocity = i % 2 ? T3DVec3 {BulletVelocity, 0, 0} : T3DVec3 {0, 0, -BulletVelocity};
+        model.addBullet(pos, velocity, (PlyNum)(i % PlayerCount), (PlyNum)(i % PlayerCount));
+    }
+}
+
+int main() {
+    checkScenes();
+
+    ThreatModel model;
+    // Keeps the results alive so the work isn't optimized out
+    volatile float sink = 0.f;
+
+    for (int tick = 0; tick < WarmupTicks; tick++) {
+        fillTick(model, tick);
+        model.update();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < BenchTicks; tick++) {
+        fillTick(model, tick);
+        model.update();
+        sink = sink + model.getDodge(tick % PlayerCount).v[0] + model.getFiringSolution(0, 1 + tick % 3).time;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double perTick = std::chrono::duration<double, std::micro>(end - start).count() / BenchTicks;
+    printf("threat model, %d players and %d bullets: %.2f us per tick\n", PlayerCount, ThreatBulletLimit, perTick);
+    printf("threat_bench: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
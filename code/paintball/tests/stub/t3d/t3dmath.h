@@ -0,0 +1,13 @@
+// Minimal host stand-in for the tiny3d math types used by the benchmarked sources
+#ifndef __TEST_STUB_T3DMATH_H__
+#define __TEST_STUB_T3DMATH_H__
+
+#include <math.h>
+// the real header pulls in libdragon too, headers after it rely on that
+#include <libdragon.h>
+
+typedef struct {
+  float v[3];
+} T3DVec3;
+
+#endif
@@ -71,6 +71,7 @@ void bullet_init(struct Bullet* bullet, int collision_group) {
 
     bullet->dynamic_object.collision_group = collision_group;
     bullet->dynamic_object.has_gravity = 0;
+    bullet->dynamic_object.has_ccd = 1;
     bullet->last_hit_by = 0;
     health_register(entity_id, &bullet->health, rampage_bullet_damage, bullet);
 }
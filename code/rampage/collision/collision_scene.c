@@ -7,6 +7,7 @@
 
 #include "collide.h"
 #include "contact.h"
+#include "raycast.h"
 #include "../util/hash_map.h"
 
 struct collision_scene g_scene;
@@ -15,6 +16,8 @@ void collision_scene_init() {
     hash_map_init(&g_scene.entity_mapping, MIN_DYNAMIC_OBJECTS);
 
     g_scene.elements = malloc(sizeof(struct collision_scene_element) * MIN_DYNAMIC_OBJECTS);
+    g_scene.sorted_objects = malloc(sizeof(struct dynamic_object*) * MIN_DYNAMIC_OBJECTS);
+    g_scene.max_width = 0.0f;
     g_scene.capacity = MIN_DYNAMIC_OBJECTS;
     g_scene.count = 0;
     g_scene.all_contacts = malloc(sizeof(struct contact) * MAX_ACTIVE_CONTACTS);
@@ -29,20 +32,101 @@ void collision_scene_init() {
 
 void collision_scene_destroy() {
     free(g_scene.elements);
+    free(g_scene.sorted_objects);
     free(g_scene.all_contacts);
     hash_map_destroy(&g_scene.entity_mapping);
 }
 
+// first index in sorted_objects with bounding_box.min.x >= x
+static int collision_scene_sorted_lower_bound(float x) {
+    int start = 0;
+    int end = g_scene.count;
+
+    while (start < end) {
+        int mid = (start + end) >> 1;
+
+        if (g_scene.sorted_objects[mid]->bounding_box.min.x < x) {
+            start = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+
+    return start;
+}
+
+static void collision_scene_sorted_insert(struct dynamic_object* object) {
+    int index = collision_scene_sorted_lower_bound(object->bounding_box.min.x);
+
+    for (int i = g_scene.count; i > index; --i) {
+        g_scene.sorted_objects[i] = g_scene.sorted_objects[i - 1];
+    }
+
+    g_scene.sorted_objects[index] = object;
+
+    float width = object->bounding_box.max.x - object->bounding_box.min.x;
+
+    if (width > g_scene.max_width) {
+        g_scene.max_width = width;
+    }
+}
+
+static void collision_scene_sorted_remove(struct dynamic_object* object) {
+    bool has_found = false;
+
+    for (int i = 0; i < g_scene.count; ++i) {
+        if (object == g_scene.sorted_objects[i]) {
+            has_found = true;
+        }
+
+        if (has_found && i + 1 < g_scene.count) {
+            g_scene.sorted_objects[i] = g_scene.sorted_objects[i + 1];
+        }
+    }
+}
+
+// bounding boxes only change in collision_scene_collide and the order barely
+// changes between frames, so an insertion sort is close to a single pass
+static void collision_scene_sort_objects() {
+    float max_width = 0.0f;
+
+    for (int i = 0; i < g_scene.count; ++i) {
+        struct dynamic_object* object = g_scene.sorted_objects[i];
+        float min_x = object->bounding_box.min.x;
+        int j = i;
+
+        while (j > 0 && g_scene.sorted_objects[j - 1]->bounding_box.min.x > min_x) {
+            g_scene.sorted_objects[j] = g_scene.sorted_objects[j - 1];
+            --j;
+        }
+
+        g_scene.sorted_objects[j] = object;
+
+        float width = object->bounding_box.max.x - min_x;
+
+        if (width > max_width) {
+            max_width = width;
+        }
+    }
+
+    g_scene.max_width = max_width;
+}
+
 void collision_scene_add(struct dynamic_object* object) {
     if (g_scene.count >= g_scene.capacity) {
         g_scene.capacity *= 2;
         g_scene.elements = realloc(g_scene.elements, sizeof(struct collision_scene_element) * g_scene.capacity);
+        g_scene.sorted_objects = realloc(g_scene.sorted_objects, sizeof(struct dynamic_object*) * g_scene.capacity);
     }
 
     struct collision_scene_element* next = &g_scene.elements[g_scene.count];
 
     next->object = object;
 
+    // the object may have been moved since it was last in the scene
+    dynamic_object_recalc_bb(object);
+    collision_scene_sorted_insert(object);
+
     g_scene.count += 1;
 
     hash_map_set(&g_scene.entity_mapping, object->entity_id, object);
@@ -74,6 +158,8 @@ void collision_scene_return_contacts(struct dynamic_object* object) {
 void collision_scene_remove(struct dynamic_object* object) {
     bool has_found = false;
 
+    collision_scene_sorted_remove(object);
+
     for (int i = 0; i < g_scene.count; ++i) {
         if (object == g_scene.elements[i].object) {
             collision_scene_return_contacts(object);
@@ -202,7 +288,39 @@ void collision_scene_collide_dynamic() {
     }
 }
 
-#define MAX_SWEPT_ITERATIONS    5
+// how far a swept object is pushed past the first hit so
+// the discrete pass sees the overlap and creates the contact
+#define CCD_SKIN    1.0f
+
+// returns true if the object hit something along its path, swept_pos is where it should be moved to
+// the object itself is left at its end position so the sorted order stays valid for the other casts
+bool collision_scene_sweep_single(struct dynamic_object* object, struct Vector3* prev_pos, struct Vector3* swept_pos) {
+    struct Vector3 end_pos = object->position;
+    struct Vector3 dir;
+    vector3Sub(&end_pos, prev_pos, &dir);
+
+    float distance_sqrd = vector3MagSqrd(&dir);
+
+    if (distance_sqrd < CCD_SKIN * CCD_SKIN) {
+        return false;
+    }
+
+    float distance = sqrtf(distance_sqrd);
+    vector3Scale(&dir, &dir, 1.0f / distance);
+
+    struct RaycastHit hit;
+    object->position = *prev_pos;
+    bool did_hit = collision_shape_cast(object, &dir, distance, object->collision_layers, &hit);
+    object->position = end_pos;
+
+    if (!did_hit || hit.distance + CCD_SKIN >= distance) {
+        return false;
+    }
+
+    vector3AddScaled(prev_pos, &dir, hit.distance + CCD_SKIN, swept_pos);
+
+    return true;
+}
 
 void collision_scene_collide_single(struct dynamic_object* object, struct Vector3* prev_pos) {
     collide_object_to_world(object);
@@ -222,6 +340,34 @@ void collision_scene_collide(float fixed_time_step) {
         dynamic_object_recalc_bb(element->object);
     }
 
+    collision_scene_sort_objects();
+
+    // every cast runs against the end positions, swept objects are only moved
+    // once all casts are done since the casts rely on the sorted bounding boxes
+    struct Vector3 swept_pos[g_scene.count];
+    bool did_sweep[g_scene.count];
+    bool any_sweep = false;
+
+    for (int i = 0; i < g_scene.count; ++i) {
+        struct dynamic_object* object = g_scene.elements[i].object;
+
+        did_sweep[i] = object->has_ccd && !object->is_trigger && !object->is_fixed &&
+            collision_scene_sweep_single(object, &prev_pos[i], &swept_pos[i]);
+        any_sweep |= did_sweep[i];
+    }
+
+    if (any_sweep) {
+        for (int i = 0; i < g_scene.count; ++i) {
+            if (did_sweep[i]) {
+                struct dynamic_object* object = g_scene.elements[i].object;
+                object->position = swept_pos[i];
+                dynamic_object_recalc_bb(object);
+            }
+        }
+
+        collision_scene_sort_objects();
+    }
+
     collision_scene_collide_dynamic();
 
     for (int i = 0; i < g_scene.count; ++i) {
@@ -230,7 +376,12 @@ void collision_scene_collide(float fixed_time_step) {
         collision_scene_collide_single(element->object, &prev_pos[i]);
 
         element->object->is_out_of_bounds = 0;
+
+        // queries between frames should see the corrected position
+        dynamic_object_recalc_bb(element->object);
     }
+
+    collision_scene_sort_objects();
 }
 
 struct contact* collision_scene_new_contact() {
@@ -265,26 +416,54 @@ void collision_scene_query(struct dynamic_object_type* shape, struct Vector3* ce
     positioned_shape.type = shape;
     positioned_shape.center = center;
 
-    for (int i = 0; i < g_scene.count; ++i) {
-        struct collision_scene_element* element = &g_scene.elements[i];
+    int end = g_scene.count;
+
+    for (int i = collision_scene_sorted_lower_bound(bounding_box.min.x - g_scene.max_width); i < end; ++i) {
+        struct dynamic_object* object = g_scene.sorted_objects[i];
 
-        if (!(element->object->collision_layers & collision_layers)) {
+        if (object->bounding_box.min.x > bounding_box.max.x) {
+            break;
+        }
+
+        if (!(object->collision_layers & collision_layers)) {
             continue;
         }
 
-        if (!box3DHasOverlap(&bounding_box, &element->object->bounding_box)) {
+        if (!box3DHasOverlap(&bounding_box, &object->bounding_box)) {
             continue;
         }
 
         struct Simplex simplex;
 
         struct Vector3 first_dir;
-        vector3Sub(center, &element->object->position, &first_dir);
+        vector3Sub(center, &object->position, &first_dir);
 
-        if (!gjkCheckForOverlap(&simplex, &positioned_shape, positioned_shape_mink_sum, element->object, dynamic_object_minkowski_sum, &first_dir)) {
+        if (!gjkCheckForOverlap(&simplex, &positioned_shape, positioned_shape_mink_sum, object, dynamic_object_minkowski_sum, &first_dir)) {
             continue;;
         }
 
-        callback(callback_data, element->object);
+        callback(callback_data, object);
+    }
+}
+
+void collision_scene_query_box(struct Box3D* box, int collision_layers, collision_scene_query_callback callback, void* callback_data) {
+    int end = g_scene.count;
+
+    for (int i = collision_scene_sorted_lower_bound(box->min.x - g_scene.max_width); i < end; ++i) {
+        struct dynamic_object* object = g_scene.sorted_objects[i];
+
+        if (object->bounding_box.min.x > box->max.x) {
+            break;
+        }
+
+        if (!(object->collision_layers & collision_layers)) {
+            continue;
+        }
+
+        if (!box3DHasOverlap(box, &object->bounding_box)) {
+            continue;
+        }
+
+        callback(callback_data, object);
     }
 }
\ No newline at end of file
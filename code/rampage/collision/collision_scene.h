@@ -16,6 +16,9 @@ struct collision_scene_element {
 
 struct collision_scene {
     struct collision_scene_element* elements;
+    // same objects as elements, kept sorted by bounding_box.min.x for queries
+    struct dynamic_object** sorted_objects;
+    float max_width;
     struct contact* next_free_contact;
     struct contact* all_contacts;
     struct hash_map entity_mapping;
@@ -37,5 +40,6 @@ struct contact* collision_scene_new_contact();
 typedef void (*collision_scene_query_callback)(void* data, struct dynamic_object* overlaps);
 
 void collision_scene_query(struct dynamic_object_type* shape, struct Vector3* center, int collision_layers, collision_scene_query_callback callback, void* callback_data);
+void collision_scene_query_box(struct Box3D* box, int collision_layers, collision_scene_query_callback callback, void* callback_data);
 
 #endif
\ No newline at end of file
@@ -9,13 +9,13 @@ void cylinder_minkowski_sum(void* data, struct Vector3* direction, struct Vector
     union dynamic_object_type_data* shape_data = (union dynamic_object_type_data*)data;
 
     float abs_x = fabsf(direction->x);
-    float abs_y = fabsf(direction->y);
-    float angle_dot = (abs_x + abs_y) * SQRT_1_2;
+    float abs_z = fabsf(direction->z);
+    float angle_dot = (abs_x + abs_z) * SQRT_1_2;
 
-    if (abs_x > angle_dot && abs_y > angle_dot) {
+    if (angle_dot > abs_x && angle_dot > abs_z) {
         output->x = direction->x > 0.0f ? SQRT_1_2 * shape_data->cylinder.radius : -SQRT_1_2 * shape_data->cylinder.radius;
         output->z = direction->z > 0.0f ? SQRT_1_2 * shape_data->cylinder.radius : -SQRT_1_2 * shape_data->cylinder.radius;
-    } else if (abs_x > abs_y) {
+    } else if (abs_x > abs_z) {
         output->x = direction->x > 0.0f ? shape_data->cylinder.radius : -shape_data->cylinder.radius;
         output->z = 0.0f;
     } else {
@@ -22,6 +22,7 @@ void dynamic_object_init(
     object->is_trigger = 0;
     object->is_fixed = 0;
     object->is_out_of_bounds = 0;
+    object->has_ccd = 0;
     object->collision_layers = collision_layers;
     object->collision_group = 0;
     object->active_contacts = 0;
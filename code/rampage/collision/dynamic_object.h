@@ -52,6 +52,8 @@ struct dynamic_object {
     uint16_t is_trigger: 1;
     uint16_t is_fixed: 1;
     uint16_t is_out_of_bounds: 1;
+    // sweeps from the previous position each step so fast objects can't pass through thin ones
+    uint16_t has_ccd: 1;
     uint16_t collision_layers;
     uint16_t collision_group;
     struct contact* active_contacts;
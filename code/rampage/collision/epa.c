@@ -142,11 +142,13 @@ int expandingSimplexSiftUpHeap(struct ExpandingSimplex* simplex, int heapIndex)
             swapWithChild = childHeapIndex;
         }
 
-        float otherChildDistance = EXPANDING_SIMPLEX_GET_DISTANCE(simplex, simplex->triangleHeap[childHeapIndex + 1]);
+        // grab the smallest child, the second child may be past the end of the heap
+        if (childHeapIndex + 1 < simplex->triangleCount) {
+            float otherChildDistance = EXPANDING_SIMPLEX_GET_DISTANCE(simplex, simplex->triangleHeap[childHeapIndex + 1]);
 
-        // grab the smallest child
-        if (childHeapIndex + 1 < simplex->triangleCount && otherChildDistance < currentDistance && otherChildDistance < childDistance) {
-            swapWithChild = childHeapIndex + 1;
+            if (otherChildDistance < currentDistance && otherChildDistance < childDistance) {
+                swapWithChild = childHeapIndex + 1;
+            }
         }
 
         if (swapWithChild == -1) {
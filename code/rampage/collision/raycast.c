@@ -1,5 +1,439 @@
 #include "./raycast.h"
 
-bool collision_raycast(struct Ray* ray, int collision_layers, struct RaycastHit* hit) {
-    return false;
-}
\ No newline at end of file
+#include "./collision_scene.h"
+#include <math.h>
+#include <stddef.h>
+
+#define MAX_RAYCAST_ITERATIONS  32
+#define RAYCAST_TOLERANCE       0.1f
+
+// points on the target shape, the simplex itself is made of
+// ray_point - points[i] since ray_point moves during the cast
+struct RaycastSimplex {
+    struct Vector3 points[4];
+    short nPoints;
+};
+
+static int raycast_closest_segment(struct Vector3* a, struct Vector3* b, struct Vector3* out) {
+    struct Vector3 ab;
+    vector3Sub(b, a, &ab);
+
+    float t = -vector3Dot(a, &ab);
+
+    if (t <= 0.0f) {
+        *out = *a;
+        return 0x1;
+    }
+
+    float length_sqrd = vector3MagSqrd(&ab);
+
+    if (t >= length_sqrd) {
+        *out = *b;
+        return 0x2;
+    }
+
+    vector3AddScaled(a, &ab, t / length_sqrd, out);
+    return 0x3;
+}
+
+// closest point to the origin, returns which of a, b, c are needed to describe it
+static int raycast_closest_triangle(struct Vector3* a, struct Vector3* b, struct Vector3* c, struct Vector3* out) {
+    struct Vector3 ab;
+    struct Vector3 ac;
+    vector3Sub(b, a, &ab);
+    vector3Sub(c, a, &ac);
+
+    float d1 = -vector3Dot(&ab, a);
+    float d2 = -vector3Dot(&ac, a);
+
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        *out = *a;
+        return 0x1;
+    }
+
+    float d3 = -vector3Dot(&ab, b);
+    float d4 = -vector3Dot(&ac, b);
+
+    if (d3 >= 0.0f && d4 <= d3) {
+        *out = *b;
+        return 0x2;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        vector3AddScaled(a, &ab, d1 / (d1 - d3), out);
+        return 0x3;
+    }
+
+    float d5 = -vector3Dot(&ab, c);
+    float d6 = -vector3Dot(&ac, c);
+
+    if (d6 >= 0.0f && d5 <= d6) {
+        *out = *c;
+        return 0x4;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        vector3AddScaled(a, &ac, d2 / (d2 - d6), out);
+        return 0x5;
+    }
+
+    float va = d3 * d6 - d5 * d4;
+
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        struct Vector3 bc;
+        vector3Sub(c, b, &bc);
+        vector3AddScaled(b, &bc, (d4 - d3) / ((d4 - d3) + (d5 - d6)), out);
+        return 0x6;
+    }
+
+    float denom = va + vb + vc;
+
+    if (denom <= 0.0000001f) {
+        // degenerate triangle, use the closest edge instead
+        struct Vector3 edge_point;
+        int result = raycast_closest_segment(a, b, out);
+        int edge_result = raycast_closest_segment(a, c, &edge_point);
+
+        if (vector3MagSqrd(&edge_point) < vector3MagSqrd(out)) {
+            *out = edge_point;
+            result = (edge_result & 0x1) | ((edge_result & 0x2) << 1);
+        }
+
+        edge_result = raycast_closest_segment(b, c, &edge_point);
+
+        if (vector3MagSqrd(&edge_point) < vector3MagSqrd(out)) {
+            *out = edge_point;
+            result = edge_result << 1;
+        }
+
+        return result;
+    }
+
+    denom = 1.0f / denom;
+
+    vector3AddScaled(a, &ab, vb * denom, out);
+    vector3AddScaled(out, &ac, vc * denom, out);
+    return 0x7;
+}
+
+// face vertices followed by the vertex opposite the face
+static char tetrahedron_faces[4][4] = {
+    {0, 1, 2, 3},
+    {0, 3, 1, 2},
+    {0, 2, 3, 1},
+    {1, 3, 2, 0},
+};
+
+static int raycast_closest_tetrahedron(struct Vector3* points, struct Vector3* out) {
+    int result = 0xF;
+    float distance = 0.0f;
+    *out = gZeroVec;
+
+    for (int i = 0; i < 4; ++i) {
+        char* face = tetrahedron_faces[i];
+        struct Vector3* a = &points[(int)face[0]];
+
+        struct Vector3 ab;
+        struct Vector3 ac;
+        struct Vector3 ad;
+        struct Vector3 normal;
+        vector3Sub(&points[(int)face[1]], a, &ab);
+        vector3Sub(&points[(int)face[2]], a, &ac);
+        vector3Sub(&points[(int)face[3]], a, &ad);
+        vector3Cross(&ab, &ac, &normal);
+
+        // origin is on the same side of this face as the opposite vertex
+        if (-vector3Dot(&normal, a) * vector3Dot(&normal, &ad) > 0.0f) {
+            continue;
+        }
+
+        struct Vector3 face_point;
+        int face_result = raycast_closest_triangle(a, &points[(int)face[1]], &points[(int)face[2]], &face_point);
+        float face_distance = vector3MagSqrd(&face_point);
+
+        if (result == 0xF || face_distance < distance) {
+            distance = face_distance;
+            *out = face_point;
+            result = 0;
+
+            for (int vertex = 0; vertex < 3; ++vertex) {
+                if (face_result & (1 << vertex)) {
+                    result |= 1 << face[vertex];
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// finds the point of the simplex closest to the origin and drops the points that aren't needed
+static void raycast_simplex_closest(struct RaycastSimplex* simplex, struct Vector3* ray_point, struct Vector3* out) {
+    struct Vector3 points[4];
+
+    for (int i = 0; i < simplex->nPoints; ++i) {
+        vector3Sub(ray_point, &simplex->points[i], &points[i]);
+    }
+
+    int keep;
+
+    if (simplex->nPoints == 1) {
+        *out = points[0];
+        keep = 0x1;
+    } else if (simplex->nPoints == 2) {
+        keep = raycast_closest_segment(&points[0], &points[1], out);
+    } else if (simplex->nPoints == 3) {
+        keep = raycast_closest_triangle(&points[0], &points[1], &points[2], out);
+    } else {
+        keep = raycast_closest_tetrahedron(points, out);
+    }
+
+    int count = 0;
+
+    for (int i = 0; i < simplex->nPoints; ++i) {
+        if (keep & (1 << i)) {
+            simplex->points[count] = simplex->points[i];
+            ++count;
+        }
+    }
+
+    simplex->nPoints = count;
+}
+
+// GJK ray cast (conservative advancement), returns false for a miss
+// and for rays that start inside the shape
+static bool raycast_gjk(void* object, MinkowsiSum object_sum, struct Ray* ray, float max_distance, float* distance, struct Vector3* normal) {
+    struct RaycastSimplex simplex;
+    simplex.nPoints = 0;
+
+    float lambda = 0.0f;
+    struct Vector3 ray_point = ray->origin;
+    struct Vector3 hit_normal = gZeroVec;
+
+    struct Vector3 support_point;
+    struct Vector3 closest;
+    struct Vector3 reverse_dir;
+    vector3Negate(&ray->dir, &reverse_dir);
+    object_sum(object, &reverse_dir, &support_point);
+    vector3Sub(&ray_point, &support_point, &closest);
+
+    for (int iteration = 0; iteration < MAX_RAYCAST_ITERATIONS; ++iteration) {
+        if (vector3MagSqrd(&closest) <= RAYCAST_TOLERANCE * RAYCAST_TOLERANCE) {
+            break;
+        }
+
+        object_sum(object, &closest, &support_point);
+
+        struct Vector3 offset;
+        vector3Sub(&ray_point, &support_point, &offset);
+
+        float separation = vector3Dot(&closest, &offset);
+
+        if (separation > 0.0f) {
+            float approach = vector3Dot(&closest, &ray->dir);
+
+            if (approach >= 0.0f) {
+                return false;
+            }
+
+            lambda -= separation / approach;
+
+            if (lambda > max_distance) {
+                return false;
+            }
+
+            vector3AddScaled(&ray->origin, &ray->dir, lambda, &ray_point);
+            hit_normal = closest;
+        }
+
+        simplex.points[simplex.nPoints] = support_point;
+        ++simplex.nPoints;
+
+        raycast_simplex_closest(&simplex, &ray_point, &closest);
+    }
+
+    if (vector3IsZero(&hit_normal)) {
+        return false;
+    }
+
+    *distance = lambda;
+    vector3Normalize(&hit_normal, normal);
+
+    return true;
+}
+
+struct shape_cast_pair {
+    struct dynamic_object* target;
+    struct dynamic_object* caster;
+};
+
+// target minus the caster relative to its own position
+static void shape_cast_minkowski_sum(void* data, struct Vector3* direction, struct Vector3* output) {
+    struct shape_cast_pair* pair = (struct shape_cast_pair*)data;
+
+    struct Vector3 reverse_dir;
+    vector3Negate(direction, &reverse_dir);
+
+    struct Vector3 caster_point;
+    dynamic_object_minkowski_sum(pair->caster, &reverse_dir, &caster_point);
+    vector3Sub(&caster_point, &pair->caster->position, &caster_point);
+
+    dynamic_object_minkowski_sum(pair->target, direction, output);
+    vector3Sub(output, &caster_point, output);
+}
+
+// same as dynamic_object_recalc_bb but relative to the object position,
+// object->bounding_box can't be used since the scene keeps it sorted
+static void raycast_shape_extent(struct dynamic_object* object, struct Box3D* extent) {
+    object->type->bounding_box(&object->type->data, &object->rotation, extent);
+    vector3Scale(&extent->min, &extent->min, object->scale);
+    vector3Scale(&extent->max, &extent->max, object->scale);
+
+    struct Vector3 offset;
+    vector3Scale(&object->center, &offset, object->scale);
+    vector3Add(&extent->min, &offset, &extent->min);
+    vector3Add(&extent->max, &offset, &extent->max);
+}
+
+struct raycast_query {
+    struct Ray ray;
+    float max_distance;
+    // bounding box of the cast shape relative to the ray origin
+    struct Box3D extent;
+    struct dynamic_object* caster;
+    int collision_group;
+    struct RaycastHit* hit;
+    bool did_hit;
+};
+
+// slab test against box grown by the cast shape, distance is where the ray enters
+static bool raycast_query_box_check(struct raycast_query* query, struct Box3D* box, float max_distance, float* distance) {
+    float enter = 0.0f;
+    float exit = max_distance;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        float origin = VECTOR3_AS_ARRAY(&query->ray.origin)[axis];
+        float dir = VECTOR3_AS_ARRAY(&query->ray.dir)[axis];
+        float min = VECTOR3_AS_ARRAY(&box->min)[axis] - VECTOR3_AS_ARRAY(&query->extent.max)[axis];
+        float max = VECTOR3_AS_ARRAY(&box->max)[axis] - VECTOR3_AS_ARRAY(&query->extent.min)[axis];
+
+        if (fabsf(dir) < 0.000001f) {
+            if (origin < min || origin > max) {
+                return false;
+            }
+
+            continue;
+        }
+
+        float inv_dir = 1.0f / dir;
+        float t0 = (min - origin) * inv_dir;
+        float t1 = (max - origin) * inv_dir;
+
+        if (t0 > t1) {
+            float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+
+        if (t0 > enter) {
+            enter = t0;
+        }
+
+        if (t1 < exit) {
+            exit = t1;
+        }
+
+        if (enter > exit) {
+            return false;
+        }
+    }
+
+    *distance = enter;
+    return true;
+}
+
+static void raycast_query_check(void* data, struct dynamic_object* object) {
+    struct raycast_query* query = (struct raycast_query*)data;
+
+    if (object == query->caster || object->is_trigger) {
+        return;
+    }
+
+    if (query->collision_group && object->collision_group == query->collision_group) {
+        return;
+    }
+
+    float max_distance = query->did_hit ? query->hit->distance : query->max_distance;
+    float distance;
+
+    if (!raycast_query_box_check(query, &object->bounding_box, max_distance, &distance)) {
+        return;
+    }
+
+    struct Vector3 normal;
+
+    if (query->caster) {
+        struct shape_cast_pair pair;
+        pair.target = object;
+        pair.caster = query->caster;
+
+        if (!raycast_gjk(&pair, shape_cast_minkowski_sum, &query->ray, max_distance, &distance, &normal)) {
+            return;
+        }
+    } else if (!raycast_gjk(object, dynamic_object_minkowski_sum, &query->ray, max_distance, &distance, &normal)) {
+        return;
+    }
+
+    query->did_hit = true;
+    vector3AddScaled(&query->ray.origin, &query->ray.dir, distance, &query->hit->at);
+    query->hit->normal = normal;
+    query->hit->distance = distance;
+    query->hit->entity_id = object->entity_id;
+}
+
+static bool raycast_query_run(struct raycast_query* query, int collision_layers) {
+    struct Vector3 end;
+    vector3AddScaled(&query->ray.origin, &query->ray.dir, query->max_distance, &end);
+
+    struct Box3D bounding_box;
+    vector3Min(&query->ray.origin, &end, &bounding_box.min);
+    vector3Max(&query->ray.origin, &end, &bounding_box.max);
+    vector3Add(&bounding_box.min, &query->extent.min, &bounding_box.min);
+    vector3Add(&bounding_box.max, &query->extent.max, &bounding_box.max);
+
+    query->did_hit = false;
+
+    collision_scene_query_box(&bounding_box, collision_layers, raycast_query_check, query);
+
+    return query->did_hit;
+}
+
+bool collision_raycast(struct Ray* ray, float max_distance, int collision_layers, int collision_group, struct RaycastHit* hit) {
+    struct raycast_query query;
+    query.ray = *ray;
+    query.max_distance = max_distance;
+    query.extent.min = gZeroVec;
+    query.extent.max = gZeroVec;
+    query.caster = NULL;
+    query.collision_group = collision_group;
+    query.hit = hit;
+
+    return raycast_query_run(&query, collision_layers);
+}
+
+bool collision_shape_cast(struct dynamic_object* object, struct Vector3* direction, float max_distance, int collision_layers, struct RaycastHit* hit) {
+    struct raycast_query query;
+    query.ray.origin = object->position;
+    query.ray.dir = *direction;
+    query.max_distance = max_distance;
+    raycast_shape_extent(object, &query.extent);
+    query.caster = object;
+    query.collision_group = object->collision_group;
+    query.hit = hit;
+
+    return raycast_query_run(&query, collision_layers);
+}
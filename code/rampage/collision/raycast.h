@@ -3,13 +3,21 @@
 
 #include <stdbool.h>
 #include "../math/ray.h"
+#include "./dynamic_object.h"
 
 struct RaycastHit {
     struct Vector3 at;
     struct Vector3 normal;
+    float distance;
     int entity_id;
 };
 
-bool collision_raycast(struct Ray* ray, int collision_layers, struct RaycastHit* hit);
+// ray->dir must be normalized. Triggers, objects in collision_group and
+// objects that already contain the start of the cast are skipped
+bool collision_raycast(struct Ray* ray, float max_distance, int collision_layers, int collision_group, struct RaycastHit* hit);
 
-#endif
\ No newline at end of file
+// moves object along direction (normalized) without changing it and reports
+// the first thing it would run into, at is the object position at that point
+bool collision_shape_cast(struct dynamic_object* object, struct Vector3* direction, float max_distance, int collision_layers, struct RaycastHit* hit);
+
+#endif
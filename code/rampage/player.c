@@ -173,7 +173,7 @@ struct RampageInput rampage_player_get_input(struct RampagePlayer* player, float
             }
         }
     } else {
-        struct Vector3* new_target = find_nearest_target(&player->dynamic_object.position, target_finding_accuracy[player->type - PLAYER_TYPE_EASY]);
+        struct Vector3* new_target = find_nearest_target(&player->dynamic_object, target_finding_accuracy[player->type - PLAYER_TYPE_EASY]);
 
         if (new_target) {
             player->moving_to_target = 1;
@@ -111,6 +111,98 @@ int redraw_collect_rects(struct RedrawRect* rects) {
     return active_rect_count;
 }
 
+int rect_area(struct RedrawRect* rect) {
+    return (rect->max[0] - rect->min[0]) * (rect->max[1] - rect->min[1]);
+}
+
+// extra pixels drawn when replacing a and b with their union
+// pixels covered by both were already drawn twice, so merging saves those
+int rect_merge_cost(struct RedrawRect* a, struct RedrawRect* b) {
+    struct RedrawRect combined;
+    rect_union(a, b, &combined);
+    return rect_area(&combined) - rect_area(a) - rect_area(b);
+}
+
+// merges rects inside the bucket whenever that costs less overdraw than the per rect overhead it saves
+// returns the new bucket size, merged rects are removed from the end of the bucket
+int redraw_merge_bucket(struct RedrawRect* rects, int rect_count) {
+    for (int a = 0; a < rect_count; a += 1) {
+        for (int b = a + 1; b < rect_count; b += 1) {
+            if (rect_merge_cost(&rects[a], &rects[b]) >= REDRAW_RECT_OVERHEAD) {
+                continue;
+            }
+
+            rect_union(&rects[a], &rects[b], &rects[a]);
+            rect_count -= 1;
+            rects[b] = rects[rect_count];
+            // a grew, so rects it was already checked against may merge now
+            b = a;
+        }
+    }
+
+    return rect_count;
+}
+
+struct RedrawBucketRect {
+    int key;
+    struct RedrawRect rect;
+};
+
+int redraw_bucket_compare(const void *a, const void *b) {
+    return ((struct RedrawBucketRect*)a)->key - ((struct RedrawBucketRect*)b)->key;
+}
+
+int redraw_coalesce_rects(struct RedrawRect* rects, int rect_count) {
+    for (int i = 0; i < rect_count; i += 1) {
+        if (rect_is_empty(&rects[i])) {
+            rect_count -= 1;
+            rects[i] = rects[rect_count];
+            i -= 1;
+        }
+    }
+
+    // rects are merged bottom up in a grid hierarchy, first only with rects whose centre
+    // shares a small cell, then in cells twice as large until one cell spans the screen.
+    // nearby rects get merged first and each merge step only compares within one cell
+    struct RedrawBucketRect buckets[MAX_REDRAW_ENTITIES];
+    int screen_size = MAX(screen_rect.max[0], screen_rect.max[1]);
+
+    for (int cell_size = REDRAW_MERGE_CELL_SIZE; rect_count > 1; cell_size *= 2) {
+        int columns = screen_size / cell_size + 1;
+
+        for (int i = 0; i < rect_count; i += 1) {
+            int x = (rects[i].min[0] + rects[i].max[0]) / 2 / cell_size;
+            int y = (rects[i].min[1] + rects[i].max[1]) / 2 / cell_size;
+            buckets[i].key = y * columns + x;
+            buckets[i].rect = rects[i];
+        }
+
+        qsort(buckets, rect_count, sizeof(struct RedrawBucketRect), redraw_bucket_compare);
+
+        int merged_count = 0;
+
+        for (int start = 0; start < rect_count;) {
+            int end = start;
+
+            while (end < rect_count && buckets[end].key == buckets[start].key) {
+                rects[merged_count + end - start] = buckets[end].rect;
+                end += 1;
+            }
+
+            merged_count += redraw_merge_bucket(&rects[merged_count], end - start);
+            start = end;
+        }
+
+        rect_count = merged_count;
+
+        if (cell_size >= screen_size) {
+            break;
+        }
+    }
+
+    return rect_count;
+}
+
 int rect_compare(const void *a, const void *b) {
     struct RedrawRect* aRect = (struct RedrawRect*)a;
     struct RedrawRect* bRect = (struct RedrawRect*)b;
@@ -120,6 +212,8 @@ int rect_compare(const void *a, const void *b) {
 
 int redraw_retrieve_dirty_rects(struct RedrawRect rects[MAX_REDRAW_ENTITIES]) {
     if (fullscreen_count > 0) {
+        // still advance the per entity history, the frames after this restore what was drawn now
+        redraw_collect_rects(rects);
         rects[0] = screen_rect;
         fullscreen_count -= 1;
         frame_parity = frame_parity ^ 1;
@@ -127,6 +221,7 @@ int redraw_retrieve_dirty_rects(struct RedrawRect rects[MAX_REDRAW_ENTITIES]) {
     }
 
     int result = redraw_collect_rects(rects);
+    result = redraw_coalesce_rects(rects, result);
     frame_parity = frame_parity ^ 1;
     return result;
 }
@@ -13,12 +13,18 @@ typedef int RedrawHandle;
 
 #define MAX_REDRAW_ENTITIES     64
 
+// cost of an extra rect (scissor, block run, blit setup) in pixels of overdraw
+#define REDRAW_RECT_OVERHEAD    256
+// smallest cell of the merge hierarchy, rects are first only merged within cells of this size
+#define REDRAW_MERGE_CELL_SIZE  32
+
 void redraw_manager_init(int screen_width, int screen_height);
 
 RedrawHandle redraw_aquire_handle();
 void redraw_update_dirty(RedrawHandle handle, struct RedrawRect* rect);
 
 int redraw_retrieve_dirty_rects(struct RedrawRect rects[MAX_REDRAW_ENTITIES]);
+int redraw_coalesce_rects(struct RedrawRect* rects, int rect_count);
 
 void redraw_get_screen_rect(T3DViewport* viewport, struct Vector3* world_pos, float radius, float min_y, float y_height, struct RedrawRect* result);
 
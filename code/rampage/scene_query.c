@@ -2,12 +2,42 @@
 
 #include "rampage.h"
 #include "./math/mathf.h"
+#include "./collision/raycast.h"
+#include <math.h>
 
 extern struct Rampage gRampage;
 
-struct Vector3* find_nearest_target(struct Vector3* from, float error_tolerance) {
+bool is_target_visible(struct dynamic_object* from, struct dynamic_object* target) {
+    struct Ray ray;
+    vector3Add(&from->position, &from->center, &ray.origin);
+
+    struct Vector3 target_center;
+    vector3Add(&target->position, &target->center, &target_center);
+    vector3Sub(&target_center, &ray.origin, &ray.dir);
+
+    float distance = sqrtf(vector3MagSqrd(&ray.dir));
+
+    if (distance < 0.0001f) {
+        return true;
+    }
+
+    vector3Scale(&ray.dir, &ray.dir, 1.0f / distance);
+
+    struct RaycastHit hit;
+
+    if (!collision_raycast(&ray, distance, COLLISION_LAYER_TANGIBLE, from->collision_group, &hit)) {
+        return true;
+    }
+
+    return hit.entity_id == target->entity_id;
+}
+
+struct Vector3* find_nearest_target(struct dynamic_object* from, float error_tolerance) {
     struct Vector3* result = NULL;
     float score = 0.0f;
+    // used when every building is behind something
+    struct Vector3* hidden_result = NULL;
+    float hidden_score = 0.0f;
     float inv_error_tolerance = 1.0f / error_tolerance;
 
     for (int y = 0; y < BUILDING_COUNT_Y; y += 1) {
@@ -18,19 +48,26 @@ struct Vector3* find_nearest_target(struct Vector3* from, float error_tolerance)
                 continue;
             }
 
-            float building_score = vector3DistSqrd(from, &building->dynamic_object.position);
+            float building_score = vector3DistSqrd(&from->position, &building->dynamic_object.position);
             float error = randomInRangef(inv_error_tolerance, error_tolerance);
 
             building_score *= error * error;
 
-            if (result == NULL || building_score < score) {
+            if (result != NULL && building_score >= score) {
+                continue;
+            }
+
+            if (is_target_visible(from, &building->dynamic_object)) {
                 result = &building->dynamic_object.position;
                 score = building_score;
+            } else if (hidden_result == NULL || building_score < hidden_score) {
+                hidden_result = &building->dynamic_object.position;
+                hidden_score = building_score;
             }
         }
     }
 
-    return result;
+    return result ? result : hidden_result;
 }
 
 bool is_tank_target_used(struct Vector3* target) {
@@ -2,9 +2,11 @@
 #define __RAMPAGE_SCENE_QUERY_H__
 
 #include "./math/vector3.h"
+#include "./collision/dynamic_object.h"
 #include <stdbool.h>
 
-struct Vector3* find_nearest_target(struct Vector3* from, float error_tolerance);
+bool is_target_visible(struct dynamic_object* from, struct dynamic_object* target);
+struct Vector3* find_nearest_target(struct dynamic_object* from, float error_tolerance);
 
 bool is_tank_target_used(struct Vector3* target);
 
@@ -2,6 +2,7 @@
 
 #include "./collision/collision_scene.h"
 #include "./collision/box.h"
+#include "./collision/raycast.h"
 #include "./rampage.h"
 #include "./util/entity_id.h"
 #include "./math/quaternion.h"
@@ -17,6 +18,8 @@ struct Vector2 tank_rotate_speed;
 
 #define TANK_DAMAGE_SPEED   SCALE_FIXED_POINT(0.8f)
 
+#define TANK_LOOK_AHEAD     SCALE_FIXED_POINT(0.5f)
+
 #define MIN_FIRE_TIME   3.0f
 #define MAX_FIRE_TIME   5.0f
 
@@ -192,19 +195,24 @@ void rampage_tank_destroy(struct RampageTank* tank) {
 }
 
 bool rampage_tank_has_forward_hit(struct RampageTank* tank, struct Vector2* offset, struct Vector2* current_dir) {
-    struct contact* curr = tank->dynamic_object.active_contacts;
-
-    while (curr) {
-        struct Vector2 normal = { curr->normal.x, curr->normal.z };
+    float distance = vector2Dot(current_dir, offset);
 
-        if (vector2Dot(offset, &normal) < 0.1f && vector2Dot(current_dir, offset) > 0.5f) {
-            return true;
-        }
+    if (distance <= 0.0f) {
+        return false;
+    }
 
-        curr = curr->next;
+    if (distance > TANK_LOOK_AHEAD) {
+        distance = TANK_LOOK_AHEAD;
     }
 
-    return false;
+    struct Vector3 forward = {
+        current_dir->x,
+        0.0f,
+        current_dir->y,
+    };
+
+    struct RaycastHit hit;
+    return collision_shape_cast(&tank->dynamic_object, &forward, distance, COLLISION_LAYER_TANGIBLE, &hit);
 }
 
 void rampage_tank_update(struct RampageTank* tank, float delta_time) {
@@ -258,7 +266,7 @@ void rampage_tank_update(struct RampageTank* tank, float delta_time) {
 
         float stopping_distance = stoppingDistance(fabsf(speed), TANK_ACCEL);
 
-        bool should_stop = stopping_distance > distance;
+        bool should_stop = stopping_distance > distance || rampage_tank_has_forward_hit(tank, &offset, &current_dir);
 
         tank->dynamic_object.velocity.x = mathfMoveTowards(
             tank->dynamic_object.velocity.x,
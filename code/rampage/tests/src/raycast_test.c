@@ -0,0 +1,278 @@
+// Checks collision_raycast and collision_shape_cast against a brute force march that
+// steps along the cast and runs a GJK overlap test at every step.
+// The two may only disagree where the cast grazes a shape, anything deeper fails the test.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "collision/collision_scene.h"
+#include "collision/raycast.h"
+#include "collision/gjk.h"
+#include "collision/box.h"
+#include "collision/sphere.h"
+#include "collision/capsule.h"
+#include "collision/cylinder.h"
+#include "collision/sweep.h"
+
+#define SHAPE_COUNT         5
+#define RAY_COUNT           2000
+#define RAY_DISTANCE        200.0f
+#define SCENE_OBJECTS       40
+#define SHAPE_CAST_COUNT    200
+#define SHAPE_CAST_DISTANCE 300.0f
+#define MARCH_STEP          0.05f
+// hits may differ from the march by this much, the march itself is only MARCH_STEP precise
+#define DISTANCE_TOLERANCE  0.5f
+// a mismatch is only a graze if the cast never gets deeper into a shape than this
+#define GRAZE_TOLERANCE     0.25f
+#define SEPARATION_SAMPLES  4000
+
+static struct dynamic_object_type shape_types[SHAPE_COUNT] = {
+    {.minkowsi_sum = box_minkowski_sum, .bounding_box = box_bounding_box, .data = {.box = {.half_size = {20, 10, 30}}}},
+    {.minkowsi_sum = sphere_minkowski_sum, .bounding_box = sphere_bounding_box, .data = {.sphere = {.radius = 15}}},
+    {.minkowsi_sum = capsule_minkowski_sum, .bounding_box = capsule_bounding_box, .data = {.capsule = {.radius = 10, .inner_half_height = 15}}},
+    {.minkowsi_sum = cylinder_minkowski_sum, .bounding_box = cylinder_bounding_box, .data = {.cylinder = {.radius = 12, .half_height = 20}}},
+    {.minkowsi_sum = sweep_minkowski_sum, .bounding_box = sweep_bounding_box, .data = {.sweep = {.range = {0.7071f, 0.7071f}, .radius = 30, .half_height = 10}}},
+};
+
+static const char* shape_names[SHAPE_COUNT] = {"box", "sphere", "capsule", "cylinder", "sweep"};
+
+// a sphere without radius, used to treat points along a ray as shapes
+static struct dynamic_object_type point_type = {
+    .minkowsi_sum = sphere_minkowski_sum, .bounding_box = sphere_bounding_box, .data = {.sphere = {.radius = 0}},
+};
+
+static unsigned rng_state = 1;
+
+static float rng_float(float min, float max) {
+    rng_state = rng_state * 1103515245 + 12345;
+    return min + (max - min) * ((rng_state >> 8) & 0xFFFF) / 65535.0f;
+}
+
+// largest gap between the two shapes over many sampled directions, negative when they overlap
+static float shape_separation(struct dynamic_object* a, struct dynamic_object* b) {
+    float result = -INFINITY;
+
+    for (int i = 0; i < SEPARATION_SAMPLES; i += 1) {
+        struct Vector3 direction = {sinf(i * 0.37f) * cosf(i * 1.31f), cosf(i * 0.37f), sinf(i * 0.37f) * sinf(i * 1.31f)};
+        vector3Normalize(&direction, &direction);
+        struct Vector3 opposite;
+        vector3Negate(&direction, &opposite);
+
+        struct Vector3 a_point, b_point;
+        dynamic_object_minkowski_sum(a, &direction, &a_point);
+        dynamic_object_minkowski_sum(b, &opposite, &b_point);
+
+        float separation = vector3Dot(&b_point, &direction) - vector3Dot(&a_point, &direction);
+        if (separation > result) {
+            result = separation;
+        }
+    }
+
+    return result;
+}
+
+static bool shapes_overlap(struct dynamic_object* a, struct dynamic_object* b) {
+    struct Simplex simplex;
+    return gjkCheckForOverlap(&simplex, a, dynamic_object_minkowski_sum, b, dynamic_object_minkowski_sum, &gRight);
+}
+
+// deepest the caster gets into target while moving a little past distance
+static float graze_depth(struct dynamic_object* caster, struct Vector3* start, struct Vector3* direction, float distance, struct dynamic_object* target) {
+    float result = INFINITY;
+
+    for (float offset = -DISTANCE_TOLERANCE; offset <= 4.0f; offset += 0.25f) {
+        vector3AddScaled(start, direction, distance + offset, &caster->position);
+        float separation = shape_separation(caster, target);
+        if (separation < result) {
+            result = separation;
+        }
+    }
+
+    caster->position = *start;
+    return -result;
+}
+
+// compares one cast with the march, targets[i] has entity id i + 1
+static bool check_cast(
+    struct dynamic_object* caster,
+    struct Vector3* direction,
+    bool did_hit,
+    struct RaycastHit* hit,
+    float march_distance,
+    struct dynamic_object* march_target,
+    struct dynamic_object* targets
+) {
+    bool march_hit = march_distance >= 0.0f;
+
+    if (did_hit == march_hit && (!did_hit || fabsf(march_distance - hit->distance) <= DISTANCE_TOLERANCE)) {
+        return true;
+    }
+
+    struct Vector3 start = caster->position;
+
+    // the march went through a shape earlier than the cast or the cast missed it entirely
+    if (march_hit && (!did_hit || march_distance < hit->distance)) {
+        if (graze_depth(caster, &start, direction, march_distance, march_target) > GRAZE_TOLERANCE) {
+            return false;
+        }
+    }
+
+    // the cast reported a hit the march didn't find, it has to at least touch the shape
+    if (did_hit) {
+        vector3AddScaled(&start, direction, hit->distance, &caster->position);
+        float separation = shape_separation(caster, &targets[hit->entity_id - 1]);
+        caster->position = start;
+
+        if (fabsf(separation) > GRAZE_TOLERANCE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int test_raycast(int shape_index) {
+    collision_scene_init();
+
+    struct dynamic_object object;
+    struct Vector3 position = {5, 3, -4};
+    struct Vector2 rotation = {0.8f, 0.6f};
+    dynamic_object_init(1, &object, &shape_types[shape_index], COLLISION_LAYER_TANGIBLE, &position, &rotation);
+    collision_scene_add(&object);
+
+    struct dynamic_object point;
+    dynamic_object_init(2, &point, &point_type, COLLISION_LAYER_TANGIBLE, &position, &gRight2);
+
+    int hits = 0;
+    int failures = 0;
+
+    for (int i = 0; i < RAY_COUNT; i += 1) {
+        struct Ray ray;
+        ray.origin = (struct Vector3){rng_float(-80, 80), rng_float(-80, 80), rng_float(-80, 80)};
+        struct Vector3 target = {position.x + rng_float(-40, 40), position.y + rng_float(-40, 40), position.z + rng_float(-40, 40)};
+        vector3Sub(&target, &ray.origin, &ray.dir);
+        vector3Normalize(&ray.dir, &ray.dir);
+
+        struct RaycastHit hit;
+        bool did_hit = collision_raycast(&ray, RAY_DISTANCE, COLLISION_LAYER_TANGIBLE, 0, &hit);
+
+        point.position = ray.origin;
+        if (shapes_overlap(&point, &object)) {
+            // rays starting inside a shape ignore it
+            if (did_hit) {
+                failures += 1;
+            }
+            continue;
+        }
+
+        float march_distance = -1.0f;
+        for (float distance = 0.0f; distance <= RAY_DISTANCE; distance += MARCH_STEP) {
+            vector3AddScaled(&ray.origin, &ray.dir, distance, &point.position);
+            if (shapes_overlap(&point, &object)) {
+                march_distance = distance;
+                break;
+            }
+        }
+
+        point.position = ray.origin;
+        hits += did_hit;
+
+        if (!check_cast(&point, &ray.dir, did_hit, &hit, march_distance, &object, &object)) {
+            printf("  %s ray %d: cast %s %.3f, march %.3f\n", shape_names[shape_index], i, did_hit ? "hit" : "miss", did_hit ? hit.distance : 0.0f, march_distance);
+            failures += 1;
+        }
+    }
+
+    printf("raycast %-8s %4d hits of %d rays, %d failures\n", shape_names[shape_index], hits, RAY_COUNT, failures);
+    collision_scene_destroy();
+    return failures;
+}
+
+static int test_shape_cast(int shape_index) {
+    static struct dynamic_object objects[SCENE_OBJECTS];
+    // the caster ignores objects in its own group
+    const int caster_group = 99;
+
+    collision_scene_init();
+
+    for (int i = 0; i < SCENE_OBJECTS; i += 1) {
+        struct Vector3 position = {rng_float(-400, 400), rng_float(-20, 20), rng_float(-400, 400)};
+        float angle = rng_float(0, 6.28f);
+        struct Vector2 rotation = {cosf(angle), sinf(angle)};
+        dynamic_object_init(i + 1, &objects[i], &shape_types[i % SHAPE_COUNT], COLLISION_LAYER_TANGIBLE, &position, &rotation);
+        objects[i].collision_group = (i % 7 == 0) ? caster_group : 0;
+        collision_scene_add(&objects[i]);
+    }
+
+    // sorts the scene and calculates the bounding boxes
+    collision_scene_collide(0.0f);
+
+    struct dynamic_object caster;
+    struct Vector3 caster_position = gZeroVec;
+    struct Vector2 caster_rotation = {0.6f, 0.8f};
+    dynamic_object_init(SCENE_OBJECTS + 1, &caster, &shape_types[shape_index], COLLISION_LAYER_TANGIBLE, &caster_position, &caster_rotation);
+    caster.collision_group = caster_group;
+
+    int hits = 0;
+    int failures = 0;
+
+    for (int i = 0; i < SHAPE_CAST_COUNT; i += 1) {
+        struct Vector3 start = {rng_float(-400, 400), rng_float(-30, 30), rng_float(-400, 400)};
+        struct Vector3 direction = {rng_float(-1, 1), rng_float(-0.2f, 0.2f), rng_float(-1, 1)};
+        vector3Normalize(&direction, &direction);
+
+        caster.position = start;
+        struct RaycastHit hit;
+        bool did_hit = collision_shape_cast(&caster, &direction, SHAPE_CAST_DISTANCE, COLLISION_LAYER_TANGIBLE, &hit);
+
+        // objects overlapping the start are skipped by the cast
+        bool skip[SCENE_OBJECTS];
+        for (int k = 0; k < SCENE_OBJECTS; k += 1) {
+            skip[k] = objects[k].collision_group == caster_group || shapes_overlap(&caster, &objects[k]);
+        }
+
+        float march_distance = -1.0f;
+        struct dynamic_object* march_target = NULL;
+
+        for (float distance = MARCH_STEP; distance <= SHAPE_CAST_DISTANCE && !march_target; distance += MARCH_STEP) {
+            vector3AddScaled(&start, &direction, distance, &caster.position);
+
+            for (int k = 0; k < SCENE_OBJECTS; k += 1) {
+                if (!skip[k] && shapes_overlap(&caster, &objects[k])) {
+                    march_distance = distance;
+                    march_target = &objects[k];
+                    break;
+                }
+            }
+        }
+
+        caster.position = start;
+        hits += did_hit;
+
+        if (!check_cast(&caster, &direction, did_hit, &hit, march_distance, march_target, objects)) {
+            printf("  %s cast %d: cast %s %.3f id %d, march %.3f\n", shape_names[shape_index], i, did_hit ? "hit" : "miss", did_hit ? hit.distance : 0.0f, did_hit ? hit.entity_id : 0, march_distance);
+            failures += 1;
+        }
+    }
+
+    printf("shape cast %-8s %4d hits of %d casts, %d failures\n", shape_names[shape_index], hits, SHAPE_CAST_COUNT, failures);
+    collision_scene_destroy();
+    return failures;
+}
+
+int main() {
+    int failures = 0;
+
+    for (int i = 0; i < SHAPE_COUNT; i += 1) {
+        failures += test_raycast(i);
+    }
+
+    for (int i = 0; i < SHAPE_COUNT; i += 1) {
+        failures += test_shape_cast(i);
+    }
+
+    printf("raycast_test: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
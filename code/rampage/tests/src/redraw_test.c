@@ -0,0 +1,190 @@
+// Replays entity traces through the redraw manager and compares the restored pixels
+// of the coalesced rects against restoring every entity rect on its own.
+// Fails if a coalesced set misses a pixel that had to be restored, or costs more than no coalescing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "redraw_manager.h"
+
+#define SCREEN_WIDTH    320
+#define SCREEN_HEIGHT   240
+#define TRACE_FRAMES    600
+#define FULLSCREEN_FRAMES 2
+
+struct TraceEntity {
+    float x, y;
+    float vx, vy;
+    short width, height;
+    RedrawHandle handle;
+};
+
+struct Trace {
+    const char* name;
+    int entity_count;
+    // entities at or after this index don't move, like buildings
+    int static_start;
+    unsigned seed;
+};
+
+// entity mixes of a round, players + tanks moving over a street of buildings
+static struct Trace traces[] = {
+    {"4 players",                4,  4, 1},
+    {"4 players, 8 tanks",       12, 12, 2},
+    {"full round",               28, 12, 3},
+    {"crowded (all handles)",    MAX_REDRAW_ENTITIES - 1, 40, 4},
+};
+
+static unsigned rng_state;
+
+static float rng_float(float min, float max) {
+    rng_state = rng_state * 1103515245 + 12345;
+    return min + (max - min) * ((rng_state >> 8) & 0xFFFF) / 65535.0f;
+}
+
+static int rect_area(struct RedrawRect* rect) {
+    if (rect->min[0] >= rect->max[0] || rect->min[1] >= rect->max[1]) {
+        return 0;
+    }
+    return (rect->max[0] - rect->min[0]) * (rect->max[1] - rect->min[1]);
+}
+
+static void rect_clip(struct RedrawRect* rect) {
+    if (rect->min[0] < 0) rect->min[0] = 0;
+    if (rect->min[1] < 0) rect->min[1] = 0;
+    if (rect->max[0] > SCREEN_WIDTH) rect->max[0] = SCREEN_WIDTH;
+    if (rect->max[1] > SCREEN_HEIGHT) rect->max[1] = SCREEN_HEIGHT;
+}
+
+static void mark_rect(unsigned char* pixels, struct RedrawRect* rect, unsigned char bit) {
+    for (int y = rect->min[1]; y < rect->max[1]; y += 1) {
+        for (int x = rect->min[0]; x < rect->max[0]; x += 1) {
+            pixels[y * SCREEN_WIDTH + x] |= bit;
+        }
+    }
+}
+
+static void entity_rect(struct TraceEntity* entity, struct RedrawRect* rect) {
+    rect->min[0] = (short)entity->x;
+    rect->min[1] = (short)entity->y;
+    rect->max[0] = (short)entity->x + entity->width;
+    rect->max[1] = (short)entity->y + entity->height;
+}
+
+// the redraw manager keeps its state in globals, so every trace runs in its own process
+static int run_trace(struct Trace* trace) {
+    static struct TraceEntity entities[MAX_REDRAW_ENTITIES];
+    // the manager restores the rect an entity had two frames ago
+    static struct RedrawRect history[2][MAX_REDRAW_ENTITIES];
+    static unsigned char pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+    rng_state = trace->seed;
+    redraw_manager_init(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (int i = 0; i < trace->entity_count; i += 1) {
+        struct TraceEntity* entity = &entities[i];
+        bool is_static = i >= trace->static_start;
+        entity->width = is_static ? (short)rng_float(40, 70) : (short)rng_float(16, 40);
+        entity->height = is_static ? (short)rng_float(50, 90) : (short)rng_float(16, 40);
+        entity->x = rng_float(-20, SCREEN_WIDTH - entity->width + 20);
+        entity->y = rng_float(-20, SCREEN_HEIGHT - entity->height + 20);
+        entity->vx = is_static ? 0.0f : rng_float(-3.0f, 3.0f);
+        entity->vy = is_static ? 0.0f : rng_float(-2.0f, 2.0f);
+        entity->handle = redraw_aquire_handle();
+    }
+
+    long separate_pixels = 0, separate_rects = 0;
+    long coalesced_pixels = 0, coalesced_rects = 0;
+    long needed_pixels = 0;
+    int missed_pixels = 0;
+
+    for (int frame = 0; frame < TRACE_FRAMES; frame += 1) {
+        struct RedrawRect* old_rects = history[frame & 1];
+
+        for (int i = 0; i < trace->entity_count; i += 1) {
+            struct TraceEntity* entity = &entities[i];
+            entity->x += entity->vx;
+            entity->y += entity->vy;
+            if (entity->x < -entity->width || entity->x > SCREEN_WIDTH) entity->vx = -entity->vx;
+            if (entity->y < -entity->height || entity->y > SCREEN_HEIGHT) entity->vy = -entity->vy;
+
+            struct RedrawRect rect;
+            entity_rect(entity, &rect);
+            redraw_update_dirty(entity->handle, &rect);
+        }
+
+        struct RedrawRect rects[MAX_REDRAW_ENTITIES];
+        int rect_count = redraw_retrieve_dirty_rects(rects);
+
+        if (frame >= FULLSCREEN_FRAMES) {
+            memset(pixels, 0, sizeof(pixels));
+
+            for (int i = 0; i < trace->entity_count; i += 1) {
+                struct RedrawRect old_rect = old_rects[i];
+                rect_clip(&old_rect);
+                if (rect_area(&old_rect) == 0) {
+                    continue;
+                }
+                separate_pixels += rect_area(&old_rect);
+                separate_rects += 1;
+                mark_rect(pixels, &old_rect, 1);
+            }
+
+            for (int i = 0; i < rect_count; i += 1) {
+                coalesced_pixels += rect_area(&rects[i]);
+                mark_rect(pixels, &rects[i], 2);
+            }
+            coalesced_rects += rect_count;
+
+            for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i += 1) {
+                needed_pixels += (pixels[i] & 1) != 0;
+                missed_pixels += pixels[i] == 1;
+            }
+        }
+
+        for (int i = 0; i < trace->entity_count; i += 1) {
+            entity_rect(&entities[i], &old_rects[i]);
+        }
+    }
+
+    int frames = TRACE_FRAMES - FULLSCREEN_FRAMES;
+    long separate_cost = separate_pixels + separate_rects * REDRAW_RECT_OVERHEAD;
+    long coalesced_cost = coalesced_pixels + coalesced_rects * REDRAW_RECT_OVERHEAD;
+
+    printf("%-24s px/frame: needed %6ld, separate %6ld (%4.1f rects), coalesced %6ld (%4.1f rects), cost %3ld%%\n",
+        trace->name, needed_pixels / frames,
+        separate_pixels / frames, separate_rects / (float)frames,
+        coalesced_pixels / frames, coalesced_rects / (float)frames,
+        coalesced_cost * 100 / separate_cost
+    );
+
+    if (missed_pixels) {
+        printf("FAIL: %d pixels that needed a restore were not covered\n", missed_pixels);
+        return 1;
+    }
+    if (coalesced_cost > separate_cost) {
+        printf("FAIL: coalescing costs more than restoring every rect on its own\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int failed = 0;
+    fflush(stdout);
+
+    for (int i = 0; i < sizeof(traces) / sizeof(*traces); i += 1) {
+        char command[512];
+        snprintf(command, sizeof(command), "%s %d", argv[0], i);
+
+        if (argc > 1) {
+            return run_trace(&traces[atoi(argv[1])]);
+        }
+
+        failed |= system(command) != 0;
+    }
+
+    printf(failed ? "redraw_test: FAILED\n" : "redraw_test: passed\n");
+    return failed;
+}
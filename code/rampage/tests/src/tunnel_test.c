@@ -0,0 +1,159 @@
+// Fires fast spheres at thin walls and counts the shots that pass a wall without touching it.
+// Without continuous collision most fast shots tunnel, with it none may.
+// The volley fires many shots through one scene so sweeps of earlier objects can't hide walls from later ones.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "collision/collision_scene.h"
+#include "collision/box.h"
+#include "collision/sphere.h"
+
+#define FIXED_TIME_STEP     (1.0f / 30.0f)
+#define MAX_FRAMES          200
+#define SHOT_OFFSETS        10
+#define MIN_SPEED           100.0f
+#define MAX_SPEED           20000.0f
+#define WALL_SPACING        200.0f
+// the broadphase stores x * 32 in a short, so the volley stays within the arena
+#define ARENA_HALF_WIDTH    900.0f
+#define VOLLEY_WALLS        8
+#define VOLLEY_SHOTS        24
+// shots of one volley don't collide with each other, like the shots of a single player
+#define VOLLEY_GROUP        2
+
+static struct dynamic_object_type wall_type = {
+    .minkowsi_sum = box_minkowski_sum, .bounding_box = box_bounding_box, .data = {.box = {.half_size = {1, 40, 40}}},
+};
+
+static struct dynamic_object_type shot_type = {
+    .minkowsi_sum = sphere_minkowski_sum, .bounding_box = sphere_bounding_box, .data = {.sphere = {.radius = 8}},
+};
+
+static void init_wall(struct dynamic_object* wall, int entity_id, float x) {
+    struct Vector3 position = {x, 50, 0};
+    dynamic_object_init(entity_id, wall, &wall_type, COLLISION_LAYER_TANGIBLE, &position, &gRight2);
+    wall->is_fixed = 1;
+    wall->has_gravity = 0;
+}
+
+static void init_shot(struct dynamic_object* shot, int entity_id, struct Vector3* position, float speed, bool has_ccd) {
+    dynamic_object_init(entity_id, shot, &shot_type, COLLISION_LAYER_TANGIBLE, position, &gRight2);
+    shot->has_gravity = 0;
+    shot->has_ccd = has_ccd;
+    shot->velocity = (struct Vector3){speed, 0, 0};
+}
+
+// one shot at a time against a single wall, returns how many went through
+static int test_single_shots(bool has_ccd, int* shot_count) {
+    int tunnels = 0;
+    *shot_count = 0;
+
+    for (float speed = MIN_SPEED; speed <= MAX_SPEED; speed *= 1.1f) {
+        for (int offset = 0; offset < SHOT_OFFSETS; offset += 1) {
+            collision_scene_init();
+
+            struct dynamic_object wall, shot;
+            init_wall(&wall, 1, 0.0f);
+            struct Vector3 start = {-300 - offset * 7.3f, 50, (offset - 5) * 3.0f};
+            init_shot(&shot, 2, &start, speed, has_ccd);
+
+            collision_scene_add(&wall);
+            collision_scene_add(&shot);
+
+            bool did_hit = false;
+
+            for (int frame = 0; frame < MAX_FRAMES && shot.position.x < 400 && !did_hit; frame += 1) {
+                collision_scene_collide(FIXED_TIME_STEP);
+                did_hit = dynamic_object_is_touching(&shot, wall.entity_id);
+            }
+
+            *shot_count += 1;
+            tunnels += !did_hit;
+            collision_scene_destroy();
+        }
+    }
+
+    return tunnels;
+}
+
+static float volley_wall_x(int index) {
+    return (index - VOLLEY_WALLS / 2) * WALL_SPACING;
+}
+
+// every shot flies at the wall in front of it, all in the same scene
+static int test_volley(int* shot_count) {
+    static struct dynamic_object walls[VOLLEY_WALLS];
+    static struct dynamic_object shots[VOLLEY_SHOTS];
+    bool did_hit[VOLLEY_SHOTS] = {0};
+
+    collision_scene_init();
+
+    // shots are added first so they sweep before the walls come up in the scene order
+    for (int i = 0; i < VOLLEY_SHOTS; i += 1) {
+        int wall_index = i % VOLLEY_WALLS;
+        // stays in front of the previous wall
+        struct Vector3 start = {volley_wall_x(wall_index) - 60 - (i / VOLLEY_WALLS) * 40 - i * 0.7f, 50, (i % 5 - 2) * 6.0f};
+        init_shot(&shots[i], i + 1, &start, 2000.0f + i * 750.0f, true);
+        shots[i].collision_group = VOLLEY_GROUP;
+        collision_scene_add(&shots[i]);
+    }
+
+    for (int i = 0; i < VOLLEY_WALLS; i += 1) {
+        init_wall(&walls[i], VOLLEY_SHOTS + i + 1, volley_wall_x(i));
+        collision_scene_add(&walls[i]);
+    }
+
+    for (int frame = 0; frame < MAX_FRAMES; frame += 1) {
+        collision_scene_collide(FIXED_TIME_STEP);
+
+        for (int i = 0; i < VOLLEY_SHOTS; i += 1) {
+            if (!did_hit[i] && dynamic_object_is_touching(&shots[i], walls[i % VOLLEY_WALLS].entity_id)) {
+                did_hit[i] = true;
+            }
+
+            // parks the shot, so it doesn't run into the next wall or out of the arena
+            if (did_hit[i] || shots[i].position.x > ARENA_HALF_WIDTH) {
+                shots[i].velocity = gZeroVec;
+            }
+        }
+    }
+
+    int tunnels = 0;
+
+    for (int i = 0; i < VOLLEY_SHOTS; i += 1) {
+        if (!did_hit[i]) {
+            printf("  volley shot %d passed wall %d\n", i, i % VOLLEY_WALLS);
+            tunnels += 1;
+        }
+    }
+
+    collision_scene_destroy();
+    *shot_count = VOLLEY_SHOTS;
+    return tunnels;
+}
+
+int main() {
+    int shot_count;
+    int failures = 0;
+
+    int discrete_tunnels = test_single_shots(false, &shot_count);
+    printf("without ccd: %d tunnels of %d shots\n", discrete_tunnels, shot_count);
+
+    // only a sanity check that the shots are fast enough to need the sweep
+    if (discrete_tunnels == 0) {
+        printf("  no shot tunnelled without ccd, the test is too slow to show anything\n");
+        failures += 1;
+    }
+
+    int ccd_tunnels = test_single_shots(true, &shot_count);
+    printf("with ccd:    %d tunnels of %d shots\n", ccd_tunnels, shot_count);
+    failures += ccd_tunnels;
+
+    int volley_tunnels = test_volley(&shot_count);
+    printf("volley:      %d tunnels of %d shots\n", volley_tunnels, shot_count);
+    failures += volley_tunnels;
+
+    printf("tunnel_test: %s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,15 @@
+// Minimal host stand-in for the libdragon API used by the tested sources
+#ifndef __TEST_STUB_LIBDRAGON_H__
+#define __TEST_STUB_LIBDRAGON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define assertf(expr, ...) do { if (!(expr)) { fprintf(stderr, __VA_ARGS__); abort(); } } while (0)
+#define debugf(...) fprintf(stderr, __VA_ARGS__)
+
+#endif
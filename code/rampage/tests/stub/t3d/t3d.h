@@ -0,0 +1,15 @@
+// Minimal host stand-in for the tiny3d API used by the tested sources
+#ifndef __TEST_STUB_T3D_H__
+#define __TEST_STUB_T3D_H__
+
+#include <libdragon.h>
+#include "t3dmath.h"
+
+typedef struct { int unused; } T3DViewport;
+
+// projection is not part of any test, only the screen space rects are
+static inline void t3d_viewport_calc_viewspace_pos(T3DViewport* viewport, T3DVec3* out, const T3DVec3* pos) {
+    *out = *pos;
+}
+
+#endif
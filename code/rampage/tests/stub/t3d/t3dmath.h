@@ -0,0 +1,14 @@
+// Minimal host stand-in for the tiny3d math types used by the tested sources
+#ifndef __TEST_STUB_T3DMATH_H__
+#define __TEST_STUB_T3DMATH_H__
+
+#include <math.h>
+
+#define T3D_PI 3.14159265f
+
+typedef union {
+    float v[3];
+    struct { float x, y, z; };
+} T3DVec3;
+
+#endif
@@ -11,6 +11,8 @@ typedef struct
     uint8_t max_reaction_delay;
 } AI;
 
+#define AI_SEARCH_RADIUS (2.0f * PLATFORM_INDEX_CELL_SIZE)
+
 void ai_init(AI *ai, uint8_t difficulty);
 void ai_generateControlData(AI *ai, ControllerData *control, Actor *actor, Platform *platforms, float camera_angle);
 
@@ -60,71 +62,47 @@ void ai_updateCam(ControllerData *control, float camera_angle)
     control->input.stick_y = (int8_t)(original_x * fm_sinf(angle_rad) + original_y * fm_cosf(angle_rad));
 }
 
-// Function to find the nearest platform at a safe height
-Platform *find_nearest_safe_platform(AI *ai, Actor *actor, Platform *platforms)
+typedef struct
 {
-    Platform *nearest_platform = NULL;
-    float min_distance_sq = FLT_MAX;                             // Store squared distance to avoid square root computation
-    const float current_platform_threshold_sq = 0.011f * 0.011f; // Squared threshold to ignore the current platform
+    Platform *platforms;
+    Actor *actor;
+} AIPlatformQuery;
 
-    // Calculate grid cell for the actor's current position
-    int xCell = (int)fm_floorf((actor->body.position.x + 700) / GRID_SIZE);
-    int yCell = (int)fm_floorf((actor->body.position.y + 700) / GRID_SIZE);
+// Platform cost for the index query, the AI avoids its own colour and prefers untouched platforms
+float ai_platformCost(uint8_t id, float distance_sq, void *context)
+{
+    const AIPlatformQuery *query = (const AIPlatformQuery *)context;
+    const float current_platform_threshold_sq = 0.011f * 0.011f; // Squared threshold to ignore the current platform
+    Platform *platform = &query->platforms[id];
 
-    // Iterate through platforms in the same and adjacent grid cells
-    for (int dx = -1; dx <= 1; dx++)
+    if (platform->contact)
     {
-        for (int dy = -1; dy <= 1; dy++)
+        if (platform->colorID == query->actor->colorID)
+        {
+            return -1.0f;
+        }
+        else
         {
-            int nx = xCell + dx;
-            int ny = yCell + dy;
-
-            // Check if the cell is within bounds
-            if (nx >= 0 && nx < MAX_GRID_CELLS && ny >= 0 && ny < MAX_GRID_CELLS)
-            {
-                PlatformGridCell *cell = &platformGrid[nx][ny];
-                for (size_t i = 0; i < cell->count; i++)
-                {
-                    size_t platformIndex = cell->platformIndices[i];
-                    Platform *platform = &platforms[platformIndex];
-
-                    // Skip platforms not at a safe height
-                    if (platform->position.z < ai->safe_height)
-                        continue;
-
-                    // Calculate squared distance using fast math vector3
-                    fm_vec3_t actorPos = Vector3_to_fast(actor->body.position);
-                    fm_vec3_t platformPos = Vector3_to_fast(platform->position);
-                    float distance_sq = fm_vec3_distance2(&platformPos, &actorPos);
-
-                    if (platform->contact)
-                    {
-                        if (platform->colorID == actor->colorID)
-                        {
-                            continue;
-                        }
-                        else
-                        {
-                            distance_sq *= 2.5f;
-                        }
-                    }
-
-                    // Ignore the current platform the AI is standing on
-                    if (distance_sq < current_platform_threshold_sq)
-                        continue;
-
-                    // Check if this platform is the nearest valid one
-                    if (distance_sq < min_distance_sq)
-                    {
-                        min_distance_sq = distance_sq;
-                        nearest_platform = platform;
-                    }
-                }
-            }
+            distance_sq *= 2.5f;
         }
     }
 
-    return nearest_platform;
+    // Ignore the current platform the AI is standing on
+    if (distance_sq < current_platform_threshold_sq)
+        return -1.0f;
+
+    return distance_sq;
+}
+
+// Function to find the nearest platform at a safe height
+Platform *find_nearest_safe_platform(AI *ai, Actor *actor, Platform *platforms)
+{
+    // The colour filter and penalty run inside the query, so every platform in range is ranked by them
+    AIPlatformQuery query = {platforms, actor};
+    int nearest = platformIndex_nearestSafe(&platformIndex, &actor->body.position, ai->safe_height, AI_SEARCH_RADIUS,
+                                            ai_platformCost, &query);
+
+    return nearest >= 0 ? &platforms[nearest] : NULL;
 }
 
 // Generate control data for the AI
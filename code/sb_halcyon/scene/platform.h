@@ -25,17 +25,6 @@ typedef struct
 } Platform;
 
 #define OFFSET 350
-#define GRID_SIZE OFFSET // Size of each grid cell
-#define MAX_GRID_CELLS 7 // Adjust based on level size
-
-typedef struct
-{
-  size_t platformIndices[PLATFORM_COUNT]; // Indices of platforms in this cell
-  size_t count;                           // Number of platforms in this cell
-} PlatformGridCell;
-
-PlatformGridCell platformGrid[MAX_GRID_CELLS][MAX_GRID_CELLS];
-
 Platform hexagons[PLATFORM_COUNT];
 
 Platform innerRing[6];
@@ -92,20 +81,7 @@ void platform_init(Platform *platform, T3DModel *model, Vector3 position, color_
 
 void platform_assignGrid(Platform *platforms)
 {
-  memset(platformGrid, 0, sizeof(platformGrid)); // Clear the grid
-
-  for (size_t i = 0; i < PLATFORM_COUNT; i++)
-  {
-    int xCell = (int)fm_floorf((platforms[i].position.x + (OFFSET * 2)) / GRID_SIZE);
-    int yCell = (int)fm_floorf((platforms[i].position.y + (OFFSET * 2)) / GRID_SIZE);
-
-    if (xCell >= 0 && xCell < MAX_GRID_CELLS && yCell >= 0 && yCell < MAX_GRID_CELLS)
-    {
-      PlatformGridCell *cell = &platformGrid[xCell][yCell];
-      if (cell->count < PLATFORM_COUNT) // Ensure we don't exceed bounds
-        cell->platformIndices[cell->count++] = i;
-    }
-  }
+  platformIndex_build(&platformIndex, &platforms[0].position, sizeof(Platform), PLATFORM_COUNT);
 }
 
 //// BEHAVIORS ~ Start ////
@@ -118,13 +94,17 @@ void platform_shake(Platform *platform, float time)
 
   // Oscillate `platform->position.x` around `baseX`
   platform->position.x = baseX + amplitude * fm_sinf(time);
+  platformIndex_update(&platformIndex, platform->id, &platform->position);
 }
 
 // Example behavior: Lower platform over time
 void platform_updateHeight(Platform *platform, float time)
 {
   if (platform->position.z > -150.0f)
+  {
     platform->position.z = platform->position.z - time;
+    platformIndex_update(&platformIndex, platform->id, &platform->position);
+  }
 }
 
 void platform_dropGroup(Platform *platform, int groupID, float time)
@@ -156,7 +136,8 @@ void platform_collideCheck(Platform *platform, Actor *actor)
   if (platform->contact)
     return; // If already in collided state, do nothing
 
-  const float squaredDistanceThreshold = 150.0f * 150.0f;
+  const float distanceThreshold = 150.0f;
+  uint8_t nearby[PLATFORM_COUNT];
 
   for (size_t i = 0; i < ACTOR_COUNT; i++)
   {
@@ -164,56 +145,26 @@ void platform_collideCheck(Platform *platform, Actor *actor)
     if (!actor[i].grounded)
       continue;
 
-    // Calculate the difference vector
-    Vector3 diff = vector3_difference(&platform->position, &actor[i].body.position);
-
-    // Calculate squared distance
-    float distanceSq = vector3_squaredMagnitude(&diff);
-
-    if (distanceSq <= squaredDistanceThreshold)
+    size_t count = platformIndex_queryRadius(&platformIndex, &actor[i].body.position, distanceThreshold, nearby, PLATFORM_COUNT);
+    for (size_t j = 0; j < count; j++)
     {
-      platform->contact = true;
-      return; // Exit early on first collision
+      if (nearby[j] == platform->id)
+      {
+        platform->contact = true;
+        return; // Exit early on first collision
+      }
     }
   }
 }
 
 void platform_collideCheckOptimized(Platform *platforms, Actor *actor)
 {
-  int xCell = (int)floorf((actor->body.position.x + (OFFSET * 2)) / GRID_SIZE);
-  int yCell = (int)floorf((actor->body.position.y + (OFFSET * 2)) / GRID_SIZE);
-
-  if (xCell < 0 || xCell >= MAX_GRID_CELLS || yCell < 0 || yCell >= MAX_GRID_CELLS)
-  {
+  if (!platformIndex_inBounds(&actor->body.position))
     return; // Actor is out of bounds
-  }
-
-  const float collisionRangeSq = 150.0f * 150.0f;
 
-  // Check platforms in the same and adjacent cells
-  for (int dx = -1; dx <= 1; dx++)
-  {
-    for (int dy = -1; dy <= 1; dy++)
-    {
-      int nx = xCell + dx;
-      int ny = yCell + dy;
-
-      if (nx >= 0 && nx < MAX_GRID_CELLS && ny >= 0 && ny < MAX_GRID_CELLS)
-      {
-        PlatformGridCell *cell = &platformGrid[nx][ny];
-        for (size_t i = 0; i < cell->count; i++)
-        {
-          size_t platformIndex = cell->platformIndices[i];
-          float distanceSq = vector3_squaredDistance(&actor->body.position, &platforms[platformIndex].position);
-          if (distanceSq <= collisionRangeSq)
-          {
-            platforms[platformIndex].contact = true;
-            return; // Early exit on collision
-          }
-        }
-      }
-    }
-  }
+  int nearest = platformIndex_nearest(&platformIndex, &actor->body.position, 150.0f);
+  if (nearest >= 0)
+    platforms[nearest].contact = true;
 }
 
 void platform_loop(Platform *platform, Actor *actor, int diff)
@@ -144,11 +144,7 @@ void actorCollision_collidePlatforms(Actor *actor, ActorContactData *actor_conta
 
     actorCollision_updateFalling(actor, actor_contact, actor_collider);
 
-    // Calculate the grid cell the actor is in
-    int xCell = (int)fm_floorf((actor->body.position.x + 775) / 350);
-    int yCell = (int)fm_floorf((actor->body.position.y + 775) / 350);
-
-    if (xCell < 0 || xCell >= 7 || yCell < 0 || yCell >= 7)
+    if (!platformIndex_inBounds(&actor->body.position))
     {
         // Actor is out of bounds; fall and skip collision
         actor->state = FALLING;
@@ -159,67 +155,41 @@ void actorCollision_collidePlatforms(Actor *actor, ActorContactData *actor_conta
         return;
     }
 
-    const float collisionRangeSq = 175.0f * 175.0f;
-
     // Reset actor's collision state
     actor->hasCollided = false;
 
-    // Iterate through platforms in the same and adjacent cells
-    for (int dx = -1; dx <= 1; dx++)
+    // Broadphase against the platform bounds, the boxes below do the exact test
+    uint8_t nearby[PLATFORM_COUNT];
+    size_t count = platformIndex_queryCapsule(&platformIndex, &actor_collider->body, nearby, PLATFORM_COUNT);
+
+    for (size_t i = 0; i < count; i++)
     {
-        for (int dy = -1; dy <= 1; dy++)
+        Platform *platform = &platforms[nearby[i]];
+
+        // Check collision with each box in the platform's collider
+        for (int j = 0; j < 3; j++)
         {
-            int nx = xCell + dx;
-            int ny = yCell + dy;
+            Box *box = &platform->collider.box[j];
 
-            if (nx < 0 || nx >= 7 || ny < 0 || ny >= 7)
+            // If the actor hits a box
+            if (actorCollision_contactBox(actor_collider, box))
             {
-                // Actor is out of bounds; fall and skip collision
-                actor->state = FALLING;
-                actor->grounded = false;
-                actor->grounding_height = LOWER_LIMIT_HEIGHT;
-                if (actor->body.position.z <= DEATH_PLANE_HEIGHT)
-                    actorState_setDeath(actor);
-                continue;
-            }
+                // Set collision response
+                actorCollision_contactBoxSetData(actor_contact, actor_collider, box);
+                actorCollision_collideAndSlide(actor, actor_contact);
+                actorCollision_setGroundResponse(actor, actor_contact, actor_collider);
 
-            PlatformGridCell *cell = &platformGrid[nx][ny];
-            for (size_t i = 0; i < cell->count; i++)
-            {
-                Platform *platform = &platforms[cell->platformIndices[i]];
-                fm_vec3_t actorPos = Vector3_to_fast(actor->body.position);
-                fm_vec3_t platformPos = Vector3_to_fast(platform->position);
-                float distanceSq = fm_vec3_distance2(&actorPos, &platformPos);
-                if (distanceSq <= collisionRangeSq)
-                {
-
-                    // Check collision with each box in the platform's collider
-                    for (int j = 0; j < 3; j++)
-                    {
-                        Box *box = &platform->collider.box[j];
-
-                        // If the actor hits a box
-                        if (actorCollision_contactBox(actor_collider, box))
-                        {
-                            // Set collision response
-                            actorCollision_contactBoxSetData(actor_contact, actor_collider, box);
-                            actorCollision_collideAndSlide(actor, actor_contact);
-                            actorCollision_setGroundResponse(actor, actor_contact, actor_collider);
-
-                            // If the actor is lower the top of the box (center.z+(size.z/2)), move there
-                            if (actor->body.position.z < box->center.z + (box->size.z * 0.5f))
-                                actor->body.position.z = box->center.z + (box->size.z * 0.5f);
-
-                            // Set collided state parameter
-                            actor->hasCollided = true;
-
-                            // Handle platform collision here instead again for the platforms
-                            platform->contact = true;
-
-                            return; // Early exit if collision is detected
-                        }
-                    }
-                }
+                // If the actor is lower the top of the box (center.z+(size.z/2)), move there
+                if (actor->body.position.z < box->center.z + (box->size.z * 0.5f))
+                    actor->body.position.z = box->center.z + (box->size.z * 0.5f);
+
+                // Set collided state parameter
+                actor->hasCollided = true;
+
+                // Handle platform collision here instead again for the platforms
+                platform->contact = true;
+
+                return; // Early exit if collision is detected
             }
         }
     }
@@ -55,6 +55,7 @@
 
 #include "scene/scene.h"
 #include "scene/scenery.h"
+#include "scene/platform_index.h"
 #include "scene/platform.h"
 #include "scene/room.h"
 
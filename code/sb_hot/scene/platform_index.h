@@ -0,0 +1,285 @@
+#ifndef PLATFORM_INDEX_H
+#define PLATFORM_INDEX_H
+
+// Shared by sb_hot and sb_halcyon (included from ../sb_hot), keep it free of game specific Platform fields
+
+#define PLATFORM_INDEX_CELL_SIZE 350.0f // Same as the hexagon spacing
+#define PLATFORM_INDEX_ORIGIN -775.0f   // Keeps every hexagon centre inside a cell, away from the edges
+#define PLATFORM_INDEX_GRID 7
+#define PLATFORM_INDEX_CELLS (PLATFORM_INDEX_GRID * PLATFORM_INDEX_GRID)
+#define PLATFORM_INDEX_BOUNDS 185.0f // Bounding radius of the three platform boxes
+#define PLATFORM_INDEX_NONE 0xFF
+
+typedef struct
+{
+  // Platform positions mirrored by id, kept in sync by platformIndex_update
+  float x[PLATFORM_COUNT];
+  float y[PLATFORM_COUNT];
+  float z[PLATFORM_COUNT];
+  uint8_t cell[PLATFORM_COUNT];
+  uint8_t slot[PLATFORM_COUNT]; // Position inside cellItems, for O(1) removal
+  size_t count;
+
+  uint8_t cellCount[PLATFORM_INDEX_CELLS];
+  uint8_t cellItems[PLATFORM_INDEX_CELLS][PLATFORM_COUNT];
+} PlatformIndex;
+
+// Scores a platform for platformIndex_nearestSafe, lower is better and a negative result skips the platform
+typedef float (*PlatformIndexCostFn)(uint8_t id, float distance_sq, void *context);
+
+PlatformIndex platformIndex;
+
+// Forward Declarations
+
+bool platformIndex_inBounds(const Vector3 *position);
+void platformIndex_build(PlatformIndex *index, const Vector3 *positions, size_t stride, size_t count);
+void platformIndex_update(PlatformIndex *index, uint32_t id, const Vector3 *position);
+int platformIndex_nearest(const PlatformIndex *index, const Vector3 *position, float radius);
+size_t platformIndex_queryRadius(const PlatformIndex *index, const Vector3 *position, float radius, uint8_t *out, size_t max);
+size_t platformIndex_queryCapsule(const PlatformIndex *index, const Capsule *capsule, uint8_t *out, size_t max);
+int platformIndex_nearestSafe(const PlatformIndex *index, const Vector3 *position, float min_height, float radius, PlatformIndexCostFn cost, void *context);
+int platformIndex_raycast(const PlatformIndex *index, const Ray *ray, float max_distance, float *out_distance);
+
+// Definitions
+
+static inline int platformIndex_axisCell(float v)
+{
+  int c = (int)fm_floorf((v - PLATFORM_INDEX_ORIGIN) / PLATFORM_INDEX_CELL_SIZE);
+  if (c < 0)
+    return 0;
+  if (c >= PLATFORM_INDEX_GRID)
+    return PLATFORM_INDEX_GRID - 1;
+  return c;
+}
+
+bool platformIndex_inBounds(const Vector3 *position)
+{
+  const float extent = PLATFORM_INDEX_ORIGIN + PLATFORM_INDEX_CELL_SIZE * PLATFORM_INDEX_GRID;
+  return position->x >= PLATFORM_INDEX_ORIGIN && position->x < extent && position->y >= PLATFORM_INDEX_ORIGIN && position->y < extent;
+}
+
+static void platformIndex_insert(PlatformIndex *index, uint8_t id)
+{
+  // Out of grid platforms are clamped to the border cells, queries clamp the same way so they are still found
+  uint8_t cell = platformIndex_axisCell(index->y[id]) * PLATFORM_INDEX_GRID + platformIndex_axisCell(index->x[id]);
+  index->cell[id] = cell;
+  index->slot[id] = index->cellCount[cell];
+  index->cellItems[cell][index->cellCount[cell]++] = id;
+}
+
+static void platformIndex_remove(PlatformIndex *index, uint8_t id)
+{
+  uint8_t cell = index->cell[id];
+  if (cell == PLATFORM_INDEX_NONE)
+    return;
+
+  // Swap the last item of the cell into the freed slot
+  uint8_t last = index->cellItems[cell][--index->cellCount[cell]];
+  index->cellItems[cell][index->slot[id]] = last;
+  index->slot[last] = index->slot[id];
+  index->cell[id] = PLATFORM_INDEX_NONE;
+}
+
+// 'positions' is walked with 'stride' bytes, so an array of Platform can be passed as &platforms[0].position
+void platformIndex_build(PlatformIndex *index, const Vector3 *positions, size_t stride, size_t count)
+{
+  memset(index, 0, sizeof(PlatformIndex));
+  memset(index->cell, PLATFORM_INDEX_NONE, sizeof(index->cell));
+
+  if (count > PLATFORM_COUNT)
+    count = PLATFORM_COUNT;
+  index->count = count;
+
+  const uint8_t *p = (const uint8_t *)positions;
+  for (size_t i = 0; i < count; i++, p += stride)
+  {
+    const Vector3 *position = (const Vector3 *)p;
+    index->x[i] = position->x;
+    index->y[i] = position->y;
+    index->z[i] = position->z;
+    platformIndex_insert(index, i);
+  }
+}
+
+// Called whenever a platform moves, only touches the grid when the platform changes cell
+void platformIndex_update(PlatformIndex *index, uint32_t id, const Vector3 *position)
+{
+  if (id >= index->count)
+    return;
+
+  index->z[id] = position->z;
+  if (index->x[id] == position->x && index->y[id] == position->y)
+    return;
+
+  index->x[id] = position->x;
+  index->y[id] = position->y;
+
+  uint8_t cell = platformIndex_axisCell(position->y) * PLATFORM_INDEX_GRID + platformIndex_axisCell(position->x);
+  if (cell == index->cell[id])
+    return;
+
+  platformIndex_remove(index, id);
+  platformIndex_insert(index, id);
+}
+
+static inline float platformIndex_distanceSq(const PlatformIndex *index, uint8_t id, const Vector3 *position)
+{
+  float dx = index->x[id] - position->x;
+  float dy = index->y[id] - position->y;
+  float dz = index->z[id] - position->z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+// Runs the trailing block for every platform id stored in the cells overlapping the XY rectangle
+#define PLATFORM_INDEX_FOREACH(index, min_x, min_y, max_x, max_y, id, ...)                      \
+  {                                                                                             \
+    int cx0_ = platformIndex_axisCell(min_x), cx1_ = platformIndex_axisCell(max_x);             \
+    int cy0_ = platformIndex_axisCell(min_y), cy1_ = platformIndex_axisCell(max_y);             \
+    for (int cy_ = cy0_; cy_ <= cy1_; cy_++)                                                    \
+    {                                                                                           \
+      for (int cx_ = cx0_; cx_ <= cx1_; cx_++)                                                  \
+      {                                                                                         \
+        int cell_ = cy_ * PLATFORM_INDEX_GRID + cx_;                                            \
+        for (size_t i_ = 0; i_ < (index)->cellCount[cell_]; i_++)                               \
+        {                                                                                       \
+          uint8_t id = (index)->cellItems[cell_][i_];                                           \
+          __VA_ARGS__                                                                           \
+        }                                                                                       \
+      }                                                                                         \
+    }                                                                                           \
+  }
+
+// Point lookup, returns the id of the closest platform within 'radius' or -1
+int platformIndex_nearest(const PlatformIndex *index, const Vector3 *position, float radius)
+{
+  int nearest = -1;
+  float min_distance_sq = radius * radius;
+
+  PLATFORM_INDEX_FOREACH(index, position->x - radius, position->y - radius, position->x + radius, position->y + radius, id, {
+    float distance_sq = platformIndex_distanceSq(index, id, position);
+    if (distance_sq <= min_distance_sq)
+    {
+      min_distance_sq = distance_sq;
+      nearest = id;
+    }
+  })
+
+  return nearest;
+}
+
+size_t platformIndex_queryRadius(const PlatformIndex *index, const Vector3 *position, float radius, uint8_t *out, size_t max)
+{
+  size_t count = 0;
+  const float radius_sq = radius * radius;
+
+  PLATFORM_INDEX_FOREACH(index, position->x - radius, position->y - radius, position->x + radius, position->y + radius, id, {
+    if (count < max && platformIndex_distanceSq(index, id, position) <= radius_sq)
+      out[count++] = id;
+  })
+
+  return count;
+}
+
+// Platforms whose bounding sphere touches the capsule, used as the broadphase before the box tests
+size_t platformIndex_queryCapsule(const PlatformIndex *index, const Capsule *capsule, uint8_t *out, size_t max)
+{
+  size_t count = 0;
+  const float reach = capsule->radius + PLATFORM_INDEX_BOUNDS;
+  const float reach_sq = reach * reach;
+
+  float min_x = fminf(capsule->start.x, capsule->end.x) - reach;
+  float min_y = fminf(capsule->start.y, capsule->end.y) - reach;
+  float max_x = fmaxf(capsule->start.x, capsule->end.x) + reach;
+  float max_y = fmaxf(capsule->start.y, capsule->end.y) + reach;
+
+  Vector3 axis = vector3_difference(&capsule->end, &capsule->start);
+  float axis_length_sq = vector3_squaredMagnitude(&axis);
+
+  PLATFORM_INDEX_FOREACH(index, min_x, min_y, max_x, max_y, id, {
+    // Closest point on the capsule segment to the platform centre
+    Vector3 centre = {index->x[id], index->y[id], index->z[id]};
+    Vector3 to_centre = vector3_difference(&centre, &capsule->start);
+    float t = axis_length_sq > 0.0f ? vector3_returnDotProduct(&to_centre, &axis) / axis_length_sq : 0.0f;
+    t = fminf(fmaxf(t, 0.0f), 1.0f);
+    Vector3 closest = {
+        capsule->start.x + axis.x * t,
+        capsule->start.y + axis.y * t,
+        capsule->start.z + axis.z * t};
+
+    if (count < max && platformIndex_distanceSq(index, id, &closest) <= reach_sq)
+      out[count++] = id;
+  })
+
+  return count;
+}
+
+// Cheapest platform at or above 'min_height' within 'radius', returns its id or -1
+// 'cost' sees every candidate (plain squared distance when NULL), so filters and penalties can't push out the best one
+int platformIndex_nearestSafe(const PlatformIndex *index, const Vector3 *position, float min_height, float radius, PlatformIndexCostFn cost, void *context)
+{
+  int best = -1;
+  float best_cost = FLT_MAX;
+  const float radius_sq = radius * radius;
+
+  PLATFORM_INDEX_FOREACH(index, position->x - radius, position->y - radius, position->x + radius, position->y + radius, id, {
+    if (index->z[id] < min_height)
+      continue;
+
+    float distance_sq = platformIndex_distanceSq(index, id, position);
+    if (distance_sq > radius_sq)
+      continue;
+
+    float c = cost != NULL ? cost(id, distance_sq, context) : distance_sq;
+    if (c >= 0.0f && c < best_cost)
+    {
+      best_cost = c;
+      best = id;
+    }
+  })
+
+  return best;
+}
+
+// First platform bounding sphere hit by the ray, returns its id or -1
+int platformIndex_raycast(const PlatformIndex *index, const Ray *ray, float max_distance, float *out_distance)
+{
+  int hit = -1;
+  float nearest = max_distance;
+
+  Vector3 direction = ray->direction;
+  vector3_normalize(&direction);
+  Vector3 end = {
+      ray->origin.x + direction.x * max_distance,
+      ray->origin.y + direction.y * max_distance,
+      ray->origin.z + direction.z * max_distance};
+
+  float min_x = fminf(ray->origin.x, end.x) - PLATFORM_INDEX_BOUNDS;
+  float min_y = fminf(ray->origin.y, end.y) - PLATFORM_INDEX_BOUNDS;
+  float max_x = fmaxf(ray->origin.x, end.x) + PLATFORM_INDEX_BOUNDS;
+  float max_y = fmaxf(ray->origin.y, end.y) + PLATFORM_INDEX_BOUNDS;
+
+  PLATFORM_INDEX_FOREACH(index, min_x, min_y, max_x, max_y, id, {
+    Vector3 centre = {index->x[id], index->y[id], index->z[id]};
+    Vector3 oc = vector3_difference(&centre, &ray->origin);
+    float along = vector3_returnDotProduct(&oc, &direction);
+    float perp_sq = vector3_squaredMagnitude(&oc) - along * along;
+    float bounds_sq = PLATFORM_INDEX_BOUNDS * PLATFORM_INDEX_BOUNDS;
+    if (perp_sq > bounds_sq)
+      continue;
+
+    float t = along - sqrtf(bounds_sq - perp_sq);
+    if (t < 0.0f)
+      t = 0.0f; // Origin inside the bounds
+    if (t <= nearest && along + sqrtf(bounds_sq - perp_sq) >= 0.0f)
+    {
+      nearest = t;
+      hit = id;
+    }
+  })
+
+  if (hit >= 0 && out_distance != NULL)
+    *out_distance = nearest;
+  return hit;
+}
+
+#endif // PLATFORM_INDEX_H
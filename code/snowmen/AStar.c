@@ -218,3 +218,60 @@ void NodeDA_Free(NodeDynamicArray* NodeDA)
         free(array);
     }
 }
+
+
+
+NavGraphFile* NavGraph_Load(const char* path, NodeDynamicArray* AllNodes)
+{
+    int size = 0;
+    NavGraphFile* graph = asset_load(path, &size);
+    if(memcmp(graph->magic, "NAV", 3) != 0)
+    {
+        assertf(false, "Invalid nav graph file: %s", path);
+    }
+    assertf(graph->version == 1, "Invalid nav graph version: %d != %d\n", 1, graph->version);
+
+    //turn offsets into pointers, the neighbor lists of all nodes share one table
+    uint8_t* base = (uint8_t*)graph;
+    node* nodes = (node*)(base + graph->nodesOffset);
+    node** table = (node**)(base + graph->tableOffset);
+
+    for (int i = 0; i < graph->nodeCount + graph->edgeCount; i++)
+    {
+        table[i] = (node*)(base + (uintptr_t)table[i]);
+    }
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        nodes[i].neighbors.nodeArray = (node**)(base + (uintptr_t)nodes[i].neighbors.nodeArray);
+    }
+
+    *AllNodes = (NodeDynamicArray){
+        .nodeArray = table,
+        .length = graph->nodeCount,
+        .AllocatedLength = graph->nodeCount
+    };
+    return graph;
+}
+
+node* NavGraph_FindNode(NodeDynamicArray* AllNodes, int id)
+{
+    for (int i = 0; i < AllNodes->length; i++)
+    {
+        if (AllNodes->nodeArray[i]->id == id)
+        {
+            return AllNodes->nodeArray[i];
+        }
+    }
+    assertf(false, "Nav graph node %d not found", id);
+    return NULL;
+}
+
+void NavGraph_Free(NavGraphFile* graph, NodeDynamicArray* AllNodes)
+{
+    *AllNodes = (NodeDynamicArray){
+        .nodeArray = NULL,
+        .length = 0,
+        .AllocatedLength = 0
+    };
+    free(graph);
+}
@@ -35,6 +35,28 @@ typedef struct node{
 void AStarRun(node* start, node* destination, NodeDynamicArray* path);
 
 
+//Navigation graph baked by my_tools/gltf_collision_importer (--nav)
+//The file mirrors the node struct, all pointers are stored as offsets from the start of the file
+typedef struct {
+    char magic[3];
+    uint8_t version;
+    uint16_t nodeCount;
+    uint16_t edgeCount;
+    uint32_t nodesOffset;
+    uint32_t tableOffset;//one pointer per node (all nodes), followed by all neighbor lists
+} NavGraphFile;
+
+_Static_assert(sizeof(node) == 40, "node layout must match the baked .nav file");
+
+//Loads the graph with a single allocation, AllNodes points into it afterwards and must not be grown or freed with NodeDA_Free
+NavGraphFile* NavGraph_Load(const char* path, NodeDynamicArray* AllNodes);
+
+//Returns the node with this id, anchors keep the id they were given in the .navcfg
+node* NavGraph_FindNode(NodeDynamicArray* AllNodes, int id);
+
+void NavGraph_Free(NavGraphFile* graph, NodeDynamicArray* AllNodes);
+
+
 
 
 
@@ -4,6 +4,7 @@
 */
 #pragma once
 
+#include <algorithm>
 #include <cstdio>
 #include <unordered_map>
 #include "types.h"
@@ -108,9 +109,31 @@ class BinaryFile
       return dataSize;
     }
 
+    std::vector<uint8_t> getData() const {
+      return {data.begin(), data.begin() + dataSize};
+    }
+
     void writeToFile(const char* filename) {
       FILE* file = fopen(filename, "wb");
       fwrite(data.data(), 1, dataSize, file);
       fclose(file);
     }
+
+    // Skips the write if the file already has the same content and returns false, true if it wrote.
+    // Only saves work when the output is used as written, e.g. the checked in assets/snowmen/*.col that
+    // filesystem/ copies from. A file mkasset compresses in place never matches and is always rewritten,
+    // and as a make target a skipped write stays older than its source, so the recipe runs again.
+    bool writeToFileIfChanged(const char* filename) {
+      FILE* file = fopen(filename, "rb");
+      if(file) {
+        std::vector<uint8_t> oldData(dataSize + 1);
+        size_t oldSize = fread(oldData.data(), 1, oldData.size(), file);
+        fclose(file);
+        if(oldSize == dataSize && std::equal(data.begin(), data.begin() + dataSize, oldData.begin())) {
+          return false;
+        }
+      }
+      writeToFile(filename);
+      return true;
+    }
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 */
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 inline uint32_t stringHash(const std::string &str)
@@ -13,4 +14,15 @@ inline uint32_t stringHash(const std::string &str)
     hash = (hash >> 8) ^ (hash << 24) ^ c;
   }
   return hash;
-}
\ No newline at end of file
+}
+
+// FNV-1a over raw bytes, pass a previous result as 'hash' to chain data together
+inline uint64_t dataHash(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+{
+  auto bytes = (const uint8_t*)data;
+  for(size_t i=0; i<size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
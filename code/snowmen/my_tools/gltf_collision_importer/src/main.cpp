@@ -7,6 +7,9 @@
 #include <filesystem>
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <fstream>
+#include <iterator>
 
 #include "structs.h"
 #include "parser.h"
@@ -17,6 +20,8 @@
 #include "converter/converter.h"
 #include "parser/rdp.h"
 #include "optimizer/optimizer.h"
+#include "nav/navGraph.h"
+#include "meshCache.h"
 
 Config config;
 
@@ -59,6 +64,18 @@ namespace {
     return path;
   }
 
+  double getMsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  void writeOutput(BinaryFile &file, const std::string &path, ImportStats &stats) {
+    if(file.writeToFileIfChanged(path.c_str())) {
+      ++stats.filesWritten;
+    } else {
+      ++stats.filesUnchanged;
+    }
+  }
+
   std::string getStreamDataPath(const char* filePath, uint32_t idx) {
     auto sdataPath = std::string(filePath).substr(0, std::string(filePath).size()-5);
     std::replace(sdataPath.begin(), sdataPath.end(), '\\', '/');
@@ -70,7 +87,7 @@ int main(int argc, char* argv[])
 {
     EnvArgs args{argc, argv};
   if(args.checkArg("--help")) {
-    printf("Usage: %s <gltf-file> <t3dm-file> [--bvh] [--base-scale=64] [--ignore-materials] [--verbose]\n", argv[0]);
+    printf("Usage: %s <gltf-file> <t3dm-file> [--bvh] [--base-scale=64] [--ignore-materials] [--verbose] [--nav=<nav-config>] [--cache=<dir>] [--stats]\n", argv[0]);
     return 1;
   }
   
@@ -83,7 +100,11 @@ int main(int argc, char* argv[])
 
   printf("gltfPath: %s & t3dmPath%s\n", gltfPath.c_str(), t3dmPath.c_str());
 
-  auto allModels = parseGLTFCustom(gltfPath.c_str(), config.globalScale);
+  // meshes and nav graphs are stored by a hash of their inputs, unchanged ones are not converted again
+  MeshCache cache{args.getStringArg("--cache")};
+  ImportStats stats{};
+
+  auto allModels = parseGLTFCustom(gltfPath.c_str(), config.globalScale, cache, stats);
   fs::path gltfBasePath{gltfPath};
   
   uint16_t totalTriCount = 0;
@@ -112,5 +133,60 @@ int main(int argc, char* argv[])
   file.setPos(0x04);
   file.write(totalTriCount);
 
-  file.writeToFile(t3dmPath.c_str());
+  auto timeStart = std::chrono::steady_clock::now();
+  writeOutput(file, t3dmPath, stats);
+  stats.timeWrite += getMsSince(timeStart);
+
+  // Optionally bake a navigation graph from the same mesh, written next to the collision file
+  if(args.checkArg("--nav")) {
+    NavConfig navConfig{};
+    if(!parseNavConfig(args.getStringArg("--nav"), navConfig)) {
+      return 1;
+    }
+
+    std::string navPath = t3dmPath.substr(0, t3dmPath.size() - replacement.size()) + ".nav";
+    BinaryFile navFile{};
+    NavStats navStats{};
+
+    // the bake only depends on the triangles and the config file, a cache entry is the stats followed by the graph
+    timeStart = std::chrono::steady_clock::now();
+    std::ifstream navConfigFile{args.getStringArg("--nav"), std::ios::binary};
+    std::string navConfigText{std::istreambuf_iterator<char>(navConfigFile), {}};
+    const auto &tris = allModels[0].triangles;
+    uint64_t navKey = MeshCache::seedKey(navConfigText.data(), navConfigText.size());
+    navKey = dataHash(tris.data(), tris.size() * sizeof(TriangleT3D), navKey);
+
+    std::vector<uint8_t> navEntry{};
+    if(cache.loadBytes(navKey, "nav", navEntry) && navEntry.size() >= sizeof(NavStats)) {
+      memcpy(&navStats, navEntry.data(), sizeof(NavStats));
+      navFile.writeArray(navEntry.data() + sizeof(NavStats), navEntry.size() - sizeof(NavStats));
+    } else {
+      navStats = bakeNavGraph(allModels[0], navConfig, navFile);
+      navEntry.resize(sizeof(NavStats));
+      memcpy(navEntry.data(), &navStats, sizeof(NavStats));
+      auto navData = navFile.getData();
+      navEntry.insert(navEntry.end(), navData.begin(), navData.end());
+      cache.storeBytes(navKey, "nav", navEntry);
+    }
+    stats.timeNav += getMsSince(timeStart);
+
+    timeStart = std::chrono::steady_clock::now();
+    writeOutput(navFile, navPath, stats);
+    stats.timeWrite += getMsSince(timeStart);
+
+    printf("navPath: %s, walls: %d, nodes: %d (%d sampled, %d unreachable), edges: %d (%d blocked, %d pruned)\n",
+      navPath.c_str(), navStats.wallCount, navStats.nodeCount, navStats.sampleCount, navStats.unreachable,
+      navStats.edgeCount, navStats.edgesBlocked, navStats.edgesPruned
+    );
+  }
+
+  if(args.checkArg("--stats")) {
+    printf("Stats: parse %.2fms, build %.2fms (%d meshes), nav %.2fms, write %.2fms (%d written, %d unchanged)\n",
+      stats.timeParse, stats.timeBuild, stats.meshCount, stats.timeNav, stats.timeWrite,
+      stats.filesWritten, stats.filesUnchanged
+    );
+    if(cache.isEnabled()) {
+      printf("Cache: %d hits, %d misses\n", cache.hits, cache.misses);
+    }
+  }
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+* @copyright 2024 - Max Bebök
+* @license MIT
+*/
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "structs.h"
+#include "hash.h"
+
+/**
+ * On-disk cache of converted data, keyed by a content hash of everything the conversion reads.
+ * Entries are raw host memory dumps, so the directory is only meant for the machine that wrote it.
+ * An empty directory disables the cache, every lookup then misses and nothing is stored.
+ */
+class MeshCache
+{
+  private:
+    // bump this when the conversion changes, so old entries are no longer found
+    constexpr static uint32_t VERSION = 1;
+
+    std::filesystem::path dir{};
+
+    std::filesystem::path getPath(uint64_t key, const char* ext) const {
+      char name[32];
+      snprintf(name, sizeof(name), "%016llx.%s", (unsigned long long)key, ext);
+      return dir / name;
+    }
+
+    bool readFile(uint64_t key, const char* ext, std::vector<uint8_t> &out) const {
+      if(!isEnabled())return false;
+      std::ifstream file{getPath(key, ext), std::ios::binary | std::ios::ate};
+      if(!file)return false;
+      out.resize(file.tellg());
+      file.seekg(0);
+      return (bool)file.read((char*)out.data(), out.size());
+    }
+
+  public:
+    uint32_t hits{};
+    uint32_t misses{};
+
+    explicit MeshCache(const std::string &cacheDir) : dir{cacheDir} {
+      if(!dir.empty())std::filesystem::create_directories(dir);
+    }
+
+    bool isEnabled() const {
+      return !dir.empty();
+    }
+
+    // seeds a key with the cache version and the given settings
+    static uint64_t seedKey(const void* settings, size_t size) {
+      return dataHash(settings, size, dataHash(&VERSION, sizeof(VERSION)));
+    }
+
+    bool loadBytes(uint64_t key, const char* ext, std::vector<uint8_t> &out) {
+      bool found = readFile(key, ext, out);
+      found ? ++hits : ++misses;
+      return found;
+    }
+
+    void storeBytes(uint64_t key, const char* ext, const std::vector<uint8_t> &data) {
+      if(!isEnabled())return;
+      // write to a temp. file first, a crash mid-write should not leave a broken entry behind
+      auto path = getPath(key, ext);
+      auto tmpPath = path;
+      tmpPath += ".tmp";
+      {
+        std::ofstream file{tmpPath, std::ios::binary};
+        file.write((const char*)data.data(), data.size());
+        if(!file)return;
+      }
+      std::filesystem::rename(tmpPath, path);
+    }
+
+    bool loadTriangles(uint64_t key, std::vector<TriangleT3D> &out) {
+      std::vector<uint8_t> data{};
+      // broken entries count as a miss, the caller will overwrite them
+      if(!readFile(key, "tri", data) || data.size() % sizeof(TriangleT3D) != 0) {
+        ++misses;
+        return false;
+      }
+      ++hits;
+      out.resize(data.size() / sizeof(TriangleT3D));
+      memcpy(out.data(), data.data(), data.size());
+      return true;
+    }
+
+    void storeTriangles(uint64_t key, const std::vector<TriangleT3D> &triangles) {
+      auto bytes = (const uint8_t*)triangles.data();
+      storeBytes(key, "tri", {bytes, bytes + triangles.size() * sizeof(TriangleT3D)});
+    }
+};
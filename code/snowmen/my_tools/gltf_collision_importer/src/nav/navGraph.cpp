@@ -0,0 +1,321 @@
+/**
+* @copyright 2024 - Max Bebök
+* @license MIT
+*/
+#include "navGraph.h"
+
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+namespace {
+  constexpr uint8_t NAV_VERSION = 1;
+  constexpr uint32_t HEADER_SIZE = 16;
+  constexpr uint32_t NODE_SIZE = 40; // sizeof(node) on the N64
+  constexpr int32_t SAMPLE_ID_BASE = 100; // ids of sampled nodes, anchors use their own ids
+  constexpr float EDGE_LENGTH_FACTOR = 1.5f; // connects a grid sample to its 8 neighbours
+  constexpr float PRUNE_TOLERANCE = 1.01f;
+
+  // walls projected onto the XZ plane
+  struct Seg2D {
+    float ax, az, bx, bz;
+  };
+
+  struct NavNode {
+    float x, y, z;
+    float clearance;
+    int32_t id;
+    std::vector<uint32_t> neighbors{};
+  };
+
+  float distPointSeg(float px, float pz, const Seg2D &s) {
+    float dx = s.bx - s.ax;
+    float dz = s.bz - s.az;
+    float len2 = dx*dx + dz*dz;
+    float t = len2 > 0.0f ? ((px - s.ax) * dx + (pz - s.az) * dz) / len2 : 0.0f;
+    t = std::clamp(t, 0.0f, 1.0f);
+    float cx = s.ax + dx * t - px;
+    float cz = s.az + dz * t - pz;
+    return sqrtf(cx*cx + cz*cz);
+  }
+
+  float cross2D(float ax, float az, float bx, float bz) {
+    return ax * bz - az * bx;
+  }
+
+  float distSegSeg(const Seg2D &a, const Seg2D &b) {
+    float rX = a.bx - a.ax, rZ = a.bz - a.az;
+    float sX = b.bx - b.ax, sZ = b.bz - b.az;
+    float denom = cross2D(rX, rZ, sX, sZ);
+    if(denom != 0.0f) {
+      float t = cross2D(b.ax - a.ax, b.az - a.az, sX, sZ) / denom;
+      float u = cross2D(b.ax - a.ax, b.az - a.az, rX, rZ) / denom;
+      if(t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f)return 0.0f;
+    }
+    return std::min({
+      distPointSeg(a.ax, a.az, b), distPointSeg(a.bx, a.bz, b),
+      distPointSeg(b.ax, b.az, a), distPointSeg(b.bx, b.bz, a)
+    });
+  }
+
+  float getClearance(float x, float z, const std::vector<Seg2D> &walls) {
+    float res = INFINITY;
+    for(auto &w : walls)res = std::min(res, distPointSeg(x, z, w));
+    return res;
+  }
+
+  bool hasLineOfSight(const NavNode &a, const NavNode &b, float radius, const std::vector<Seg2D> &walls) {
+    Seg2D path{a.x, a.z, b.x, b.z};
+    for(auto &w : walls) {
+      if(distSegSeg(path, w) < radius)return false;
+    }
+    return true;
+  }
+
+  float nodeDist(const NavNode &a, const NavNode &b) {
+    float dx = a.x - b.x;
+    float dz = a.z - b.z;
+    return sqrtf(dx*dx + dz*dz);
+  }
+}
+
+bool parseNavConfig(const std::string &path, NavConfig &conf)
+{
+  std::ifstream file{path};
+  if(!file.is_open()) {
+    fprintf(stderr, "Error: can't open nav config: %s\n", path.c_str());
+    return false;
+  }
+
+  std::string line;
+  uint32_t lineNum = 0;
+  while(std::getline(file, line))
+  {
+    ++lineNum;
+    auto commentPos = line.find('#');
+    if(commentPos != std::string::npos)line = line.substr(0, commentPos);
+
+    std::istringstream str{line};
+    std::string cmd;
+    if(!(str >> cmd))continue;
+
+    bool ok = true;
+    if(cmd == "offset") {
+      ok = !!(str >> conf.offset[0] >> conf.offset[1] >> conf.offset[2]);
+    } else if(cmd == "spacing") {
+      ok = !!(str >> conf.spacing) && conf.spacing > 0.0f;
+    } else if(cmd == "radius") {
+      ok = !!(str >> conf.radius);
+    } else if(cmd == "height") {
+      ok = !!(str >> conf.minY >> conf.maxY);
+    } else if(cmd == "anchor") {
+      NavAnchor anchor{};
+      ok = !!(str >> anchor.id >> anchor.pos[0] >> anchor.pos[1] >> anchor.pos[2]);
+      str >> anchor.name;
+      if(ok && anchor.id >= SAMPLE_ID_BASE) {
+        fprintf(stderr, "Error: %s:%d: anchor ids must be below %d\n", path.c_str(), lineNum, SAMPLE_ID_BASE);
+        return false;
+      }
+      conf.anchors.push_back(anchor);
+    } else {
+      ok = false;
+    }
+
+    if(!ok) {
+      fprintf(stderr, "Error: %s:%d: invalid line '%s'\n", path.c_str(), lineNum, line.c_str());
+      return false;
+    }
+  }
+
+  if(conf.anchors.empty()) {
+    fprintf(stderr, "Error: %s: no anchors, can't tell which part of the level is walkable\n", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+NavStats bakeNavGraph(const ModelCustom &model, const NavConfig &conf, BinaryFile &file)
+{
+  NavStats stats{};
+
+  // Collect all walls that block movement, and the area they span
+  std::vector<Seg2D> walls{};
+  float minX = INFINITY, minZ = INFINITY;
+  float maxX = -INFINITY, maxZ = -INFINITY;
+
+  for(auto &tri : model.triangles)
+  {
+    float triMinY = INFINITY, triMaxY = -INFINITY;
+    for(auto &v : tri.vert) {
+      triMinY = std::min(triMinY, v.pos[1] + conf.offset[1]);
+      triMaxY = std::max(triMaxY, v.pos[1] + conf.offset[1]);
+    }
+    if(triMaxY < conf.minY || triMinY > conf.maxY)continue;
+
+    for(int i=0; i<3; ++i) {
+      auto &a = tri.vert[i].pos;
+      auto &b = tri.vert[(i+1) % 3].pos;
+      Seg2D seg{
+        a[0] + conf.offset[0], a[2] + conf.offset[2],
+        b[0] + conf.offset[0], b[2] + conf.offset[2]
+      };
+      minX = std::min({minX, seg.ax, seg.bx});
+      maxX = std::max({maxX, seg.ax, seg.bx});
+      minZ = std::min({minZ, seg.az, seg.bz});
+      maxZ = std::max({maxZ, seg.az, seg.bz});
+      walls.push_back(seg);
+    }
+    ++stats.wallCount;
+  }
+
+  // Anchors always come first, the game looks them up by id...
+  std::vector<NavNode> nodes{};
+  for(auto &anchor : conf.anchors) {
+    nodes.push_back({
+      .x = anchor.pos[0], .y = anchor.pos[1], .z = anchor.pos[2],
+      .clearance = getClearance(anchor.pos[0], anchor.pos[2], walls),
+      .id = anchor.id
+    });
+  }
+
+  // ...then sample the walkable area on a grid, keeping enough distance to any wall
+  if(!walls.empty())
+  {
+    for(float z = minZ + conf.spacing * 0.5f; z < maxZ; z += conf.spacing) {
+      for(float x = minX + conf.spacing * 0.5f; x < maxX; x += conf.spacing) {
+        float clearance = getClearance(x, z, walls);
+        if(clearance < conf.radius)continue;
+        nodes.push_back({
+          .x = x, .y = conf.minY, .z = z,
+          .clearance = clearance,
+          .id = SAMPLE_ID_BASE + (int32_t)stats.sampleCount
+        });
+        ++stats.sampleCount;
+      }
+    }
+  }
+
+  // Connect nearby nodes that can see each other
+  float maxEdgeLen = conf.spacing * EDGE_LENGTH_FACTOR;
+  for(uint32_t a=0; a<nodes.size(); ++a) {
+    for(uint32_t b=a+1; b<nodes.size(); ++b) {
+      if(nodeDist(nodes[a], nodes[b]) > maxEdgeLen)continue;
+
+      // anchors may sit closer to a wall than the agent radius, don't let that block their own edges
+      float radius = std::min({conf.radius, nodes[a].clearance, nodes[b].clearance}) * 0.9f;
+      if(!hasLineOfSight(nodes[a], nodes[b], radius, walls)) {
+        ++stats.edgesBlocked;
+        continue;
+      }
+      nodes[a].neighbors.push_back(b);
+      nodes[b].neighbors.push_back(a);
+    }
+  }
+
+  // Drop edges that are just a shortcut over a node lying (almost) on the same line
+  auto isConnected = [&](uint32_t a, uint32_t b) {
+    auto &n = nodes[a].neighbors;
+    return std::find(n.begin(), n.end(), b) != n.end();
+  };
+
+  for(uint32_t a=0; a<nodes.size(); ++a) {
+    auto &neighbors = nodes[a].neighbors;
+    for(uint32_t i=0; i<neighbors.size(); ++i) {
+      uint32_t b = neighbors[i];
+      if(b < a)continue;
+      float distAB = nodeDist(nodes[a], nodes[b]);
+
+      bool redundant = false;
+      for(uint32_t c : neighbors) {
+        if(c == b || !isConnected(c, b))continue;
+        if(nodeDist(nodes[a], nodes[c]) + nodeDist(nodes[c], nodes[b]) <= distAB * PRUNE_TOLERANCE) {
+          redundant = true;
+          break;
+        }
+      }
+      if(!redundant)continue;
+
+      neighbors.erase(neighbors.begin() + i);
+      auto &neighborsB = nodes[b].neighbors;
+      neighborsB.erase(std::find(neighborsB.begin(), neighborsB.end(), a));
+      ++stats.edgesPruned;
+      --i;
+    }
+  }
+
+  // Only keep what can be reached from an anchor, this removes samples inside closed-off geometry
+  std::vector<int32_t> newIndex(nodes.size(), -1);
+  std::vector<uint32_t> order{};
+  std::vector<uint32_t> stack{};
+  for(uint32_t a=0; a<conf.anchors.size(); ++a) {
+    if(newIndex[a] >= 0)continue;
+    stack.push_back(a);
+    newIndex[a] = 0;
+    while(!stack.empty()) {
+      uint32_t n = stack.back();
+      stack.pop_back();
+      for(uint32_t next : nodes[n].neighbors) {
+        if(newIndex[next] >= 0)continue;
+        newIndex[next] = 0;
+        stack.push_back(next);
+      }
+    }
+  }
+
+  // anchors keep their order, everything else follows in sampling order
+  for(uint32_t n=0; n<nodes.size(); ++n) {
+    if(n < conf.anchors.size() || newIndex[n] >= 0) {
+      newIndex[n] = (int32_t)order.size();
+      order.push_back(n);
+    }
+  }
+  stats.unreachable = nodes.size() - order.size();
+  stats.nodeCount = order.size();
+
+  for(auto n : order) {
+    if(nodes[n].neighbors.empty()) {
+      fprintf(stderr, "Warning: nav node %d has no neighbours\n", nodes[n].id);
+    }
+    stats.edgeCount += nodes[n].neighbors.size();
+  }
+
+  // Write the file, all references are byte offsets from the start of the file.
+  // The table holds one entry per node (used as the list of all nodes), followed by all neighbour lists.
+  uint32_t nodesOffset = HEADER_SIZE;
+  uint32_t tableOffset = nodesOffset + stats.nodeCount * NODE_SIZE;
+  auto nodeOffset = [&](uint32_t n) { return nodesOffset + newIndex[n] * NODE_SIZE; };
+
+  file.writeChars("NAV", 3);
+  file.write<uint8_t>(NAV_VERSION);
+  file.write<uint16_t>(stats.nodeCount);
+  file.write<uint16_t>(stats.edgeCount);
+  file.write<uint32_t>(nodesOffset);
+  file.write<uint32_t>(tableOffset);
+
+  uint32_t neighborOffset = tableOffset + stats.nodeCount * sizeof(uint32_t);
+  for(auto n : order) {
+    auto &node = nodes[n];
+    file.write<uint32_t>(neighborOffset); // neighbors.nodeArray
+    file.write<int32_t>(node.neighbors.size()); // neighbors.length
+    file.write<int32_t>(node.neighbors.size()); // neighbors.AllocatedLength
+    file.write<uint32_t>(0); // backConnection
+    file.write(node.x);
+    file.write(node.y);
+    file.write(node.z);
+    file.write(0.0f); // G
+    file.write(0.0f); // H
+    file.write<int32_t>(node.id);
+    neighborOffset += node.neighbors.size() * sizeof(uint32_t);
+  }
+
+  for(auto n : order)file.write<uint32_t>(nodeOffset(n));
+  for(auto n : order) {
+    for(auto neighbor : nodes[n].neighbors) {
+      file.write<uint32_t>(nodeOffset(neighbor));
+    }
+  }
+
+  return stats;
+}
@@ -0,0 +1,47 @@
+/**
+* @copyright 2024 - Max Bebök
+* @license MIT
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../structs.h"
+#include "../binaryFile.h"
+
+struct NavAnchor {
+  int32_t id{};
+  Vec3 pos{};
+  std::string name{};
+};
+
+struct NavConfig {
+  Vec3 offset{};
+  float spacing{24.0f};
+  float radius{6.0f};
+  float minY{0.0f};
+  float maxY{20.0f};
+  std::vector<NavAnchor> anchors{};
+};
+
+struct NavStats {
+  uint32_t wallCount{};
+  uint32_t sampleCount{};
+  uint32_t nodeCount{};
+  uint32_t edgeCount{};
+  uint32_t edgesBlocked{};
+  uint32_t edgesPruned{};
+  uint32_t unreachable{};
+};
+
+/**
+ * Reads the bake settings and anchor nodes from a text file.
+ * Returns false and prints an error if the file can't be parsed.
+ */
+bool parseNavConfig(const std::string &path, NavConfig &conf);
+
+/**
+ * Bakes a navigation graph from the wall triangles of 'model' and writes it to 'file'.
+ * The layout mirrors the runtime 'node' struct of the game, so it can be used after a single load + pointer fixup.
+ */
+NavStats bakeNavGraph(const ModelCustom &model, const NavConfig &conf, BinaryFile &file);
@@ -6,6 +6,7 @@
 #define CGLTF_IMPLEMENTATION
 
 #include <string>
+#include <chrono>
 #include "parser.h"
 #include "hash.h"
 
@@ -24,6 +25,21 @@ namespace {
     "Blender I/O v4.3",
     "Blender I/O v4.4",
   };
+
+  double getMsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // hashes the same bytes the parser reads from an accessor (tightly packed, no stride)
+  uint64_t hashAccessor(const cgltf_accessor *acc, uint64_t hash) {
+    hash = dataHash(&acc->type, sizeof(acc->type), hash);
+    hash = dataHash(&acc->component_type, sizeof(acc->component_type), hash);
+    hash = dataHash(&acc->count, sizeof(acc->count), hash);
+
+    auto basePtr = ((uint8_t*)acc->buffer_view->buffer->data) + acc->buffer_view->offset + acc->offset;
+    auto size = acc->count * cgltf_num_components(acc->type) * Gltf::getDataSize(acc->component_type);
+    return dataHash(basePtr, size, hash);
+  }
 }
 
 void printBoneTree(const Bone &bone, int depth)
@@ -36,8 +52,9 @@ void printBoneTree(const Bone &bone, int depth)
   }
 }
 
-std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
+std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale, MeshCache &cache, ImportStats &stats)
 {
+  auto timeStart = std::chrono::steady_clock::now();
   std::vector<ModelCustom> allModels{};
   T3DMData t3dm{};
   fs::path gltfBasePath{gltfPath};
@@ -59,6 +76,8 @@ std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
 
   cgltf_load_buffers(&options, data, gltfPath);
 
+  stats.timeParse += getMsSince(timeStart);
+  timeStart = std::chrono::steady_clock::now();
 
   // Meshes
   for(int i=0; i<data->nodes_count; ++i)
@@ -79,6 +98,26 @@ std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
 
       auto prim = &mesh->primitives[j];
       //printf("   - Primitive %d:\n", j);
+      ++stats.meshCount;
+
+      // the triangles only depend on the transform, scale, indices, positions and normals
+      Mat4 mat = parseNodeMatrix(node);
+      uint64_t meshKey = MeshCache::seedKey(&modelScale, sizeof(modelScale));
+      meshKey = dataHash(&mat, sizeof(mat), meshKey);
+      if(prim->indices)meshKey = hashAccessor(prim->indices, meshKey);
+      for(int k = 0; k < prim->attributes_count; k++) {
+        auto attr = &prim->attributes[k];
+        if(attr->type == cgltf_attribute_type_position || attr->type == cgltf_attribute_type_normal) {
+          meshKey = dataHash(&attr->type, sizeof(attr->type), meshKey);
+          meshKey = hashAccessor(attr->data, meshKey);
+        }
+      }
+
+      ModelCustom modelTemp;
+      if(cache.loadTriangles(meshKey, modelTemp.triangles)) {
+        allModels.push_back(modelTemp);
+        continue;
+      }
 
       /*if(prim->material) {
         parseMaterial(gltfBasePath, i, j, model, prim);
@@ -259,7 +298,6 @@ std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
 
       // convert vertices
       for(int k = 0; k < vertices.size(); k++) {
-        Mat4 mat = parseNodeMatrix(node);
         convertVertex(
           modelScale, texSizeX, texSizeY, vertices[k], verticesT3D[k],
           mat, matrixStack, model.material.uvFilterAdjust
@@ -270,9 +308,6 @@ std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
       std::vector<TriangleT3D> triangles{};
 
 
-      ModelCustom modelTemp;
-
-
       triangles.reserve(indices.size() / 3);
 
       for(int k = 0; k < indices.size(); k += 3) {
@@ -289,6 +324,7 @@ std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
       }
 
       modelTemp.triangles = triangles;
+      cache.storeTriangles(meshKey, modelTemp.triangles);
 
       allModels.push_back(modelTemp);
     }
@@ -297,6 +333,7 @@ std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale)
   }
 
   cgltf_free(data);
+  stats.timeBuild += getMsSince(timeStart);
 
   return allModels;//custom model struct
 }
@@ -6,7 +6,11 @@
 #pragma once
 
 #include "structs.h"
+#include "meshCache.h"
 
 T3DMData parseGLTF(const char* gltfPath, float modelScale);
 
-std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale);
\ No newline at end of file
+/**
+ * Reads the triangles of every mesh primitive, primitives whose data didn't change are taken from 'cache'.
+ */
+std::vector<ModelCustom> parseGLTFCustom(const char *gltfPath, float modelScale, MeshCache &cache, ImportStats &stats);
\ No newline at end of file
@@ -268,6 +268,17 @@ struct Config {
 };
 extern Config config;
 
+// Time spent per stage in ms, filled when running with '--stats'
+struct ImportStats {
+  double timeParse{};
+  double timeBuild{};
+  double timeNav{};
+  double timeWrite{};
+  uint32_t meshCount{};
+  uint32_t filesWritten{};
+  uint32_t filesUnchanged{};
+};
+
 constexpr int MAX_VERTEX_COUNT = 70;
 constexpr int CACHE_VERTEX_SIZE = 36;
 constexpr u8 T3DM_VERSION = 0x03;
\ No newline at end of file
@@ -115,230 +115,36 @@ DecorationSpawnerStruct spawners[6];
 T3DVec3 DecorationSpawnerLocations[6];
 
 NodeDynamicArray AllNodes;
+NavGraphFile* navGraph;
 
 //NodeDynamicArray testpath;
 
-node snowman1Node;
-node snowman2Node;
-node snowman3Node;
-node snowman4Node;
-/*-101.684120 0.000000 -141.909805 snowman1
--31.307348 0.000000 -140.445984 snowman2
-35.772903 0.000000 -139.050888 snowman3
-106.547562 0.000000 -137.578674 snowman4*/
-
-node C0Node;
-node C1Node;
-/*0.135193 0.000000 -93.605042 C0 -> C1,snowmen
-0.892233 0.000000 -57.207928 C1*/// -> C0,L0,R0
-
-node L0Node;
-node L1Node;
-node L2Node;
-node L3Node;
-node L4Node;
-node L5Node;//-166.653915f, 0.000000f, 82.444191f ->L4,D3
-node L6Node;
-/*-111.639977 0.000000 -56.476646 L0 ->l1,C1
--109.684357 0.000000 12.494196 L1 ->l2,L3,L0
--162.150879 0.000000 5.277177 L2 ->L1
--48.901482 0.000000 13.950903 L3 ->L1,L4
--49.950420 0.000000 64.379837 L4*/ // -> L3,C2, L5
-
-node R0Node;
-node R1Node;
-node R2Node;
-node R3Node;
-node R4Node;//169.024796f, 0.000000f, 78.730408f ->R2, D6
-node R5Node;//58.913193f, 0.000000f, 79.480339f ->C2, D5
-/*110.508446 0.000000 -51.856239 R0 ->R1,C1
-109.186836 0.000000 11.676569 R1 ->R0,R2,R3
-168.890137 0.000000 -2.212346 R2 ->R1, R4
-52.365280 0.000000 14.744545 R3*/ // -> R1
-
-node C2Node;
-/*-1.835996 0.000000 72.676994 C2*/ // -> L4, R5
-
-node decospawn1Node;//-180.469894f, 0.000000f, -24.916225f -> L2
-node decospawn2Node;//180.107773f, 0.000000f, -21.741064f -> R2
-node decospawn3Node;//-150.182495f, 0.000000f, 147.382156f -> D4, L5
-node decospawn4Node;//-57.233727f, 0.000000f, 149.315521f -> D3
-node decospawn5Node;//64.739517f, 0.000000f, 151.852951f -> R5
-node decospawn6Node;//170.096863f, 0.000000f, 156.108505f -> R4
-
-
-void BadNoGoodNodeCreation()//You're not allowed to make fun of me for doing this.
-{
-    NodeDA_Create(&AllNodes);
-    snowman1Node = (node) {.location = (T3DVec3) {{-101.684120f, 0.000000f, -141.909805f}}, .id = 91};
-    NodeDA_Add(&AllNodes, &snowman1Node);
-    NodeDA_Add(&snowman1Node.neighbors, &snowman2Node);
-    NodeDA_Add(&snowman1Node.neighbors, &snowman3Node);
-    NodeDA_Add(&snowman1Node.neighbors, &snowman4Node);
-    NodeDA_Add(&snowman1Node.neighbors, &C0Node);
-
-    snowman2Node = (node) {.location = (T3DVec3) {{-31.307348f, 0.000000f, -140.445984f}}, .id = 92};
-    NodeDA_Add(&AllNodes, &snowman2Node);
-    NodeDA_Add(&snowman2Node.neighbors, &snowman1Node);
-    NodeDA_Add(&snowman2Node.neighbors, &snowman3Node);
-    NodeDA_Add(&snowman2Node.neighbors, &snowman4Node);
-    NodeDA_Add(&snowman2Node.neighbors, &C0Node);
-
-    snowman3Node = (node) {.location = (T3DVec3) {{35.772903f, 0.000000f, -139.050888f}}, .id = 93};
-    NodeDA_Add(&AllNodes, &snowman3Node);
-    NodeDA_Add(&snowman3Node.neighbors, &snowman1Node);
-    NodeDA_Add(&snowman3Node.neighbors, &snowman2Node);
-    NodeDA_Add(&snowman3Node.neighbors, &snowman4Node);
-    NodeDA_Add(&snowman3Node.neighbors, &C0Node);
-
-    snowman4Node = (node) {.location = (T3DVec3) {{106.547562f, 0.000000f, -137.578674f}}, .id = 94};
-    NodeDA_Add(&AllNodes, &snowman4Node);
-    NodeDA_Add(&snowman4Node.neighbors, &snowman1Node);
-    NodeDA_Add(&snowman4Node.neighbors, &snowman2Node);
-    NodeDA_Add(&snowman4Node.neighbors, &snowman3Node);
-    NodeDA_Add(&snowman4Node.neighbors, &C0Node);
-
-
-    C0Node = (node) {.location = (T3DVec3) {{0.135193f, 0.000000f, -93.605042f}}, .id = 00};
-    NodeDA_Add(&AllNodes, &C0Node);
-    NodeDA_Add(&C0Node.neighbors, &C1Node);
-    NodeDA_Add(&C0Node.neighbors, &snowman1Node);
-    NodeDA_Add(&C0Node.neighbors, &snowman2Node);
-    NodeDA_Add(&C0Node.neighbors, &snowman3Node);
-    NodeDA_Add(&C0Node.neighbors, &snowman4Node);
-
-    C1Node = (node) {.location = (T3DVec3) {{0.892233f, 0.000000f, -57.207928f}}, .id = 01};
-    NodeDA_Add(&AllNodes, &C1Node);
-    NodeDA_Add(&C1Node.neighbors, &C0Node);
-    NodeDA_Add(&C1Node.neighbors, &L0Node);
-    NodeDA_Add(&C1Node.neighbors, &R0Node);
-
-    L0Node = (node) {.location = (T3DVec3) {{-111.639977f, 0.000000f, -56.476646f}}, .id = 10};
-    NodeDA_Add(&AllNodes, &L0Node);
-    NodeDA_Add(&L0Node.neighbors, &C1Node);
-    NodeDA_Add(&L0Node.neighbors, &L1Node);
-
-    L1Node = (node) {.location = (T3DVec3) {{-109.684357f, 0.000000f, 12.494196f}}, .id = 11};
-    NodeDA_Add(&AllNodes, &L1Node);
-    NodeDA_Add(&L1Node.neighbors, &L2Node);
-    NodeDA_Add(&L1Node.neighbors, &L3Node);
-    NodeDA_Add(&L1Node.neighbors, &L0Node);
-
-    L2Node = (node) {.location = (T3DVec3) {{-162.150879, 0.000000f, 5.277177f}}, .id = 12};
-    NodeDA_Add(&AllNodes, &L2Node);
-    NodeDA_Add(&L2Node.neighbors, &L1Node);
-    NodeDA_Add(&L2Node.neighbors, &decospawn1Node);
-
-    L3Node = (node) {.location = (T3DVec3) {{-48.901482f, 0.000000f, 13.950903f}}, .id = 13};
-    NodeDA_Add(&AllNodes, &L3Node);
-    NodeDA_Add(&L3Node.neighbors, &L1Node);
-    NodeDA_Add(&L3Node.neighbors, &L4Node);
-
-    L4Node = (node) {.location = (T3DVec3) {{-49.950420f, 0.000000f, 64.379837f}}, .id = 14};
-    NodeDA_Add(&AllNodes, &L4Node);
-    NodeDA_Add(&L4Node.neighbors, &L3Node);
-    NodeDA_Add(&L4Node.neighbors, &L5Node);
-    NodeDA_Add(&L4Node.neighbors, &C2Node);
-    NodeDA_Add(&L4Node.neighbors, &L6Node);
-
-    R0Node = (node) {.location = (T3DVec3) {{110.508446f, 0.000000f, -51.856239f}}, .id = 20};
-    NodeDA_Add(&AllNodes, &R0Node);
-    NodeDA_Add(&R0Node.neighbors, &R1Node);
-    NodeDA_Add(&R0Node.neighbors, &C1Node);
-
-    R1Node = (node) {.location = (T3DVec3) {{109.186836f, 0.000000f, 11.676569f}}, .id = 21};
-    NodeDA_Add(&AllNodes, &R1Node);
-    NodeDA_Add(&R1Node.neighbors, &R0Node);
-    NodeDA_Add(&R1Node.neighbors, &R2Node);
-    NodeDA_Add(&R1Node.neighbors, &R3Node);
-
-    R2Node = (node) {.location = (T3DVec3) {{168.890137f, 0.000000f, -2.212346f}}, .id = 22};
-    NodeDA_Add(&AllNodes, &R2Node);
-    NodeDA_Add(&R2Node.neighbors, &R1Node);
-    NodeDA_Add(&R2Node.neighbors, &R4Node);
-    NodeDA_Add(&R2Node.neighbors, &decospawn2Node);
-
-    R3Node = (node) {.location = (T3DVec3) {{52.365280f, 0.000000f, 14.744545f}}, .id = 23};
-    NodeDA_Add(&AllNodes, &R3Node);
-    NodeDA_Add(&R3Node.neighbors, &R1Node);
-
-    C2Node = (node) {.location = (T3DVec3) {{-1.835996f, 0.000000f, 72.676994f}}, .id = 02};
-    NodeDA_Add(&AllNodes, &C2Node);
-    NodeDA_Add(&C2Node.neighbors, &L4Node);
-    NodeDA_Add(&C2Node.neighbors, &R5Node);
-
-
-    L5Node = (node) {.location = (T3DVec3) {{-166.653915f, 0.000000f, 82.444191f}}, .id = 15};
-    NodeDA_Add(&AllNodes, &L5Node);
-    NodeDA_Add(&L5Node.neighbors, &L4Node);
-    NodeDA_Add(&L5Node.neighbors, &decospawn3Node);
-    NodeDA_Add(&L5Node.neighbors, &L6Node);
-
-    R4Node = (node) {.location = (T3DVec3) {{169.024796f, 0.000000f, 78.730408f}}, .id = 24};
-    NodeDA_Add(&AllNodes, &R4Node);
-    NodeDA_Add(&R4Node.neighbors, &R2Node);
-    NodeDA_Add(&R4Node.neighbors, &decospawn6Node);
-
-    R5Node = (node) {.location = (T3DVec3) {{58.913193f, 0.000000f, 79.480339f}}, .id = 25};
-    NodeDA_Add(&AllNodes, &R5Node);
-    NodeDA_Add(&R5Node.neighbors, &C2Node);
-    NodeDA_Add(&R5Node.neighbors, &decospawn5Node);
-
-    L6Node = (node) {.location = (T3DVec3) {{-111.5f, 0.000000f, 106.9f}}, .id = 16};
-    NodeDA_Add(&AllNodes, &L6Node);
-    NodeDA_Add(&L6Node.neighbors, &L4Node);
-    NodeDA_Add(&L6Node.neighbors, &decospawn3Node);
-    NodeDA_Add(&L6Node.neighbors, &L5Node);
-    NodeDA_Add(&L6Node.neighbors, &decospawn4Node);
-
-    
-
-
-    decospawn1Node = (node) {.location = (T3DVec3) {{-180.469894f, 0.000000f, -24.916225f}}, .id = 81};
-    NodeDA_Add(&AllNodes, &decospawn1Node);
-    NodeDA_Add(&decospawn1Node.neighbors, &L2Node);
-
-    decospawn2Node = (node) {.location = (T3DVec3) {{180.107773f, 0.000000f, -21.741064f}}, .id = 82};
-    NodeDA_Add(&AllNodes, &decospawn2Node);
-    NodeDA_Add(&decospawn2Node.neighbors, &R2Node);
-
-    decospawn3Node = (node) {.location = (T3DVec3) {{-150.182495f, 0.000000f, 147.382156f}}, .id = 83};
-    NodeDA_Add(&AllNodes, &decospawn3Node);
-    NodeDA_Add(&decospawn3Node.neighbors, &decospawn4Node);
-    NodeDA_Add(&decospawn3Node.neighbors, &L5Node);
-    NodeDA_Add(&decospawn3Node.neighbors, &L6Node);
-
-    decospawn4Node = (node) {.location = (T3DVec3) {{-57.233727f, 0.000000f, 149.315521f}}, .id = 84};
-    NodeDA_Add(&AllNodes, &decospawn4Node);
-    NodeDA_Add(&decospawn4Node.neighbors, &decospawn3Node);
-    NodeDA_Add(&decospawn4Node.neighbors, &L6Node);
-
-    decospawn5Node = (node) {.location = (T3DVec3) {{64.739517f, 0.000000f, 151.852951f}}, .id = 85};
-    NodeDA_Add(&AllNodes, &decospawn5Node);
-    NodeDA_Add(&decospawn5Node.neighbors, &R5Node);
-
-    decospawn6Node = (node) {.location = (T3DVec3) {{170.096863f, 0.000000f, 156.108505f}}, .id = 86};
-    NodeDA_Add(&AllNodes, &decospawn6Node);
-    NodeDA_Add(&decospawn6Node.neighbors, &R4Node);
-
-
-    debugf("length: %d\n", AllNodes.length);
+//anchor ids, see assets/snowmen/SnowyMapTest6_4_Collision.navcfg
+#define NAV_ID_SNOWMAN 91 //91-94, one per player
+#define NAV_ID_DECOSPAWN 81 //81-86, one per decoration spawner
+#define NAV_ID_L3 13
+#define NAV_ID_L5 15
+#define NAV_ID_R3 23
+#define NAV_ID_R5 25
 
+node* snowmanNodes[4];
+node* decospawnNodes[6];
 
 
-    //start snoman1 dest l2
-    //NodeDynamicArray testpath;
-    //AStarRun(&decospawn3Node, &snowman3Node, &testpath);
-
-    //NodeDA_Add(&testpath, &decospawn3Node);
-
-    //players[1].ai_path_index = testpath.length - 1;
+void NavGraphInit()
+{
+    navGraph = NavGraph_Load("rom:/snowmen/SnowyMapTest6_4_Collision.nav", &AllNodes);
 
-    /*for (int i = 0; i < testpath.length; i++)
+    for (int i = 0; i < 4; i++)
     {
-        debugf("Final id: %d\n", testpath.nodeArray[i]->id);
-    }*/
+        snowmanNodes[i] = NavGraph_FindNode(&AllNodes, NAV_ID_SNOWMAN + i);
+    }
+    for (int i = 0; i < 6; i++)
+    {
+        decospawnNodes[i] = NavGraph_FindNode(&AllNodes, NAV_ID_DECOSPAWN + i);
+    }
 
+    debugf("length: %d\n", AllNodes.length);
 }
 
 
@@ -387,23 +193,11 @@ node* GetNodeForGoalPickup(PickupStruct* GoalPickup, enum EAIGoalType type)
 {
     if (type == EAIGT_SpawnerPickup && GoalPickup->pickupType == EPUT_Decoration)
     {
-        switch (GoalPickup->decorationType)
-        {
-            case 1:
-                return &decospawn1Node;
-            case 2:
-                return &decospawn2Node;
-            case 3:
-                return &decospawn3Node;
-            case 4:
-                return &decospawn4Node;
-            case 5:
-                return &decospawn5Node;
-            case 6:
-                return &decospawn6Node;
-            default:
-                return NULL;
+        if (GoalPickup->decorationType >= 1 && GoalPickup->decorationType <= 6)
+        {
+            return decospawnNodes[GoalPickup->decorationType - 1];
         }
+        return NULL;
     }
     else// if (type == EAIGT_PickupIdle)
     {
@@ -418,19 +212,11 @@ node* GetNodeForGoalPickup(PickupStruct* GoalPickup, enum EAIGoalType type)
 
 node* GetNodePlayerSnowman(int id)
 {
-    switch (id)
+    if (id >= 0 && id < 4)
     {
-        case 0:
-            return &snowman1Node;
-        case 1:
-            return &snowman2Node;
-        case 2:
-            return &snowman3Node;
-        case 3:
-            return &snowman4Node;
-        default:
-            return NULL;//shouldn't get here
+        return snowmanNodes[id];
     }
+    return NULL;//shouldn't get here
 }
 
 PickupStruct* GetRandomSnowball(PlayerStruct* playerStruct, int seed)
@@ -977,7 +763,7 @@ void SetSnowballSpawnLocations(SpawnLocation locations[6])
     locations[0] = (SpawnLocation){
         .isOccupied = false,
         .pickupPtr = NULL,
-        .Pos = R3Node.location
+        .Pos = NavGraph_FindNode(&AllNodes, NAV_ID_R3)->location
     };
     locations[1] = (SpawnLocation){
         .isOccupied = false,
@@ -992,17 +778,17 @@ void SetSnowballSpawnLocations(SpawnLocation locations[6])
     locations[3] = (SpawnLocation){
         .isOccupied = false,
         .pickupPtr = NULL,
-        .Pos = R5Node.location
+        .Pos = NavGraph_FindNode(&AllNodes, NAV_ID_R5)->location
     };
     locations[4] = (SpawnLocation){
         .isOccupied = false,
         .pickupPtr = NULL,
-        .Pos = L5Node.location
+        .Pos = NavGraph_FindNode(&AllNodes, NAV_ID_L5)->location
     };
     locations[5] = (SpawnLocation){
         .isOccupied = false,
         .pickupPtr = NULL,
-        .Pos = L3Node.location
+        .Pos = NavGraph_FindNode(&AllNodes, NAV_ID_L3)->location
     };
 }
 
@@ -1092,7 +878,7 @@ void minigame_init()
     numAPresses = 0;
     pizza = 0;
 
-        BadNoGoodNodeCreation();
+        NavGraphInit();
 
 
     
@@ -1241,10 +1027,10 @@ void minigame_init()
         //temp.v[0] += 50.f * i;
         //players[i].PlayerActor.Position = temp;
     }
-    players[0].PlayerActor.Position = snowman1Node.location;
-    players[1].PlayerActor.Position = snowman2Node.location;
-    players[2].PlayerActor.Position = snowman3Node.location;
-    players[3].PlayerActor.Position = snowman4Node.location;
+    players[0].PlayerActor.Position = snowmanNodes[0]->location;
+    players[1].PlayerActor.Position = snowmanNodes[1]->location;
+    players[2].PlayerActor.Position = snowmanNodes[2]->location;
+    players[3].PlayerActor.Position = snowmanNodes[3]->location;
 
     for(int i = 0; i < 4; i++)
     {
@@ -1938,7 +1724,7 @@ void minigame_fixedloop(float deltatime)
             {
             if(t3d_vec3_distance2(&players[0].PlayerActor.Position, &zeros) > 100000.f)
             {
-                players[i].PlayerActor.Position = snowman1Node.location;
+                players[i].PlayerActor.Position = snowmanNodes[0]->location;
                 debugf("AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA\n");
             }
 
@@ -2445,7 +2231,7 @@ void minigame_cleanup()
     t3d_destroy(); 
     display_close();
 
-    NodeDA_Free(&AllNodes);
+    NavGraph_Free(navGraph, &AllNodes);
 }
 
 
@@ -85,24 +85,35 @@ ASSETS_LIST += \
 	filesystem/snowmen/swing.wav64 \
 	filesystem/snowmen/chainmail1.wav64 \
 	filesystem/snowmen/arrow.t3dm \
-	filesystem/snowmen/SnowyMapTest6_4_Collision.col
+	filesystem/snowmen/SnowyMapTest6_4_Collision.col \
+	filesystem/snowmen/SnowyMapTest6_4_Collision.nav
 
 filesystem/snowmen/%.col: assets/snowmen/%.col
 	@mkdir -p $(dir $@)
 	@echo "    [CUSTOM_COLLISION] $@"
 	cp "$<" $@
 
+filesystem/snowmen/%.nav: assets/snowmen/%.nav
+	@mkdir -p $(dir $@)
+	@echo "    [CUSTOM_NAVGRAPH] $@"
+	$(ASSET_CACHE) sh -c 'cp "$<" $@ && $(N64_BINDIR)/mkasset -c 2 -o $(dir $@) $@'
+
 # Reenable this after we find out how to build a tool as part of the pipeline
 # filesystem/snowmen/%.col: assets/snowmen/%.glb
 # 	@echo "    [CUSTOM_COLLISION] $@"
 # 	$(CUSTOM_GLTF_COLLISION) "$<" $@
 # 	$(N64_BINDIR)/mkasset -c 2 -o $(dir $@) $@
+#
+# The navigation graph is baked from the same mesh, the .navcfg file holds the settings and anchor nodes:
+# 	$(CUSTOM_GLTF_COLLISION) "$<" $@ --nav=assets/snowmen/$*.navcfg
+#
+# Converted meshes and nav graphs can be kept between runs, '--stats' prints the time per stage:
+# 	$(CUSTOM_GLTF_COLLISION) "$<" $@ --cache=$(ASSET_CACHE_DIR)/gltf_collision --stats
 
 filesystem/snowmen/%.t3dm: assets/snowmen/%.glb
 	@mkdir -p $(dir $@)
 	@echo "    [T3D-MODEL] $@"
-	$(T3D_GLTF_TO_3D) "$<" $@
-	$(N64_BINDIR)/mkasset -c 2 -o $(dir $@) $@
+	$(ASSET_CACHE) sh -c '$(T3D_GLTF_TO_3D) "$<" $@ && $(N64_BINDIR)/mkasset -c 2 -o $(dir $@) $@'
 
 filesystem/snowmen/m6x11plus.font64: MKFONT_FLAGS += --outline 1 --size 36
 
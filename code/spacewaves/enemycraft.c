@@ -40,6 +40,8 @@ void crafts_init(PlyNum currentstation){
             crafts[c].arm.rockets[b].enabled = false;
             crafts[c].arm.asteroids[b].enabled = false;
         }
+        projpool_init(&crafts[c].arm.asteroidpool, "asteroid");
+        projpool_init(&crafts[c].arm.rocketpool, "craft rocket");
         crafts[c].arm.asteroidnexttime = CURRENT_TIME + 0.5f;
         crafts[c].arm.powerup = 0;
         crafts[c].arm.shield = 0;
@@ -47,6 +49,18 @@ void crafts_init(PlyNum currentstation){
     }
 }
 
+void crafts_asteroid_disable(enemycraft_t* craft, int b){
+    if(!craft->arm.asteroids[b].enabled) return;
+    craft->arm.asteroids[b].enabled = false;
+    projpool_free(&craft->arm.asteroidpool, b);
+}
+
+void crafts_rocket_disable(enemycraft_t* craft, int b){
+    if(!craft->arm.rockets[b].enabled) return;
+    craft->arm.rockets[b].enabled = false;
+    projpool_free(&craft->arm.rocketpool, b);
+}
+
 void crafts_botlogic_getinput(enemycraft_t* craft, int index,joypad_inputs_t* outinput, joypad_buttons_t* outpressed, joypad_buttons_t* outheld){
     AiDiff diff = core_get_aidifficulty();
     int w,h, w2, h2;
@@ -185,8 +199,9 @@ void crafts_update(){
             if(crafts[c].arm.powerup < 10.0f) crafts[c].arm.powerup -= DELTA_TIME;
             crafts[c].arm.powerup = fclampr(crafts[c].arm.powerup, 0.0f, 10.0f);
 
-            if(held.z && CURRENT_TIME >= crafts[c].arm.asteroidnexttime && !gamestatus.paused){
-                int b = 0; while(crafts[c].arm.asteroids[b].enabled && b < MAX_PROJECTILES - 1) b++;
+            int b = -1;
+            if(held.z && CURRENT_TIME >= crafts[c].arm.asteroidnexttime && !gamestatus.paused
+            && (b = projpool_alloc(&crafts[c].arm.asteroidpool)) >= 0){
                 crafts[c].arm.asteroids[b].enabled = true;
                 crafts[c].arm.asteroids[b].polarpos = (T3DVec3){{crafts[c].pitchoff, crafts[c].yawoff, crafts[c].distanceoff}};
                 crafts[c].arm.asteroids[b].rotation = frandr(0, 360);
@@ -202,8 +217,8 @@ void crafts_update(){
                 effects_add_ambientlight(RGBA32(50,50,50,0));
             }
 
-            if((held.l || held.r) && CURRENT_TIME >= crafts[c].arm.rocketnexttime && crafts[c].arm.rocketcount > 0){
-                int b = 0; while(crafts[c].arm.rockets[b].enabled && b < MAX_PROJECTILES - 1) b++;
+            if((held.l || held.r) && CURRENT_TIME >= crafts[c].arm.rocketnexttime && crafts[c].arm.rocketcount > 0
+            && (b = projpool_alloc(&crafts[c].arm.rocketpool)) >= 0){
                 crafts[c].arm.rockets[b].enabled = true;
                 crafts[c].arm.rockets[b].polarpos = (T3DVec3){{crafts[c].pitchoff, crafts[c].yawoff, crafts[c].distanceoff}};
                 crafts[c].arm.rocketnexttime = CURRENT_TIME + 1.0f;
@@ -239,7 +254,7 @@ void crafts_update(){
                     crafts[c].arm.asteroids[b].polarpos.v[2] -= DELTA_TIME * 3.0f;
                     crafts[c].arm.asteroids[b].rotation += DELTA_TIME;
                     if(crafts[c].arm.asteroids[b].hp <= 0) {
-                        crafts[c].arm.asteroids[b].enabled = false;
+                        crafts_asteroid_disable(&crafts[c], b);
                         effects_add_exp3d(gfx_worldpos_from_polar(
                             crafts[c].arm.asteroids[b].polarpos.v[0],
                             crafts[c].arm.asteroids[b].polarpos.v[1],
@@ -250,7 +265,7 @@ void crafts_update(){
                         effects_add_ambientlight(RGBA32(50,50,25,0));
                     }
                     if(crafts[c].arm.asteroids[b].polarpos.v[2] < 2.0f){
-                        crafts[c].arm.asteroids[b].enabled = false;
+                        crafts_asteroid_disable(&crafts[c], b);
                         effects_add_exp3d(gfx_worldpos_from_polar(
                             crafts[c].arm.asteroids[b].polarpos.v[0],
                             crafts[c].arm.asteroids[b].polarpos.v[1],
@@ -269,7 +284,7 @@ void crafts_update(){
                 if(crafts[c].arm.rockets[b].enabled){
                     crafts[c].arm.rockets[b].polarpos.v[2] -= DELTA_TIME * 7.0f;
                     if(crafts[c].arm.rockets[b].hp <= 0) {
-                        crafts[c].arm.rockets[b].enabled = false;
+                        crafts_rocket_disable(&crafts[c], b);
                         effects_add_exp3d(gfx_worldpos_from_polar(
                             crafts[c].arm.rockets[b].polarpos.v[0],
                             crafts[c].arm.rockets[b].polarpos.v[1],
@@ -279,7 +294,7 @@ void crafts_update(){
                         effects_add_ambientlight(RGBA32(25,25,5,0));
                     }
                     if(crafts[c].arm.rockets[b].polarpos.v[2] < 2.0f){
-                        crafts[c].arm.rockets[b].enabled = false;
+                        crafts_rocket_disable(&crafts[c], b);
                         effects_add_exp3d(gfx_worldpos_from_polar(
                             crafts[c].arm.rockets[b].polarpos.v[0],
                             crafts[c].arm.rockets[b].polarpos.v[1],
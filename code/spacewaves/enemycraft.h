@@ -11,9 +11,9 @@
 #include "../../core.h"
 #include "../../minigame.h"
 #include "world.h"
+#include "projectiles.h"
 
 #define NUM_CRAFTS 3
-#define MAX_PROJECTILES 16
 
 typedef struct enemycraft_s{
     PlyNum currentplayer;
@@ -46,6 +46,8 @@ typedef struct enemycraft_s{
             T3DMat4FP* matx;
             float hp;
         } rockets[MAX_PROJECTILES];
+        projpool_t asteroidpool;
+        projpool_t rocketpool;
         float rocketnexttime;
         int rocketcount;
         rspq_block_t* rocketdl;
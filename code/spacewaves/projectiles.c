@@ -0,0 +1,146 @@
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include "projectiles.h"
+
+void projpool_init(projpool_t* pool, const char* name){
+    pool->name = name;
+    for(int i = 0; i < MAX_PROJECTILES; i++)
+        pool->next[i] = i + 1 < MAX_PROJECTILES? i + 1 : -1;
+    pool->freehead = 0;
+    pool->count = 0;
+    pool->peak = 0;
+    pool->overflows = 0;
+}
+
+int projpool_alloc(projpool_t* pool){
+    int index = pool->freehead;
+    if(index < 0){
+        // Full, the caller drops the shot instead of reusing a live slot
+        if(pool->overflows++ == 0)
+            debugf("spacewaves: %s pool is full (%i slots)\n", pool->name, MAX_PROJECTILES);
+        return -1;
+    }
+    pool->freehead = pool->next[index];
+    pool->next[index] = -1;
+    pool->count++;
+    if(pool->count > pool->peak) pool->peak = pool->count;
+    return index;
+}
+
+void projpool_free(projpool_t* pool, int index){
+    assertf(index >= 0 && index < MAX_PROJECTILES, "%s: bad projectile index %i", pool->name, index);
+    pool->next[index] = pool->freehead;
+    pool->freehead = index;
+    pool->count--;
+}
+
+static float polar_wrap(float x, float min, float max){
+    float range = max - min;
+    x -= range * floorf((x - min) / range);
+    return x < max? x : min;
+}
+
+// Brings pitch back into [-90, 90] degrees and yaw into [0, 360), pointing the same way
+static void polar_normalize(float pitch, float yaw, float* outlat, float* outlon){
+    pitch = polar_wrap(pitch, -FM_PI, FM_PI);
+    if(pitch > FM_PI / 2){
+        pitch = FM_PI - pitch;
+        yaw += FM_PI;
+    } else if(pitch < -FM_PI / 2){
+        pitch = -FM_PI - pitch;
+        yaw += FM_PI;
+    }
+    *outlat = pitch;
+    *outlon = polar_wrap(yaw, 0, FM_PI * 2);
+}
+
+static int polargrid_row(float lat){
+    int row = (int)floorf((lat + FM_PI / 2) * (POLARGRID_ROWS / FM_PI));
+    return row < 0? 0 : row >= POLARGRID_ROWS? POLARGRID_ROWS - 1 : row;
+}
+
+static int polargrid_col(float lon){
+    return (int)floorf(lon * (POLARGRID_COLS / (FM_PI * 2)));
+}
+
+void polargrid_clear(polargrid_t* grid){
+    grid->count = 0;
+}
+
+void polargrid_add(polargrid_t* grid, float pitch, float yaw, int16_t key){
+    assertf(grid->count < POLARGRID_MAX_ENTRIES, "polargrid: too many entries");
+    float lat, lon;
+    polar_normalize(pitch, yaw, &lat, &lon);
+    int col = polargrid_col(lon);
+    if(col >= POLARGRID_COLS) col = POLARGRID_COLS - 1;
+    grid->pending[grid->count].key = key;
+    grid->pending[grid->count].cell = polargrid_row(lat) * POLARGRID_COLS + col;
+    grid->count++;
+}
+
+void polargrid_build(polargrid_t* grid){
+    memset(grid->cellstart, 0, sizeof(grid->cellstart));
+    for(int i = 0; i < grid->count; i++)
+        grid->cellstart[grid->pending[i].cell + 1]++;
+    for(int c = 0; c < POLARGRID_ROWS * POLARGRID_COLS; c++)
+        grid->cellstart[c + 1] += grid->cellstart[c];
+
+    int16_t fill[POLARGRID_ROWS * POLARGRID_COLS];
+    memcpy(fill, grid->cellstart, sizeof(fill));
+    for(int i = 0; i < grid->count; i++)
+        grid->items[fill[grid->pending[i].cell]++] = grid->pending[i].key;
+}
+
+// Writes every key that may lie within radius of polarpos (pitch, yaw, distance), sorted ascending.
+// Rejection uses the haversine bounds: for two points at distances r1, r2 that are closer than R,
+// |r1 - r2| < R and r1*r2 * chord^2 < R^2, where the chord is bounded below by the pitch
+// difference and by the yaw difference scaled with cos(pitch).
+int polargrid_query(const polargrid_t* grid, const T3DVec3* polarpos, float radius, int16_t* outkeys, int maxkeys){
+    // A little slack for the fm_sinf/fm_cosf error in gfx_worldpos_from_polar
+    radius = radius * 1.05f + 0.05f;
+
+    float lat, lon;
+    polar_normalize(polarpos->v[0], polarpos->v[1], &lat, &lon);
+
+    int row0 = 0, row1 = POLARGRID_ROWS - 1;
+    int col0 = 0, cols = POLARGRID_COLS;
+    float rlow = polarpos->v[2] - radius;
+    float sinlat = rlow > 0.0f? radius / (2.0f * rlow) : 1.0f;
+    if(sinlat < 1.0f){
+        float dlat = 2.0f * asinf(sinlat);
+        row0 = polargrid_row(lat - dlat);
+        row1 = polargrid_row(lat + dlat);
+
+        float maxlat = fabsf(lat) + dlat;
+        float cosprod = maxlat < FM_PI / 2? cosf(lat) * cosf(maxlat) : 0.0f;
+        if(cosprod > 0.0001f){
+            float sinlon = radius / (2.0f * rlow * sqrtf(cosprod));
+            if(sinlon < 1.0f){
+                float dlon = 2.0f * asinf(sinlon);
+                col0 = polargrid_col(lon - dlon);
+                int colend = polargrid_col(lon + dlon);
+                if(colend - col0 + 1 < POLARGRID_COLS) cols = colend - col0 + 1;
+                else col0 = 0;
+            }
+        }
+    }
+
+    int count = 0;
+    for(int r = row0; r <= row1; r++)
+        for(int i = 0; i < cols; i++){
+            int c = (col0 + i + POLARGRID_COLS) % POLARGRID_COLS;
+            int cell = r * POLARGRID_COLS + c;
+            for(int it = grid->cellstart[cell]; it < grid->cellstart[cell + 1]; it++){
+                assertf(count < maxkeys, "polargrid: query result overflow");
+                int16_t key = grid->items[it];
+                int k = count++;
+                while(k > 0 && outkeys[k - 1] > key){
+                    outkeys[k] = outkeys[k - 1];
+                    k--;
+                }
+                outkeys[k] = key;
+            }
+        }
+    return count;
+}
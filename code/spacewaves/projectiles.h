@@ -0,0 +1,45 @@
+#ifndef PROJECTILES_H
+#define PROJECTILES_H
+
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+
+#define MAX_PROJECTILES 64
+
+// Enough room for the crafts, all of their asteroids and rockets, and the bonuses
+#define POLARGRID_MAX_ENTRIES (8 * MAX_PROJECTILES)
+#define POLARGRID_ROWS 8
+#define POLARGRID_COLS 16
+
+// Free list over the slots of one projectile array, the array keeps its own enabled flags
+typedef struct projpool_s{
+    const char* name;
+    int16_t next[MAX_PROJECTILES];
+    int16_t freehead;
+    int count;
+    int peak;
+    int overflows;
+} projpool_t;
+
+// Targets binned by direction (pitch, yaw), so hit tests only convert nearby pairs to world space
+typedef struct polargrid_s{
+    int count;
+    int16_t cellstart[POLARGRID_ROWS * POLARGRID_COLS + 1];
+    int16_t items[POLARGRID_MAX_ENTRIES];
+    struct{
+        int16_t key;
+        int16_t cell;
+    } pending[POLARGRID_MAX_ENTRIES];
+} polargrid_t;
+
+void projpool_init(projpool_t* pool, const char* name);
+int  projpool_alloc(projpool_t* pool);
+void projpool_free(projpool_t* pool, int index);
+
+void polargrid_clear(polargrid_t* grid);
+void polargrid_add(polargrid_t* grid, float pitch, float yaw, int16_t key);
+void polargrid_build(polargrid_t* grid);
+int  polargrid_query(const polargrid_t* grid, const T3DVec3* polarpos, float radius, int16_t* outkeys, int maxkeys);
+
+#endif
@@ -14,6 +14,24 @@
 #include "bonus.h"
 
 DefenseStation station;
+polargrid_t station_targets;
+
+// Keys for station_targets, in the order the hit checks ran before the broadphase
+#define TARGET_KEY_CRAFT(c)         (c)
+#define TARGET_KEY_ASTEROID(c, p)   (NUM_CRAFTS + ((c) * MAX_PROJECTILES + (p)) * 2)
+#define TARGET_KEY_ENROCKET(c, p)   (TARGET_KEY_ASTEROID(c, p) + 1)
+
+void station_bullet_disable(int b){
+    if(!station.arm.bullets[b].enabled) return;
+    station.arm.bullets[b].enabled = false;
+    projpool_free(&station.arm.bulletpool, b);
+}
+
+void station_rocket_disable(int b){
+    if(!station.arm.rockets[b].enabled) return;
+    station.arm.rockets[b].enabled = false;
+    projpool_free(&station.arm.rocketpool, b);
+}
 
 void station_init(PlyNum player){
     station.currentplayer = player;
@@ -23,8 +41,13 @@ void station_init(PlyNum player){
     station.arm.rocketgunmatx = malloc_uncached(sizeof(T3DMat4FP));
     station.arm.machinegunmatx = malloc_uncached(sizeof(T3DMat4FP));
     station.arm.rocketcount = 0;
-    for(int p = 0; p < MAX_PROJECTILES; p++) 
+    for(int p = 0; p < MAX_PROJECTILES; p++){
         station.arm.rockets[p].matx = malloc_uncached(sizeof(T3DMat4FP));
+        station.arm.rockets[p].enabled = false;
+        station.arm.bullets[p].enabled = false;
+    }
+    projpool_init(&station.arm.bulletpool, "station bullet");
+    projpool_init(&station.arm.rocketpool, "station rocket");
     station.maxhp = 500;
     station.hp =  station.maxhp;
     station.arm.powerup = 0;
@@ -45,13 +68,141 @@ void station_close(){
     for(int p = 0; p < MAX_PROJECTILES; p++) {
         if(station.arm.rockets[p].matx) free_uncached(station.arm.rockets[p].matx);
         station.arm.rockets[p].matx = NULL;
-        station.arm.rockets[p].enabled = false;
-        station.arm.bullets[p].enabled = false;
+        station_rocket_disable(p);
+        station_bullet_disable(p);
     }
     if(station.arm.rocketdl) rspq_block_free(station.arm.rocketdl);
     station.arm.rocketdl = NULL;
 }
 
+void station_targets_build(){
+    polargrid_clear(&station_targets);
+    for(int c = 0; c < NUM_CRAFTS; c++)
+        if(crafts[c].enabled)
+            polargrid_add(&station_targets, crafts[c].pitchoff, crafts[c].yawoff, TARGET_KEY_CRAFT(c));
+    for(int c = 0; c < NUM_CRAFTS; c++)
+        for(int p = 0; p < MAX_PROJECTILES; p++){
+            if(crafts[c].arm.asteroids[p].enabled)
+                polargrid_add(&station_targets, crafts[c].arm.asteroids[p].polarpos.v[0], crafts[c].arm.asteroids[p].polarpos.v[1], TARGET_KEY_ASTEROID(c, p));
+            if(crafts[c].arm.rockets[p].enabled)
+                polargrid_add(&station_targets, crafts[c].arm.rockets[p].polarpos.v[0], crafts[c].arm.rockets[p].polarpos.v[1], TARGET_KEY_ENROCKET(c, p));
+        }
+    polargrid_build(&station_targets);
+}
+
+void station_bullet_collide(int b){
+    int16_t keys[POLARGRID_MAX_ENTRIES];
+    int count = polargrid_query(&station_targets, &station.arm.bullets[b].polarpos, 5.0f, keys, POLARGRID_MAX_ENTRIES);
+    if(!count) return;
+
+    T3DVec3 bullet_worldpos = gfx_worldpos_from_polar(
+        station.arm.bullets[b].polarpos.v[0], 
+        station.arm.bullets[b].polarpos.v[1], 
+        station.arm.bullets[b].polarpos.v[2]);
+
+    for(int k = 0; k < count && station.arm.bullets[b].enabled; k++){
+        if(keys[k] < NUM_CRAFTS){
+            int c = keys[k];
+            T3DVec3 crft_worldpos = gfx_worldpos_from_polar(
+                crafts[c].pitchoff,
+                crafts[c].yawoff,
+                crafts[c].distanceoff);
+            if(t3d_vec3_distance(&crft_worldpos, &bullet_worldpos) < 5.0f){
+                if(!(crafts[c].arm.shield > 0.0f && crafts[c].arm.shield < 10.0f)){
+                    crafts[c].hp -= 10;
+                    gamestatus.playerscores[station.currentplayer] += 10 * 50;
+                }
+                station_bullet_disable(b);
+                wav64_play(&sounds[snd_hit], SFX_CHANNEL_HIT);
+                effects_add_exp2d(gfx_worldpos_from_polar(
+                        station.arm.bullets[b].polarpos.v[0],
+                        station.arm.bullets[b].polarpos.v[1],
+                        station.arm.bullets[b].polarpos.v[2] * 25), 
+                        RGBA32(150,150,255,255));
+            }
+            continue;
+        }
+        int c = (keys[k] - NUM_CRAFTS) / 2 / MAX_PROJECTILES;
+        int p = (keys[k] - NUM_CRAFTS) / 2 % MAX_PROJECTILES;
+        if(keys[k] == TARGET_KEY_ASTEROID(c, p)){
+            T3DVec3 ast_worldpos = gfx_worldpos_from_polar(
+                crafts[c].arm.asteroids[p].polarpos.v[0],
+                crafts[c].arm.asteroids[p].polarpos.v[1],
+                crafts[c].arm.asteroids[p].polarpos.v[2]);
+            if(t3d_vec3_distance(&ast_worldpos, &bullet_worldpos) < 4.0f){
+                crafts[c].arm.asteroids[p].hp -= 10;
+                gamestatus.playerscores[station.currentplayer] += 10 * 20;
+                station_bullet_disable(b);
+                wav64_play(&sounds[snd_hit], SFX_CHANNEL_EFFECTS);
+                effects_add_exp2d(gfx_worldpos_from_polar(
+                        station.arm.bullets[b].polarpos.v[0],
+                        station.arm.bullets[b].polarpos.v[1],
+                        station.arm.bullets[b].polarpos.v[2] * 25), 
+                        RGBA32(150,150,255,255));
+            }
+        } else {
+            T3DVec3 enrocket_worldpos = gfx_worldpos_from_polar(
+                crafts[c].arm.rockets[p].polarpos.v[0],
+                crafts[c].arm.rockets[p].polarpos.v[1],
+                crafts[c].arm.rockets[p].polarpos.v[2]);
+            if(t3d_vec3_distance(&enrocket_worldpos, &bullet_worldpos) < 5.0f){
+                crafts[c].arm.rockets[p].hp -= 10;
+                gamestatus.playerscores[station.currentplayer] += 10 * 50;
+                station_bullet_disable(b);
+                wav64_play(&sounds[snd_hit], SFX_CHANNEL_EFFECTS);
+                effects_add_rumble(crafts[c].currentplayerport, 0.25f);
+            }
+        }
+    }
+}
+
+void station_rocket_collide(int b){
+    int16_t keys[POLARGRID_MAX_ENTRIES];
+    int count = polargrid_query(&station_targets, &station.arm.rockets[b].polarpos, 8.0f, keys, POLARGRID_MAX_ENTRIES);
+    if(!count) return;
+
+    T3DVec3 rocket_worldpos = gfx_worldpos_from_polar(
+        station.arm.rockets[b].polarpos.v[0], 
+        station.arm.rockets[b].polarpos.v[1], 
+        station.arm.rockets[b].polarpos.v[2]);
+
+    for(int k = 0; k < count && station.arm.rockets[b].enabled; k++){
+        if(keys[k] < NUM_CRAFTS){
+            int c = keys[k];
+            T3DVec3 crft_worldpos = gfx_worldpos_from_polar(
+                crafts[c].pitchoff,
+                crafts[c].yawoff,
+                crafts[c].distanceoff);
+            if(t3d_vec3_distance(&crft_worldpos, &rocket_worldpos) < 8.0f){
+                if(!(crafts[c].arm.shield > 0.0f && crafts[c].arm.shield < 10.0f)){
+                    crafts[c].hp -= 100;
+                    gamestatus.playerscores[station.currentplayer] += 8000;
+                }
+                station_rocket_disable(b);
+                wav64_play(&sounds[snd_hit], SFX_CHANNEL_HIT);
+                effects_add_ambientlight(RGBA32(50,50,25,0));
+            }
+            continue;
+        }
+        // Enemy rockets can only be shot down with bullets
+        int c = (keys[k] - NUM_CRAFTS) / 2 / MAX_PROJECTILES;
+        int p = (keys[k] - NUM_CRAFTS) / 2 % MAX_PROJECTILES;
+        if(keys[k] != TARGET_KEY_ASTEROID(c, p)) continue;
+        T3DVec3 ast_worldpos = gfx_worldpos_from_polar(
+            crafts[c].arm.asteroids[p].polarpos.v[0],
+            crafts[c].arm.asteroids[p].polarpos.v[1],
+            crafts[c].arm.asteroids[p].polarpos.v[2]);
+        if(t3d_vec3_distance(&ast_worldpos, &rocket_worldpos) < 6.0f){
+            crafts[c].arm.asteroids[p].hp -= 100;
+            gamestatus.playerscores[station.currentplayer] += 1000;
+            station_rocket_disable(b);
+            wav64_play(&sounds[snd_hit], SFX_CHANNEL_EFFECTS);
+            effects_add_rumble(crafts[c].currentplayerport, 1.25f);
+            effects_add_shake(1.25f);
+        }
+    }
+}
+
 void station_update(){
     joypad_buttons_t pressed = joypad_get_buttons_pressed(station.currentplayerport);
     joypad_inputs_t input = joypad_get_inputs(station.currentplayerport);
@@ -76,8 +227,9 @@ void station_update(){
 
     joypad_buttons_t held = joypad_get_buttons_held(station.currentplayerport);
 
-    if(held.z && CURRENT_TIME >= station.arm.bulletnexttime && !gamestatus.paused){
-        int b = 0; while(station.arm.bullets[b].enabled && b < MAX_PROJECTILES - 1) b++;
+    int b = -1;
+    if(held.z && CURRENT_TIME >= station.arm.bulletnexttime && !gamestatus.paused
+    && (b = projpool_alloc(&station.arm.bulletpool)) >= 0){
         station.arm.bullets[b].enabled = true;
         station.arm.bullets[b].polarpos = (T3DVec3){{station.pitch, station.yaw, 0.25f}};
         station.arm.bulletnexttime = CURRENT_TIME + 0.35f;
@@ -89,8 +241,8 @@ void station_update(){
         effects_add_ambientlight(RGBA32(0,25,50,0));
     }
 
-    if((held.l || held.r) && CURRENT_TIME >= station.arm.rocketnexttime && station.arm.rocketcount > 0){
-        int b = 0; while(station.arm.rockets[b].enabled && b < MAX_PROJECTILES - 1) b++;
+    if((held.l || held.r) && CURRENT_TIME >= station.arm.rocketnexttime && station.arm.rocketcount > 0
+    && (b = projpool_alloc(&station.arm.rocketpool)) >= 0){
         station.arm.rockets[b].enabled = true;
         station.arm.rockets[b].polarpos = (T3DVec3){{station.pitchoff, station.yawoff, 0.25f}};
         station.arm.rocketnexttime = CURRENT_TIME + 2.5f;
@@ -128,130 +280,52 @@ void station_update(){
     
     station.arm.powerup = fclampr(station.arm.powerup, 0.0f, 10.0f);
 
-    T3DVec3 bullet_worldpos = (T3DVec3){{0,0,0}};
-    T3DVec3 rocket_worldpos = (T3DVec3){{0,0,0}};
+    // Targets don't move or get disabled while the station shoots, so one build covers every projectile
+    station_targets_build();
     for(int b = 0; b < MAX_PROJECTILES; b++){
         if(station.arm.bullets[b].enabled){
             station.arm.bullets[b].polarpos.v[2] += DELTA_TIME * 140.0f;
             if(station.arm.bullets[b].polarpos.v[2] > 200.0f)
-                station.arm.bullets[b].enabled = false;
-
-            bullet_worldpos = gfx_worldpos_from_polar(
-                station.arm.bullets[b].polarpos.v[0], 
-                station.arm.bullets[b].polarpos.v[1], 
-                station.arm.bullets[b].polarpos.v[2]);
+                station_bullet_disable(b);
+            else station_bullet_collide(b);
         }
         if(station.arm.rockets[b].enabled){
             station.arm.rockets[b].polarpos.v[2] += DELTA_TIME * 40.0f;
             if(station.arm.rockets[b].polarpos.v[2] > 200.0f)
-                station.arm.rockets[b].enabled = false;
-
-            rocket_worldpos = gfx_worldpos_from_polar(
-                station.arm.rockets[b].polarpos.v[0], 
-                station.arm.rockets[b].polarpos.v[1], 
-                station.arm.rockets[b].polarpos.v[2]);
-        }
-
-        for(int c = 0; c < 3; c++){
-            T3DVec3 crft_worldpos;
-            if(crafts[c].enabled){
-                crft_worldpos = gfx_worldpos_from_polar(
-                    crafts[c].pitchoff,
-                    crafts[c].yawoff,
-                    crafts[c].distanceoff);
-                if(station.arm.bullets[b].enabled && t3d_vec3_distance(&crft_worldpos, &bullet_worldpos) < 5.0f){
-                    if(!(crafts[c].arm.shield > 0.0f && crafts[c].arm.shield < 10.0f)){
-                        crafts[c].hp -= 10;
-                        gamestatus.playerscores[station.currentplayer] += 10 * 50;
-                    }
-                    station.arm.bullets[b].enabled = false;
-                    wav64_play(&sounds[snd_hit], SFX_CHANNEL_HIT);
-                    effects_add_exp2d(gfx_worldpos_from_polar(
-                            station.arm.bullets[b].polarpos.v[0],
-                            station.arm.bullets[b].polarpos.v[1],
-                            station.arm.bullets[b].polarpos.v[2] * 25), 
-                            RGBA32(150,150,255,255));
-                }
-                if(station.arm.rockets[b].enabled && t3d_vec3_distance(&crft_worldpos, &rocket_worldpos) < 8.0f){
-                    if(!(crafts[c].arm.shield > 0.0f && crafts[c].arm.shield < 10.0f)){
-                        crafts[c].hp -= 100;
-                        gamestatus.playerscores[station.currentplayer] += 8000;
-                    }
-                    station.arm.rockets[b].enabled = false;
-                    wav64_play(&sounds[snd_hit], SFX_CHANNEL_HIT);
-                    effects_add_ambientlight(RGBA32(50,50,25,0));
-                }
-            }
-        }
-        for(int c = 0; c < 3; c++)
-        for(int p = 0; p < MAX_PROJECTILES; p++){
-            T3DVec3 ast_worldpos, enrocket_worldpos;
-            if(crafts[c].arm.asteroids[p].enabled){
-                ast_worldpos = gfx_worldpos_from_polar(
-                    crafts[c].arm.asteroids[p].polarpos.v[0],
-                    crafts[c].arm.asteroids[p].polarpos.v[1],
-                    crafts[c].arm.asteroids[p].polarpos.v[2]);
-                if(station.arm.bullets[b].enabled && t3d_vec3_distance(&ast_worldpos, &bullet_worldpos) < 4.0f){
-                    crafts[c].arm.asteroids[p].hp -= 10;
-                    gamestatus.playerscores[station.currentplayer] += 10 * 20;
-                    station.arm.bullets[b].enabled = false;
-                    wav64_play(&sounds[snd_hit], SFX_CHANNEL_EFFECTS);
-                    effects_add_exp2d(gfx_worldpos_from_polar(
-                            station.arm.bullets[b].polarpos.v[0],
-                            station.arm.bullets[b].polarpos.v[1],
-                            station.arm.bullets[b].polarpos.v[2] * 25), 
-                            RGBA32(150,150,255,255));
-                }
-                if(station.arm.rockets[b].enabled && t3d_vec3_distance(&ast_worldpos, &rocket_worldpos) < 6.0f){
-                    crafts[c].arm.asteroids[p].hp -= 100;
-                    gamestatus.playerscores[station.currentplayer] += 1000;
-                    station.arm.rockets[b].enabled = false;
-                    wav64_play(&sounds[snd_hit], SFX_CHANNEL_EFFECTS);
-                    effects_add_rumble(crafts[c].currentplayerport, 1.25f);
-                    effects_add_shake(1.25f);
-                }
-            }
-            if(crafts[c].arm.rockets[p].enabled){
-                enrocket_worldpos = gfx_worldpos_from_polar(
-                    crafts[c].arm.rockets[p].polarpos.v[0],
-                    crafts[c].arm.rockets[p].polarpos.v[1],
-                    crafts[c].arm.rockets[p].polarpos.v[2]);
-                if(station.arm.bullets[b].enabled && t3d_vec3_distance(&enrocket_worldpos, &bullet_worldpos) < 5.0f){
-                    crafts[c].arm.rockets[p].hp -= 10;
-                    gamestatus.playerscores[station.currentplayer] += 10 * 50;
-                    station.arm.bullets[b].enabled = false;
-                    wav64_play(&sounds[snd_hit], SFX_CHANNEL_EFFECTS);
-                    effects_add_rumble(crafts[c].currentplayerport, 0.25f);
-                }
-            }
+                station_rocket_disable(b);
+            else station_rocket_collide(b);
         }
     }
-    for(int bonus = 0; bonus < MAX_BONUSES; bonus++)
-        for(int p = 0; p < MAX_PROJECTILES; p++){
-            bullet_worldpos = gfx_worldpos_from_polar(
-                station.arm.bullets[p].polarpos.v[0], 
-                station.arm.bullets[p].polarpos.v[1], 
-                station.arm.bullets[p].polarpos.v[2]);
-            rocket_worldpos = gfx_worldpos_from_polar(
-                station.arm.rockets[p].polarpos.v[0], 
-                station.arm.rockets[p].polarpos.v[1], 
-                station.arm.rockets[p].polarpos.v[2]);
-            T3DVec3 ast_worldpos;
-            if(bonuses[bonus].enabled){
-                ast_worldpos = gfx_worldpos_from_polar(
-                    bonuses[bonus].polarpos.v[0],
-                    bonuses[bonus].polarpos.v[1],
-                    bonuses[bonus].polarpos.v[2]);
-                if(station.arm.bullets[p].enabled && t3d_vec3_distance(&ast_worldpos, &bullet_worldpos) < 8.0f){
+    for(int bonus = 0; bonus < MAX_BONUSES; bonus++){
+        if(!bonuses[bonus].enabled) continue;
+        T3DVec3 ast_worldpos = gfx_worldpos_from_polar(
+            bonuses[bonus].polarpos.v[0],
+            bonuses[bonus].polarpos.v[1],
+            bonuses[bonus].polarpos.v[2]);
+        for(int p = 0; p < MAX_PROJECTILES && bonuses[bonus].enabled; p++){
+            // The distance along the ray alone rules out most pairs before going to world space
+            if(station.arm.bullets[p].enabled && fabsf(station.arm.bullets[p].polarpos.v[2] - bonuses[bonus].polarpos.v[2]) < 8.0f){
+                T3DVec3 bullet_worldpos = gfx_worldpos_from_polar(
+                    station.arm.bullets[p].polarpos.v[0], 
+                    station.arm.bullets[p].polarpos.v[1], 
+                    station.arm.bullets[p].polarpos.v[2]);
+                if(t3d_vec3_distance(&ast_worldpos, &bullet_worldpos) < 8.0f){
                     bonus_apply(bonus, station.currentplayer, &station, -1);
-                    station.arm.bullets[p].enabled = false;
+                    station_bullet_disable(p);
                 }
-                if(station.arm.rockets[p].enabled && t3d_vec3_distance(&ast_worldpos, &rocket_worldpos) < 10.0f){
+            }
+            if(station.arm.rockets[p].enabled && fabsf(station.arm.rockets[p].polarpos.v[2] - bonuses[bonus].polarpos.v[2]) < 10.0f){
+                T3DVec3 rocket_worldpos = gfx_worldpos_from_polar(
+                    station.arm.rockets[p].polarpos.v[0], 
+                    station.arm.rockets[p].polarpos.v[1], 
+                    station.arm.rockets[p].polarpos.v[2]);
+                if(t3d_vec3_distance(&ast_worldpos, &rocket_worldpos) < 10.0f){
                     bonus_apply(bonus, station.currentplayer, &station, -1);
-                    station.arm.rockets[p].enabled = false; 
+                    station_rocket_disable(p);
                 }
             }
         }
+    }
 }
 
 void station_apply_camera(){
@@ -9,8 +9,7 @@
 #include <t3d/t3dmath.h>
 #include <t3d/t3dmodel.h>
 #include "types.h"
-
-#define MAX_PROJECTILES 16
+#include "projectiles.h"
 
 typedef struct defensestation_t{
     PlyNum currentplayer;
@@ -35,6 +34,8 @@ typedef struct defensestation_t{
             T3DVec3 polarpos;
             T3DMat4FP* matx;
         } rockets[MAX_PROJECTILES];
+        projpool_t bulletpool;
+        projpool_t rocketpool;
         float rocketnexttime;
         int rocketcount;
         rspq_block_t* rocketdl;
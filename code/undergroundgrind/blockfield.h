@@ -0,0 +1,132 @@
+#include <libdragon.h>
+#include "../../core.h"
+
+#define BLOCKFIELD_MAX_BLOCKS  64
+#define BLOCKFIELD_CELL_SIZE   41.0f
+#define BLOCKFIELD_GRID_DIM    8
+#define BLOCKFIELD_GRID_ORIGIN (-BLOCKFIELD_CELL_SIZE * BLOCKFIELD_GRID_DIM * 0.5f)
+
+typedef struct
+{
+  int block;
+  PlyNum destroyingPlayer;
+} BlockEvent;
+
+/**
+ * Keeps track of which dirt blocks are still alive.
+ * Live blocks are bucketed into a coarse XZ grid so attacks only test nearby blocks,
+ * destroyed blocks are reported through an event queue instead of being polled.
+ */
+typedef struct
+{
+  DirtBlock *blocks;
+  int blockCount;
+  int chestBlock;
+
+  // dense list of live blocks, used for drawing
+  int live[BLOCKFIELD_MAX_BLOCKS];
+  int liveIndex[BLOCKFIELD_MAX_BLOCKS];
+  int liveCount;
+
+  // per-cell singly linked lists of live blocks
+  int cellHead[BLOCKFIELD_GRID_DIM * BLOCKFIELD_GRID_DIM];
+  int cellNext[BLOCKFIELD_MAX_BLOCKS];
+  int blockCell[BLOCKFIELD_MAX_BLOCKS];
+
+  // destroyed blocks, each block can only be destroyed once so this never overflows
+  BlockEvent events[BLOCKFIELD_MAX_BLOCKS];
+  int eventHead;
+  int eventTail;
+} BlockField;
+
+int blockFieldCellCoord(float pos)
+{
+  int c = (int)floorf((pos - BLOCKFIELD_GRID_ORIGIN) / BLOCKFIELD_CELL_SIZE);
+  if (c < 0) return 0;
+  if (c >= BLOCKFIELD_GRID_DIM) return BLOCKFIELD_GRID_DIM - 1;
+  return c;
+}
+
+void initBlockField(BlockField *field, DirtBlock *blocks, int blockCount, int chestBlock)
+{
+  assertf(blockCount <= BLOCKFIELD_MAX_BLOCKS, "Too many dirt blocks: %d", blockCount);
+
+  field->blocks = blocks;
+  field->blockCount = blockCount;
+  field->chestBlock = chestBlock;
+  field->liveCount = 0;
+  field->eventHead = 0;
+  field->eventTail = 0;
+
+  for (int i = 0; i < BLOCKFIELD_GRID_DIM * BLOCKFIELD_GRID_DIM; i++)
+  {
+    field->cellHead[i] = -1;
+  }
+
+  for (int i = 0; i < blockCount; i++)
+  {
+    T3DVec3 *pos = &blocks[i].dirtBlockPos;
+    int cell = blockFieldCellCoord(pos->v[2]) * BLOCKFIELD_GRID_DIM + blockFieldCellCoord(pos->v[0]);
+    field->blockCell[i] = cell;
+    field->cellNext[i] = field->cellHead[cell];
+    field->cellHead[cell] = i;
+
+    field->liveIndex[i] = field->liveCount;
+    field->live[field->liveCount++] = i;
+  }
+}
+
+void blockFieldDestroy(BlockField *field, int block, PlyNum player)
+{
+  DirtBlock *dirtBlock = &field->blocks[block];
+  if (dirtBlock->isDestroyed) return;
+
+  dirtBlock->destroyingPlayer = player;
+  dirtBlock->isDestroyed = true;
+
+  // unlink from its grid cell
+  int *link = &field->cellHead[field->blockCell[block]];
+  while (*link != block) link = &field->cellNext[*link];
+  *link = field->cellNext[block];
+
+  // swap-remove from the live list
+  int idx = field->liveIndex[block];
+  int last = field->live[--field->liveCount];
+  field->live[idx] = last;
+  field->liveIndex[last] = idx;
+
+  field->events[field->eventTail++] = (BlockEvent){ .block = block, .destroyingPlayer = player };
+}
+
+bool blockFieldPollEvent(BlockField *field, BlockEvent *event)
+{
+  if (field->eventHead == field->eventTail) return false;
+  *event = field->events[field->eventHead++];
+  return true;
+}
+
+/**
+ * Collects all live blocks in the grid cells overlapping the given circle (XZ plane).
+ * The caller still has to do the exact distance check.
+ */
+int blockFieldQuery(BlockField *field, float x, float z, float radius, int *outBlocks, int maxBlocks)
+{
+  int minX = blockFieldCellCoord(x - radius);
+  int maxX = blockFieldCellCoord(x + radius);
+  int minZ = blockFieldCellCoord(z - radius);
+  int maxZ = blockFieldCellCoord(z + radius);
+
+  int count = 0;
+  for (int cz = minZ; cz <= maxZ; cz++)
+  {
+    for (int cx = minX; cx <= maxX; cx++)
+    {
+      for (int i = field->cellHead[cz * BLOCKFIELD_GRID_DIM + cx]; i >= 0; i = field->cellNext[i])
+      {
+        if (count == maxBlocks) return count;
+        outBlocks[count++] = i;
+      }
+    }
+  }
+  return count;
+}
@@ -10,6 +10,7 @@
 #include "./snakeplayer.h"
 #include "./dirtblock.h"
 #include "./chest.h"
+#include "./blockfield.h"
 
 const MinigameDef minigame_def = {
   .gamename = "Underground Grind",
@@ -66,6 +67,7 @@ int chestBlockNumber;
 SnakePlayer players[MAXPLAYERS];
 
 DirtBlock dirtBlocks[TOTAL_BLOCKS];
+BlockField blockField;
 
 Chest chests[1];
 
@@ -184,6 +186,7 @@ void minigame_init(void)
   initChest(&chests[0], chestModel, 0.4f, RGBA32(255, 0, 0, 255), blockPositions[chestBlockNumber], chestBlockNumber);
 
   dirtBlocks[chestBlockNumber].isContainingChest = true;
+  initBlockField(&blockField, dirtBlocks, TOTAL_BLOCKS, chestBlockNumber);
   
   countDownTimer = COUNTDOWN_DELAY;
 
@@ -205,10 +208,13 @@ void player_do_damage(SnakePlayer *player)
     player->playerPos.v[2] + c * ATTACK_OFFSET,
   };
 
-  for (size_t i = 0; i < TOTAL_BLOCKS; i++)
+  int nearBlocks[BLOCKFIELD_MAX_BLOCKS];
+  int nearCount = blockFieldQuery(&blockField, attackPosition[0], attackPosition[1],
+    ATTACK_RADIUS + HITBOX_RADIUS, nearBlocks, BLOCKFIELD_MAX_BLOCKS);
+
+  for (int i = 0; i < nearCount; i++)
   {
-    DirtBlock *block = &dirtBlocks[i];
-    if (block->isDestroyed) continue;
+    DirtBlock *block = &dirtBlocks[nearBlocks[i]];
 
     float positionDifference[] = {
       block->dirtBlockPos.v[0] - attackPosition[0],
@@ -222,9 +228,8 @@ void player_do_damage(SnakePlayer *player)
     }
 
     if (block->damage > 100) {
-      block->destroyingPlayer = player->plynum;
-	  block->isDestroyed = true;
-	} 
+      blockFieldDestroy(&blockField, nearBlocks[i], player->plynum);
+    }
   }
 }
 
@@ -387,13 +392,14 @@ void player_draw(SnakePlayer *player)
   rspq_block_run(player->dplSnake);
 }
 
-void dirtBlockDraw(DirtBlock *dirtBlock)
+void dirtBlocksDraw(BlockField *field)
 {
-  if (!dirtBlock->isDestroyed) {
-  	rspq_block_run(dirtBlock->dplDirtBlock);
+  for (int i = 0; i < field->liveCount; i++)
+  {
+    rspq_block_run(field->blocks[field->live[i]].dplDirtBlock);
   }
 
-  if (dirtBlock->isDestroyed && dirtBlock->isContainingChest) {
+  if (field->blocks[field->chestBlock].isDestroyed) {
     rspq_block_run(chests[0].dplChestBlock);
   }
 }
@@ -438,13 +444,14 @@ void minigame_fixedloop(float deltaTime)
     wav64_play(&sfx_start, 31);
 
   if (!isEnding) {
-    // Determine if a player has won
+    // Determine if a player has won, only blocks destroyed since the last tick need checking
     PlyNum lastPlayer = -1;
-    for (size_t i = 0; i < TOTAL_BLOCKS; i++)
+    BlockEvent event;
+    while (blockFieldPollEvent(&blockField, &event))
     {
-      if (dirtBlocks[i].isDestroyed && dirtBlocks[i].isContainingChest)
+      if (event.block == blockField.chestBlock)
       {
-        lastPlayer = dirtBlocks[i].destroyingPlayer;
+        lastPlayer = event.destroyingPlayer;
       }
     }
     
@@ -497,10 +504,7 @@ void minigame_loop(float deltaTime)
     player_draw(&players[i]);
   }
 
-  for (size_t i = 0; i < TOTAL_BLOCKS; i++)
-  {
-    dirtBlockDraw(&dirtBlocks[i]);
-  }
+  dirtBlocksDraw(&blockField);
 
   syncPoint = rspq_syncpoint_new();
 
@@ -2,6 +2,7 @@
 #define GAMEJAM2024_CONFIG_H
 
     #include "core.h"
+    #include "replay.h"
 
     /* ==================================================================================================================
         Don't use these macros as getter functions, use stuff like core_get_aidifficulty() and core_get_playercount() 
@@ -25,6 +26,15 @@
     // The current minigame you want to test
     #define MINIGAME_TO_TEST  "examplegame"
 
+    // Record the next minigame to REPLAY_FILE, or play it back from there (see replay.h for the modes).
+    // Playback reuses the recorded frame times, so the same match can be benchmarked across builds
+    // and the frame time traces written to REPLAY_TRACE_FILE can be diffed.
+    #define REPLAY_MODE  REPLAY_OFF
+
+    // Where the recording and the frame time trace are stored
+    #define REPLAY_FILE        "sd:/gamejam2024.rpl"
+    #define REPLAY_TRACE_FILE  "sd:/gamejam2024_trace.csv"
+
     // Initialize USB and isViewer logging
     #if defined(DEBUG) && DEBUG == 1
         #define DEBUG_LOG 1
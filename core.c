@@ -78,6 +78,22 @@ void core_set_playercount(uint32_t playercount)
     global_core_playercount = playercount;
 }
 
+/*==============================
+    core_set_playerports
+    Sets the number of human players and their controller
+    ports directly, without checking what is connected.
+    Used when playing back a replay.
+    @param  The number of players
+    @param  The controller port of each player
+==============================*/
+
+void core_set_playerports(uint32_t playercount, const joypad_port_t* ports)
+{
+    for (int i=0; i<playercount; i++)
+        global_core_players[i].port = ports[i];
+    global_core_playercount = playercount;
+}
+
 /*==============================
     core_set_aidifficulty
     Sets the AI difficulty
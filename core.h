@@ -88,6 +88,7 @@ extern "C" {
     #define MAXPLAYERS  4
 
     void core_set_playercount(uint32_t playercount);
+    void core_set_playerports(uint32_t playercount, const joypad_port_t* ports);
     void core_set_aidifficulty(AiDiff difficulty);
     void core_set_subtick(double subtick);
     void core_reset_winners();
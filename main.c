@@ -12,6 +12,7 @@ and provides a basic game loop.
 #include "menu.h"
 #include "config.h"
 #include "minigame.h"
+#include "replay.h"
 
 
 /*==============================
@@ -47,10 +48,13 @@ int main()
 
     // Initialize the random number generator, then call rand() every
     // frame so to get random behavior also in emulators.
+    // Replays seed it themselves and need it to stay deterministic.
     uint32_t seed;
     getentropy(&seed, sizeof(seed));
     srand(seed);
-    register_VI_handler((void(*)(void))rand);
+    replay_init();
+    if (REPLAY_MODE == REPLAY_OFF)
+        register_VI_handler((void(*)(void))rand);
 
     // Program Loop
     while (1)
@@ -59,20 +63,24 @@ int main()
         float accumulator = 0;
         const float dt = DELTATIME;
 
-        // Show the menu
-        game = menu();
+        // Show the menu, unless the minigame comes from a replay
+        if (replay_is_playback())
+            game = (char*)replay_get_game();
+        else
+            game = menu();
         
         // Set the initial minigame
         minigame_play(game);
 
         // Initialize the minigame
+        replay_start(game);
         core_reset_winners();
         minigame_get_game()->funcPointer_init();
         
         // Handle the engine loop
         while (!minigame_get_ended())
         {
-            float frametime = display_get_delta_time();
+            float frametime = replay_frametime(display_get_delta_time());
             
             // In order to prevent problems if the game slows down significantly, we will clamp the maximum timestep the simulation can take
             if (frametime > 0.25f)
@@ -89,7 +97,7 @@ int main()
             }
 
             // Read controler data
-            joypad_poll();
+            replay_poll();
             mixer_try_play();
             
             // Perform the unfixed loop
@@ -103,6 +111,7 @@ int main()
             mixer_ch_stop(i);
         minigame_get_game()->funcPointer_cleanup();
         minigame_cleanup();
+        replay_finish();
 
         mixer_close();
         mixer_init(32);
@@ -0,0 +1,535 @@
+/***************************************************************
+                             replay.c
+
+Records the inputs of a minigame and plays them back exactly, so
+the same match can be benchmarked across builds. The stream holds
+the RNG seed, the player setup, the frame time of every frame and
+the controller state of every poll.
+
+Minigames call libdragon's joypad functions directly, so their
+DSOs are linked with --wrap (see the Makefile) and land in the
+__wrap_ functions at the bottom of this file.
+***************************************************************/
+
+#include <libdragon.h>
+#include "core.h"
+#include "config.h"
+#include "replay.h"
+
+
+/*********************************
+             Macros
+*********************************/
+
+#define REPLAY_VERSION  1
+#define REPLAY_GAMENAME 64
+
+// Stream record tags
+#define TAG_FRAME      0x01 // float frame time
+#define TAG_POLL       0x02 // uint8 changed port mask, then a joypad_inputs_t per changed port
+#define TAG_DIRECTION  0x03 // int8 result of joypad_get_direction
+#define TAG_AXIS       0x04 // int8 result of joypad_get_axis_pressed
+#define TAG_END        0xFF
+
+
+/*********************************
+            Structures
+*********************************/
+
+typedef struct {
+    char     magic[4];
+    uint32_t version;
+    uint32_t seed;
+    uint32_t playercount;
+    uint32_t aidifficulty;
+    uint8_t  ports[MAXPLAYERS];
+    uint8_t  connected;
+    char     game[REPLAY_GAMENAME];
+} ReplayHeader;
+
+typedef struct {
+    uint8_t* data;
+    size_t   size;
+    size_t   capacity;
+    size_t   cursor;
+} ReplayStream;
+
+
+/*********************************
+             Globals
+*********************************/
+
+static int          global_replay_mode = REPLAY_MODE;
+static bool         global_replay_active = false;
+static ReplayHeader global_replay_header;
+static ReplayStream global_replay_stream;
+
+// Controller state as the minigame sees it
+static joypad_inputs_t global_replay_inputs[JOYPAD_PORT_COUNT];
+static joypad_inputs_t global_replay_previous[JOYPAD_PORT_COUNT];
+static float           global_replay_frametime = 0;
+
+// Microseconds spent on every frame, for comparing builds
+static uint32_t* global_replay_trace;
+static size_t    global_replay_tracecount;
+static size_t    global_replay_tracecapacity;
+static uint64_t  global_replay_lastframe;
+
+
+/*==============================
+    replay_write
+    Appends bytes to the recording
+==============================*/
+
+static void replay_write(const void* data, size_t size)
+{
+    ReplayStream* stream = &global_replay_stream;
+    if (stream->size + size > stream->capacity)
+    {
+        stream->capacity = stream->capacity ? stream->capacity*2 : 16*1024;
+        while (stream->size + size > stream->capacity)
+            stream->capacity *= 2;
+        stream->data = realloc(stream->data, stream->capacity);
+        assertf(stream->data, "Out of memory while recording a replay");
+    }
+    memcpy(stream->data + stream->size, data, size);
+    stream->size += size;
+}
+
+
+/*==============================
+    replay_read
+    Reads the next record of the given type. If the
+    minigame asks for something else than what was
+    recorded, it went out of sync and playback stops.
+    @return Whether the record was read
+==============================*/
+
+static bool replay_read(uint8_t tag, void* data, size_t size)
+{
+    ReplayStream* stream = &global_replay_stream;
+    if (!global_replay_active)
+        return false;
+    if (stream->cursor + 1 + size > stream->size || stream->data[stream->cursor] != tag)
+    {
+        debugf("Replay: out of sync at byte %d (wanted tag %d), stopping playback\n", (int)stream->cursor, tag);
+        memset(global_replay_inputs, 0, sizeof(global_replay_inputs));
+        global_replay_active = false;
+        return false;
+    }
+    memcpy(data, stream->data + stream->cursor + 1, size);
+    stream->cursor += 1 + size;
+    return true;
+}
+
+
+/*==============================
+    replay_is_playing
+    @return Whether inputs currently come from the recording
+==============================*/
+
+static bool replay_is_playing()
+{
+    return global_replay_active && global_replay_mode >= REPLAY_PLAYBACK;
+}
+
+
+/*==============================
+    replay_is_recording
+    @return Whether inputs currently go to the recording
+==============================*/
+
+static bool replay_is_recording()
+{
+    return global_replay_active && global_replay_mode == REPLAY_RECORD;
+}
+
+
+/*==============================
+    replay_capture
+    Stores the controller state of every port that
+    changed since the last poll
+    @param  The state of every port
+==============================*/
+
+static void replay_capture(const joypad_inputs_t* inputs)
+{
+    uint8_t tag = TAG_POLL;
+    uint8_t changed = 0;
+
+    for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+    {
+        if (memcmp(&inputs[i], &global_replay_inputs[i], sizeof(joypad_inputs_t)) != 0)
+            changed |= 1 << i;
+    }
+
+    replay_write(&tag, 1);
+    replay_write(&changed, 1);
+    for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+    {
+        if (changed & (1 << i))
+            replay_write(&inputs[i], sizeof(joypad_inputs_t));
+        global_replay_previous[i] = global_replay_inputs[i];
+        global_replay_inputs[i] = inputs[i];
+    }
+}
+
+
+/*==============================
+    replay_restore
+    Feeds back the next recorded controller state
+==============================*/
+
+static void replay_restore()
+{
+    uint8_t changed;
+
+    for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+        global_replay_previous[i] = global_replay_inputs[i];
+    if (!replay_read(TAG_POLL, &changed, 1))
+        return;
+    for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+    {
+        if (changed & (1 << i))
+        {
+            ReplayStream* stream = &global_replay_stream;
+            assertf(stream->cursor + sizeof(joypad_inputs_t) <= stream->size, "Replay: truncated recording");
+            memcpy(&global_replay_inputs[i], stream->data + stream->cursor, sizeof(joypad_inputs_t));
+            stream->cursor += sizeof(joypad_inputs_t);
+        }
+    }
+}
+
+
+/*==============================
+    replay_init
+    Mounts the SD card and loads the recording
+    when playing back. Call once at boot.
+==============================*/
+
+void replay_init()
+{
+    FILE* file;
+    long size;
+
+    if (global_replay_mode == REPLAY_OFF)
+        return;
+    debug_init_sdfs("sd:/", -1);
+    if (global_replay_mode == REPLAY_RECORD)
+        return;
+
+    // Load the whole recording, the header first
+    file = fopen(REPLAY_FILE, "rb");
+    assertf(file, "Unable to open replay file %s\n", REPLAY_FILE);
+    fseek(file, 0, SEEK_END);
+    size = ftell(file) - (long)sizeof(ReplayHeader);
+    fseek(file, 0, SEEK_SET);
+    assertf(size >= 0, "Replay file %s is too short\n", REPLAY_FILE);
+    fread(&global_replay_header, sizeof(ReplayHeader), 1, file);
+    assertf(memcmp(global_replay_header.magic, "RPLY", 4) == 0 && global_replay_header.version == REPLAY_VERSION, "Replay file %s has the wrong format\n", REPLAY_FILE);
+    global_replay_stream.data = malloc(size);
+    global_replay_stream.size = fread(global_replay_stream.data, 1, size, file);
+    global_replay_stream.capacity = size;
+    global_replay_stream.cursor = 0;
+    fclose(file);
+}
+
+
+/*==============================
+    replay_is_playback
+    Checks whether the next minigame comes from a recording
+    @return Whether a recording is loaded and not yet played
+==============================*/
+
+bool replay_is_playback()
+{
+    return global_replay_mode >= REPLAY_PLAYBACK;
+}
+
+
+/*==============================
+    replay_get_game
+    Gets the minigame stored in the recording
+    @return The internal name of the minigame
+==============================*/
+
+const char* replay_get_game()
+{
+    return global_replay_header.game;
+}
+
+
+/*==============================
+    replay_start
+    Seeds the RNG and either stores or restores the
+    player setup. Call right before the minigame's init.
+    @param  The internal name of the minigame
+==============================*/
+
+void replay_start(const char* game)
+{
+    ReplayHeader* header = &global_replay_header;
+
+    if (global_replay_mode == REPLAY_OFF)
+        return;
+
+    if (global_replay_mode == REPLAY_RECORD)
+    {
+        memset(header, 0, sizeof(ReplayHeader));
+        memcpy(header->magic, "RPLY", 4);
+        header->version = REPLAY_VERSION;
+        getentropy(&header->seed, sizeof(header->seed));
+        header->playercount = core_get_playercount();
+        header->aidifficulty = core_get_aidifficulty();
+        for (int i=0; i<MAXPLAYERS; i++)
+            header->ports[i] = core_get_playercontroller(i);
+        for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+            if (joypad_is_connected(i))
+                header->connected |= 1 << i;
+        strncpy(header->game, game, REPLAY_GAMENAME-1);
+
+        global_replay_stream.size = 0;
+        memset(global_replay_inputs, 0, sizeof(global_replay_inputs));
+        global_replay_active = true;
+
+        // The first ticks run on whatever the menu polled last. Store the poll
+        // before it as well, so pressed and released come out the same.
+        joypad_inputs_t previous[JOYPAD_PORT_COUNT], current[JOYPAD_PORT_COUNT];
+        for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+        {
+            current[i] = joypad_get_inputs(i);
+            previous[i] = current[i];
+            previous[i].btn.raw = (current[i].btn.raw & ~joypad_get_buttons_pressed(i).raw) | joypad_get_buttons_released(i).raw;
+        }
+        replay_capture(previous);
+        replay_capture(current);
+    }
+    else
+    {
+        joypad_port_t ports[MAXPLAYERS];
+        for (int i=0; i<MAXPLAYERS; i++)
+            ports[i] = header->ports[i];
+        core_set_playerports(header->playercount, ports);
+        core_set_aidifficulty(header->aidifficulty);
+
+        global_replay_stream.cursor = 0;
+        memset(global_replay_inputs, 0, sizeof(global_replay_inputs));
+        global_replay_active = true;
+        replay_restore();
+        replay_restore();
+    }
+
+    srand(header->seed);
+    global_replay_tracecount = 0;
+    global_replay_lastframe = get_ticks_us();
+}
+
+
+/*==============================
+    replay_frametime
+    Stores or restores the frame time of this frame
+    @param  The measured frame time
+    @return The frame time the minigame should use
+==============================*/
+
+float replay_frametime(float frametime)
+{
+    uint64_t now;
+
+    if (!global_replay_active)
+        return frametime;
+
+    // Keep track of how long the previous frame actually took
+    now = get_ticks_us();
+    if (global_replay_tracecount == global_replay_tracecapacity)
+    {
+        global_replay_tracecapacity = global_replay_tracecapacity ? global_replay_tracecapacity*2 : 4096;
+        global_replay_trace = realloc(global_replay_trace, global_replay_tracecapacity*sizeof(uint32_t));
+    }
+    global_replay_trace[global_replay_tracecount++] = now - global_replay_lastframe;
+    global_replay_lastframe = now;
+
+    if (replay_is_recording())
+    {
+        uint8_t tag = TAG_FRAME;
+        replay_write(&tag, 1);
+        replay_write(&frametime, sizeof(float));
+    }
+    else if (!replay_read(TAG_FRAME, &frametime, sizeof(float)))
+        return global_replay_frametime;
+    global_replay_frametime = frametime;
+    return frametime;
+}
+
+
+/*==============================
+    replay_poll
+    Reads the controllers, or feeds back the next
+    recorded controller state
+==============================*/
+
+void replay_poll()
+{
+    if (replay_is_playing())
+    {
+        replay_restore();
+        return;
+    }
+    joypad_poll();
+    if (replay_is_recording())
+    {
+        joypad_inputs_t inputs[JOYPAD_PORT_COUNT];
+        for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+            inputs[i] = joypad_get_inputs(i);
+        replay_capture(inputs);
+    }
+}
+
+
+/*==============================
+    replay_finish
+    Writes the recording and the frame time trace.
+    Call after the minigame has ended.
+==============================*/
+
+void replay_finish()
+{
+    FILE* file;
+
+    if (global_replay_mode == REPLAY_OFF)
+        return;
+
+    if (global_replay_mode == REPLAY_RECORD)
+    {
+        uint8_t tag = TAG_END;
+        replay_write(&tag, 1);
+        file = fopen(REPLAY_FILE, "wb");
+        if (file)
+        {
+            fwrite(&global_replay_header, sizeof(ReplayHeader), 1, file);
+            fwrite(global_replay_stream.data, 1, global_replay_stream.size, file);
+            fclose(file);
+        }
+        else
+            debugf("Replay: unable to write %s\n", REPLAY_FILE);
+    }
+
+    file = fopen(REPLAY_TRACE_FILE, "w");
+    if (file)
+    {
+        fprintf(file, "frame,us\n");
+        for (size_t i=0; i<global_replay_tracecount; i++)
+            fprintf(file, "%d,%ld\n", (int)i, (long)global_replay_trace[i]);
+        fclose(file);
+    }
+    else
+        debugf("Replay: unable to write %s\n", REPLAY_TRACE_FILE);
+
+    // Only the first match after boot is recorded or played back
+    free(global_replay_stream.data);
+    free(global_replay_trace);
+    memset(&global_replay_stream, 0, sizeof(global_replay_stream));
+    global_replay_trace = NULL;
+    global_replay_tracecount = global_replay_tracecapacity = 0;
+    global_replay_active = false;
+    global_replay_mode = REPLAY_OFF;
+}
+
+
+/***************************************************************
+                  Wrapped libdragon functions
+      Minigame DSOs call these instead of the libdragon ones
+***************************************************************/
+
+void __wrap_joypad_poll(void)
+{
+    replay_poll();
+}
+
+bool __wrap_joypad_is_connected(joypad_port_t port)
+{
+    if (replay_is_playing())
+        return (global_replay_header.connected >> port) & 1;
+    return joypad_is_connected(port);
+}
+
+joypad_inputs_t __wrap_joypad_get_inputs(joypad_port_t port)
+{
+    if (replay_is_playing())
+        return global_replay_inputs[port];
+    return joypad_get_inputs(port);
+}
+
+joypad_buttons_t __wrap_joypad_get_buttons(joypad_port_t port)
+{
+    if (replay_is_playing())
+        return global_replay_inputs[port].btn;
+    return joypad_get_buttons(port);
+}
+
+joypad_buttons_t __wrap_joypad_get_buttons_held(joypad_port_t port)
+{
+    if (replay_is_playing())
+        return global_replay_inputs[port].btn;
+    return joypad_get_buttons_held(port);
+}
+
+joypad_buttons_t __wrap_joypad_get_buttons_pressed(joypad_port_t port)
+{
+    if (replay_is_playing())
+        return (joypad_buttons_t){.raw = global_replay_inputs[port].btn.raw & ~global_replay_previous[port].btn.raw};
+    return joypad_get_buttons_pressed(port);
+}
+
+joypad_buttons_t __wrap_joypad_get_buttons_released(joypad_port_t port)
+{
+    if (replay_is_playing())
+        return (joypad_buttons_t){.raw = ~global_replay_inputs[port].btn.raw & global_replay_previous[port].btn.raw};
+    return joypad_get_buttons_released(port);
+}
+
+// The stick thresholds live inside libdragon, so these two store their results instead of recomputing them
+
+joypad_8way_t __wrap_joypad_get_direction(joypad_port_t port, joypad_2d_t axes)
+{
+    int8_t result;
+    if (replay_is_playing())
+        return replay_read(TAG_DIRECTION, &result, 1) ? result : JOYPAD_8WAY_NONE;
+    result = joypad_get_direction(port, axes);
+    if (replay_is_recording())
+    {
+        uint8_t tag = TAG_DIRECTION;
+        replay_write(&tag, 1);
+        replay_write(&result, 1);
+    }
+    return result;
+}
+
+int __wrap_joypad_get_axis_pressed(joypad_port_t port, joypad_axis_t axis)
+{
+    int8_t result;
+    if (replay_is_playing())
+        return replay_read(TAG_AXIS, &result, 1) ? result : 0;
+    result = joypad_get_axis_pressed(port, axis);
+    if (replay_is_recording())
+    {
+        uint8_t tag = TAG_AXIS;
+        replay_write(&tag, 1);
+        replay_write(&result, 1);
+    }
+    return result;
+}
+
+float __wrap_display_get_delta_time(void)
+{
+    if (global_replay_active)
+        return global_replay_frametime;
+    return display_get_delta_time();
+}
+
+void __wrap_display_set_fps_limit(float fps)
+{
+    if (replay_is_playing() && global_replay_mode == REPLAY_FASTFORWARD)
+        fps = 0;
+    display_set_fps_limit(fps);
+}
@@ -0,0 +1,69 @@
+#ifndef GAMEJAM2024_REPLAY_H
+#define GAMEJAM2024_REPLAY_H
+
+    /***************************************************************
+                            Replay Modes
+    ***************************************************************/
+
+    #define REPLAY_OFF          0 // Normal play
+    #define REPLAY_RECORD       1 // Record the next minigame to REPLAY_FILE
+    #define REPLAY_PLAYBACK     2 // Play REPLAY_FILE back with the recorded frame times
+    #define REPLAY_FASTFORWARD  3 // Same as playback, but ignore the minigame's frame rate limit
+
+
+    /***************************************************************
+                          Replay Functions
+    ***************************************************************/
+
+    /*==============================
+        replay_init
+        Mounts the SD card and loads the recording
+        when playing back. Call once at boot.
+    ==============================*/
+    void replay_init();
+
+    /*==============================
+        replay_is_playback
+        Checks whether the next minigame comes from a recording
+        @return Whether a recording is loaded and not yet played
+    ==============================*/
+    bool replay_is_playback();
+
+    /*==============================
+        replay_get_game
+        Gets the minigame stored in the recording
+        @return The internal name of the minigame
+    ==============================*/
+    const char* replay_get_game();
+
+    /*==============================
+        replay_start
+        Seeds the RNG and either stores or restores the
+        player setup. Call right before the minigame's init.
+        @param  The internal name of the minigame
+    ==============================*/
+    void replay_start(const char* game);
+
+    /*==============================
+        replay_frametime
+        Stores or restores the frame time of this frame
+        @param  The measured frame time
+        @return The frame time the minigame should use
+    ==============================*/
+    float replay_frametime(float frametime);
+
+    /*==============================
+        replay_poll
+        Reads the controllers, or feeds back the next
+        recorded controller state
+    ==============================*/
+    void replay_poll();
+
+    /*==============================
+        replay_finish
+        Writes the recording and the frame time trace.
+        Call after the minigame has ended.
+    ==============================*/
+    void replay_finish();
+
+#endif
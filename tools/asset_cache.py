@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+# Content-addressed cache for asset conversions, called from the Makefile rules.
+#
+#   asset_cache.py run --cache DIR --log FILE --input IN [--input IN...] --output OUT
+#                      [--side-output GLOB...] -- command args...
+#   asset_cache.py report FILE
+#
+# The key covers the contents of every input, the full command line (so tool flags count)
+# and the size/mtime of every tool binary named in it. On a hit the stored files are copied
+# into place, on a miss the command runs and its files are stored.
+# Tools that write more than the output (e.g. gltf_to_t3d writing '<model>.<n>.sdata' streams)
+# have to name those files with --side-output, they are stored and restored together with it.
+# Each run appends one line to the log, 'report' turns it into a per-asset timing table.
+
+import argparse
+import glob
+import hashlib
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+CACHE_VERSION = b"asset-cache-2"
+
+
+def hash_file(hasher, path):
+    with open(path, "rb") as f:
+        for block in iter(lambda: f.read(1 << 20), b""):
+            hasher.update(block)
+
+
+def tool_tokens(command):
+    # Commands wrapped in 'sh -c' carry their tools inside one argument
+    for arg in command:
+        if " " in arg:
+            try:
+                yield from shlex.split(arg)
+            except ValueError:
+                pass
+        else:
+            yield arg
+
+
+def cache_key(inputs, side_outputs, command):
+    hasher = hashlib.sha256(CACHE_VERSION)
+    for pattern in side_outputs:
+        hasher.update(b"side\0" + pattern.encode() + b"\0")
+    for arg in command:
+        hasher.update(arg.encode() + b"\0")
+
+    for token in tool_tokens(command):
+        if os.path.isabs(token) and os.path.isfile(token) and os.access(token, os.X_OK):
+            st = os.stat(token)
+            hasher.update(("%s:%d:%d\0" % (token, st.st_size, st.st_mtime_ns)).encode())
+
+    for path in inputs:
+        hasher.update(b"input\0")
+        hash_file(hasher, path)
+    return hasher.hexdigest()
+
+
+def log_result(log, status, seconds, output, side_files):
+    if not log:
+        return
+    os.makedirs(os.path.dirname(log) or ".", exist_ok=True)
+    # One short write per line, so parallel jobs can share the file
+    with open(log, "a") as f:
+        f.write("%s\t%.3f\t%s\t%d\n" % (status, seconds, output, len(side_files)))
+
+
+def find_side_outputs(patterns):
+    return sorted(set(path for pattern in patterns for path in glob.glob(pattern)))
+
+
+def remove_side_outputs(patterns):
+    # Leftovers of an older conversion would otherwise be stored with (or survive next to) the new one
+    for path in find_side_outputs(patterns):
+        os.remove(path)
+
+
+def store(entry_dir, output, side_files):
+    # An entry is a directory with the output and its side files, renamed into place once complete
+    os.makedirs(os.path.dirname(entry_dir), exist_ok=True)
+    tmp = tempfile.mkdtemp(dir=os.path.dirname(entry_dir))
+    shutil.copyfile(output, os.path.join(tmp, os.path.basename(output)))
+    for path in side_files:
+        shutil.copyfile(path, os.path.join(tmp, os.path.basename(path)))
+    try:
+        os.rename(tmp, entry_dir)
+    except OSError:
+        # Another job stored the same key first
+        shutil.rmtree(tmp)
+
+
+def restore(entry_dir, output):
+    out_dir = os.path.dirname(output) or "."
+    os.makedirs(out_dir, exist_ok=True)
+    side_files = []
+    for name in sorted(os.listdir(entry_dir)):
+        dest = output if name == os.path.basename(output) else os.path.join(out_dir, name)
+        shutil.copyfile(os.path.join(entry_dir, name), dest)
+        if dest != output:
+            side_files.append(dest)
+    return side_files
+
+
+def run(args):
+    start = time.monotonic()
+    command = args.command
+    if command and command[0] == "--":
+        command = command[1:]
+    if not command:
+        sys.exit("asset_cache: no command given")
+
+    key = cache_key(args.input, args.side_output, command)
+    entry_dir = os.path.join(args.cache, key[:2], key)
+
+    remove_side_outputs(args.side_output)
+    if os.path.isfile(os.path.join(entry_dir, os.path.basename(args.output))):
+        side_files = restore(entry_dir, args.output)
+        log_result(args.log, "hit", time.monotonic() - start, args.output, side_files)
+        return 0
+
+    result = subprocess.run(command)
+    if result.returncode != 0:
+        return result.returncode
+    if not os.path.isfile(args.output):
+        sys.exit("asset_cache: '%s' did not produce %s" % (" ".join(command), args.output))
+
+    side_files = [path for path in find_side_outputs(args.side_output) if path != args.output]
+    store(entry_dir, args.output, side_files)
+    log_result(args.log, "miss", time.monotonic() - start, args.output, side_files)
+    return 0
+
+
+def report(args):
+    if not os.path.isfile(args.log):
+        print("No assets were converted")
+        return 0
+
+    # Last entry per asset wins, a log can span several runs
+    entries = {}
+    with open(args.log) as f:
+        for line in f:
+            parts = line.rstrip("\n").split("\t")
+            if len(parts) == 4:
+                entries[parts[2]] = (parts[0], float(parts[1]), int(parts[3]))
+
+    rows = sorted(entries.items(), key=lambda e: e[1][1], reverse=True)
+    hits = sum(1 for _, (status, _, _) in rows if status == "hit")
+    total = sum(seconds for _, (_, seconds, _) in rows)
+    converted = sum(seconds for _, (status, seconds, _) in rows if status == "miss")
+    side_total = sum(side for _, (_, _, side) in rows)
+
+    print("    %-6s %9s %5s  %s" % ("cache", "seconds", "side", "asset"))
+    for output, (status, seconds, side) in rows[:args.top] if args.top > 0 else rows:
+        print("    %-6s %9.3f %5s  %s" % (status, seconds, side if side else "-", output))
+    print("    %d assets (+%d side files), %d from cache, %.2fs total (%.2fs converting)" % (
+        len(rows), side_total, hits, total, converted))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    sub = parser.add_subparsers(dest="mode", required=True)
+
+    run_parser = sub.add_parser("run")
+    run_parser.add_argument("--cache", required=True)
+    run_parser.add_argument("--log")
+    run_parser.add_argument("--input", action="append", default=[], required=True)
+    run_parser.add_argument("--output", required=True)
+    run_parser.add_argument("--side-output", action="append", default=[])
+    run_parser.add_argument("command", nargs=argparse.REMAINDER)
+
+    report_parser = sub.add_parser("report")
+    report_parser.add_argument("log")
+    report_parser.add_argument("--top", type=int, default=0)
+
+    args = parser.parse_args()
+    return run(args) if args.mode == "run" else report(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())